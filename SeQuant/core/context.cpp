@@ -1,10 +1,9 @@
 #include <SeQuant/core/attr.hpp>
 #include <SeQuant/core/context.hpp>
 #include <SeQuant/core/utility/context.hpp>
+#include <SeQuant/core/utility/string.hpp>
 
-#ifdef SEQUANT_CONTEXT_MANIPULATION_THREADSAFE
-#include <mutex>
-#endif
+#include <sstream>
 
 namespace sequant {
 
@@ -38,41 +37,27 @@ bool operator!=(const Context& ctx1, const Context& ctx2) {
   return !(ctx1 == ctx2);
 }
 
-#ifdef SEQUANT_CONTEXT_MANIPULATION_THREADSAFE
-static std::recursive_mutex ctx_mtx;  // used to protect the context
-#endif
-
 const Context& get_default_context(Statistics s) {
-#ifdef SEQUANT_CONTEXT_MANIPULATION_THREADSAFE
-  std::scoped_lock lock(ctx_mtx);
-#endif
-  auto& contexts =
+  // N.B. lock-free unless the contexts changed since the last call on this
+  // thread
+  const auto& contexts =
       detail::get_implicit_context<container::map<Statistics, Context>>();
   auto it = contexts.find(s);
+  if (it != contexts.end()) return it->second;
   /// default for arbitrary statistics is initialized lazily here
-  if (it == contexts.end() && s == Statistics::Arbitrary) {
-    set_default_context(Context{}, Statistics::Arbitrary);
+  if (s == Statistics::Arbitrary) {
+    detail::implicit_context_cell<container::map<Statistics, Context>>()
+        .update([](auto& ctxs) { ctxs.try_emplace(Statistics::Arbitrary); });
   }
-  it = contexts.find(s);
-  // have context for this statistics? else return for arbitrary statistics
-  if (it != contexts.end())
-    return it->second;
-  else
-    return get_default_context(Statistics::Arbitrary);
+  // have no context for this statistics? return for arbitrary statistics
+  return get_default_context(Statistics::Arbitrary);
 }
 
 void set_default_context(Context ctx, Statistics s) {
-#ifdef SEQUANT_CONTEXT_MANIPULATION_THREADSAFE
-  std::scoped_lock lock(ctx_mtx);
-#endif
-  auto& contexts =
-      detail::implicit_context_instance<container::map<Statistics, Context>>();
-  auto it = contexts.find(s);
-  if (it != contexts.end()) {
-    it->second = std::move(ctx);
-  } else {
-    contexts.emplace(s, std::move(ctx));
-  }
+  detail::implicit_context_cell<container::map<Statistics, Context>>().update(
+      [&ctx, s](auto& contexts) {
+        contexts.insert_or_assign(s, std::move(ctx));
+      });
 }
 
 void set_default_context(Context::Options ctx_opts, Statistics s) {
@@ -80,24 +65,19 @@ void set_default_context(Context::Options ctx_opts, Statistics s) {
 }
 
 void set_default_context(const container::map<Statistics, Context>& ctxs) {
-  for (const auto& [s, ctx] : ctxs) {
-    set_default_context(ctx, s);
-  }
+  detail::implicit_context_cell<container::map<Statistics, Context>>().update(
+      [&ctxs](auto& contexts) {
+        for (const auto& [s, ctx] : ctxs) contexts.insert_or_assign(s, ctx);
+      });
 }
 
 void reset_default_context() {
-#ifdef SEQUANT_CONTEXT_MANIPULATION_THREADSAFE
-  std::scoped_lock lock(ctx_mtx);
-#endif
   detail::reset_implicit_context<container::map<Statistics, Context>>();
 }
 
 [[nodiscard]] detail::ImplicitContextResetter<
     container::map<Statistics, Context>>
 set_scoped_default_context(const container::map<Statistics, Context>& ctx) {
-#ifdef SEQUANT_CONTEXT_MANIPULATION_THREADSAFE
-  std::scoped_lock lock(ctx_mtx);
-#endif
   return detail::set_scoped_implicit_context(ctx);
 }
 
@@ -176,6 +156,40 @@ BraKetSlotTypesetting Context::braket_slot_typesetting() const {
   return braket_slot_typesetting_;
 }
 
+std::string Context::fingerprint() const {
+  std::ostringstream oss;
+  oss << "vacuum=" << static_cast<int>(vacuum_)
+      << ";metric=" << static_cast<int>(metric_)
+      << ";strict_braket=" << assert_strict_braket_symmetry_
+      << ";spbasis=" << static_cast<int>(spbasis_)
+      << ";first_dummy=" << first_dummy_index_ordinal_;
+  if (canonicalization_options_) {
+    const auto& opts = *canonicalization_options_;
+    oss << ";canon=" << static_cast<int>(opts.method) << ':'
+        << static_cast<int>(opts.ignore_named_index_labels) << ':'
+        << opts.enumeration_max_tensors;
+    if (opts.named_indices) {
+      oss << ":named=";
+      for (const auto& idx : *opts.named_indices)
+        oss << toUtf8(idx.full_label()) << ',';
+    }
+  }
+  if (const auto isr = index_space_registry()) {
+    oss << ";spaces=";
+    for (const auto& space : *isr->spaces())
+      oss << toUtf8(space.base_key()) << ':' << space.type().to_int32() << ':'
+          << space.qns().to_int32() << ':' << space.approximate_size() << ':'
+          << static_cast<int>(space.field()) << ',';
+    oss << ";vacocc=" << isr->vacuum_occupied_space(true).to_int32()
+        << ";refocc=" << isr->reference_occupied_space(true).to_int32()
+        << ";complete=" << isr->complete_space(true).to_int32()
+        << ";hole=" << isr->hole_space(true).to_int32()
+        << ";particle=" << isr->particle_space(true).to_int32()
+        << ";mask=" << isr->physical_particle_attribute_mask();
+  }
+  return oss.str();
+}
+
 Context& Context::set(Vacuum vacuum) {
   vacuum_ = vacuum;
   return *this;
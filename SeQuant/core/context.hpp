@@ -6,6 +6,8 @@
 #include <SeQuant/core/options.hpp>
 #include <SeQuant/core/utility/context.hpp>
 
+#include <string>
+
 namespace sequant {
 
 // clang-format
@@ -155,6 +157,13 @@ class Context {
   /// \return BraKetSlotTypesetting of this context; see BraKetSlotTypesetting
   /// for the meaning of the possible values
   BraKetSlotTypesetting braket_slot_typesetting() const;
+  /// \return textual fingerprint of the parts of this context that affect
+  /// the results of derivations, i.e. everything except the LaTeX typesetting
+  /// settings: vacuum, metric, strict bra-ket symmetry flag, SPBasis, first
+  /// dummy index ordinal, canonicalization options, and the contents of the
+  /// index space registry; contexts with equal fingerprints produce identical
+  /// derivation results
+  std::string fingerprint() const;
 
   /// Sets the Vacuum for this context, convenient for chaining
   /// \param vacuum Vacuum
@@ -235,6 +244,9 @@ bool default_context_manipulation_threadsafe();
 /// @brief access default Context for the given Statistics
 /// @param s Statistics
 /// @return the default context used for Statistics @p s
+/// @note this is lock-free in the steady state; the returned reference
+/// remains valid until a change of the default contexts is observed by a
+/// later call to this function on the same thread
 const Context& get_default_context(Statistics s = Statistics::Arbitrary);
 
 /// @brief sets default Context for the given Statistics
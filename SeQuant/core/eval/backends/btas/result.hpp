@@ -3,6 +3,7 @@
 
 #ifdef SEQUANT_HAS_BTAS
 
+#include <SeQuant/core/eval/permuted_sum.hpp>
 #include <SeQuant/core/eval/result.hpp>
 #include <SeQuant/core/math.hpp>
 #include <SeQuant/core/meta.hpp>
@@ -10,9 +11,10 @@
 
 #include <btas/btas.h>
 
+#include <algorithm>
 #include <complex>
+#include <vector>
 
-#include <range/v3/view/concat.hpp>
 #include <range/v3/view/iota.hpp>
 
 namespace sequant {
@@ -22,6 +24,45 @@ namespace sequant {
 // unnamed namespaces in headers ... no" guidance)
 namespace detail {
 
+/// \return The extents of \p arr
+template <typename... Args>
+container::svector<std::size_t> btas_extents(btas::Tensor<Args...> const& arr) {
+  container::svector<std::size_t> result(arr.rank());
+  for (std::size_t i = 0; i < result.size(); ++i) result[i] = arr.extent(i);
+  return result;
+}
+
+///
+/// \brief Restrict a btas::Tensor to the elements `[elem_lo, elem_hi)` of mode
+///        \p mode, keeping every element of the other modes.
+///
+/// \see Result::slice_mode
+///
+template <typename... Args>
+[[nodiscard]] btas::Tensor<Args...> slice_btas_over_mode(
+    btas::Tensor<Args...> const& arr, std::size_t mode, std::size_t elem_lo,
+    std::size_t elem_hi) {
+  auto extents = btas_extents(arr);
+  SEQUANT_ASSERT(mode < extents.size());
+  SEQUANT_ASSERT(elem_lo < elem_hi && elem_hi <= extents[mode]);
+
+  std::size_t outer = 1, inner = 1;
+  for (std::size_t i = 0; i < mode; ++i) outer *= extents[i];
+  for (std::size_t i = mode + 1; i < extents.size(); ++i) inner *= extents[i];
+  std::size_t const extent = extents[mode];
+
+  extents[mode] = elem_hi - elem_lo;
+  using range_type = typename btas::Tensor<Args...>::range_type;
+  btas::Tensor<Args...> result{
+      range_type{std::vector<std::size_t>(extents.begin(), extents.end())}};
+  std::size_t const run = extents[mode] * inner;
+  auto const* src = arr.data() + elem_lo * inner;
+  auto* dst = result.data();
+  for (std::size_t o = 0; o < outer; ++o, src += extent * inner, dst += run)
+    std::copy_n(src, run, dst);
+  return result;
+}
+
 ///
 /// \brief This function implements the symmetrization of btas::Tensor.
 ///
@@ -33,34 +74,11 @@ namespace detail {
 ///
 template <typename... Args>
 auto column_symmetrize_btas(btas::Tensor<Args...> const& arr) {
-  using ranges::views::iota;
-
-  size_t const rank = arr.rank();
-
-  if (rank % 2 != 0)
+  if (arr.rank() % 2 != 0)
     throw Exception("This function only supports even-ranked tensors");
 
-  perm_t perm = iota(size_t{0}, rank) | ranges::to<perm_t>;
-
-  auto const lannot = perm;
-
-  auto result = btas::Tensor<Args...>{arr.range()};
-  result.fill(0);
-
-  auto call_back = [&result, &lannot, &arr, &perm = std::as_const(perm)]() {
-    btas::Tensor<Args...> temp;
-    btas::permute(arr, lannot, temp, perm);
-    result += temp;
-  };
-
-  auto const nparticles = rank / 2;
-  symmetric_permutation(SymmetricParticleRange{perm.begin(),               //
-                                               perm.begin() + nparticles,  //
-                                               nparticles},
-                        call_back);
-  auto const nf = static_cast<double>(rational{1, factorial(nparticles)});
-  btas::scal(nf, result);
-
+  btas::Tensor<Args...> result{arr.range()};
+  column_symmetrize_dense(arr.data(), result.data(), btas_extents(arr));
   return result;
 }
 
@@ -76,50 +94,11 @@ auto column_symmetrize_btas(btas::Tensor<Args...> const& arr) {
 template <typename... Args>
 auto particle_antisymmetrize_btas(btas::Tensor<Args...> const& arr,
                                   size_t bra_rank) {
-  using ranges::views::concat;
-  using ranges::views::iota;
-  size_t const rank = arr.rank();
-  SEQUANT_ASSERT(bra_rank <= rank);
-  size_t const ket_rank = rank - bra_rank;
-
-  perm_t bra_perm = iota(size_t{0}, bra_rank) | ranges::to<perm_t>;
-  perm_t ket_perm = iota(bra_rank, rank) | ranges::to<perm_t>;
-  const auto lannot = iota(size_t{0}, rank) | ranges::to<perm_t>;
-
-  auto process_permutations = [&lannot](const btas::Tensor<Args...>& input_arr,
-                                        size_t range_rank, perm_t range_perm,
-                                        const perm_t& other_perm, bool is_bra) {
-    if (range_rank <= 1) return input_arr;
-    btas::Tensor<Args...> result{input_arr.range()};
-
-    auto callback = [&](int parity) {
-      const auto annot =
-          is_bra ? concat(range_perm, other_perm) | ranges::to<perm_t>()
-                 : concat(other_perm, range_perm) | ranges::to<perm_t>();
-
-      typename decltype(result)::numeric_type p_ = parity == 0 ? 1 : -1;
-      btas::Tensor<Args...> temp;
-      btas::permute(input_arr, lannot, temp, annot);
-      btas::scal(p_, temp);
-      result += temp;
-    };
-
-    antisymmetric_permutation(ParticleRange{range_perm.begin(), range_rank},
-                              callback);
-    return result;
-  };
-  // Process bra permutations first
-  const auto ket_annot = ket_rank == 0 ? perm_t{} : ket_perm;
-  auto result = process_permutations(arr, bra_rank, bra_perm, ket_annot, true);
-
-  // Process ket permutations if needed
-  const auto bra_annot = bra_rank == 0 ? perm_t{} : bra_perm;
-  result = process_permutations(result, ket_rank, ket_perm, bra_annot, false);
-
-  auto const nf = static_cast<double>(
-      rational{1, factorial(bra_rank) * factorial(ket_rank)});
-  btas::scal(nf, result);
+  SEQUANT_ASSERT(bra_rank <= arr.rank());
 
+  btas::Tensor<Args...> result{arr.range()};
+  particle_antisymmetrize_dense(arr.data(), result.data(), btas_extents(arr),
+                                bra_rank);
   return result;
 }
 
@@ -245,6 +224,26 @@ class ResultTensorBTAS final : public Result {
     return eval_result<ResultTensorBTAS<T>>(std::move(result));
   }
 
+  [[nodiscard]] ResultPtr slice_mode(std::size_t mode, std::size_t elem_lo,
+                                     std::size_t elem_hi) const override {
+    return eval_result<ResultTensorBTAS<T>>(
+        detail::slice_btas_over_mode(get<T>(), mode, elem_lo, elem_hi));
+  }
+
+  [[nodiscard]] container::svector<std::pair<std::size_t, std::size_t>>
+  mode_batches(std::size_t mode, std::size_t target_batch_size) const override {
+    // dense storage: split evenly into the fewest batches no larger than the
+    // target
+    container::svector<std::pair<std::size_t, std::size_t>> batches;
+    std::size_t const extent = get<T>().extent(mode);
+    if (extent == 0) return batches;
+    std::size_t const target = std::max<std::size_t>(target_batch_size, 1);
+    std::size_t const n = (extent + target - 1) / target;
+    for (std::size_t b = 0; b < n; ++b)
+      batches.emplace_back(b * extent / n, (b + 1) * extent / n);
+    return batches;
+  }
+
   void add_inplace(Result const& other) override {
     auto& t = get<T>();
     auto const& o = other.get<T>();
@@ -267,6 +266,31 @@ class ResultTensorBTAS final : public Result {
         detail::particle_antisymmetrize_btas(get<T>(), bra_rank));
   }
 
+  void add_symmetrized_inplace(Result const& other) override {
+    auto& t = get<T>();
+    auto const& o = other.get<T>();
+    SEQUANT_ASSERT(t.range() == o.range());
+    if (o.rank() % 2 != 0)
+      throw Exception("This function only supports even-ranked tensors");
+
+    detail::log_btas("+= symmetrize\n");
+    detail::column_symmetrize_dense(o.data(), t.data(),
+                                    detail::btas_extents(o), true);
+  }
+
+  void add_antisymmetrized_inplace(Result const& other,
+                                   size_t bra_rank) override {
+    auto& t = get<T>();
+    auto const& o = other.get<T>();
+    SEQUANT_ASSERT(t.range() == o.range());
+    SEQUANT_ASSERT(bra_rank <= o.rank());
+
+    detail::log_btas("+= antisymmetrize\n");
+    detail::particle_antisymmetrize_dense(o.data(), t.data(),
+                                          detail::btas_extents(o), bra_rank,
+                                          true);
+  }
+
  private:
   [[nodiscard]] std::size_t size_in_bytes() const final {
     const auto& tensor = get<T>();
@@ -5,6 +5,7 @@
 
 #include <SeQuant/core/eval/backends/tapp/ops.hpp>
 #include <SeQuant/core/eval/backends/tapp/tensor.hpp>
+#include <SeQuant/core/eval/permuted_sum.hpp>
 #include <SeQuant/core/eval/result.hpp>
 #include <SeQuant/core/math.hpp>
 #include <SeQuant/core/meta.hpp>
@@ -12,9 +13,7 @@
 
 #include <complex>
 
-#include <range/v3/view/concat.hpp>
 #include <range/v3/view/iota.hpp>
-#include <range/v3/view/transform.hpp>
 
 namespace sequant {
 
@@ -23,6 +22,13 @@ namespace sequant {
 // unnamed namespaces in headers ... no" guidance)
 namespace detail {
 
+/// \return The extents of \p arr
+template <typename T, typename Alloc>
+container::svector<std::size_t> tapp_extents(TAPPTensor<T, Alloc> const& arr) {
+  return container::svector<std::size_t>(arr.extents().begin(),
+                                         arr.extents().end());
+}
+
 ///
 /// \brief Symmetrize a TAPPTensor by summing over all symmetric particle
 ///        permutations.
@@ -33,42 +39,11 @@ namespace detail {
 ///
 template <typename T, typename Alloc>
 auto column_symmetrize_tapp(TAPPTensor<T, Alloc> const& arr) {
-  using ranges::views::iota;
-
-  size_t const rank = arr.rank();
-
-  if (rank % 2 != 0)
+  if (arr.rank() % 2 != 0)
     throw Exception("This function only supports even-ranked tensors");
 
-  perm_t perm = iota(size_t{0}, rank) | ranges::to<perm_t>;
-
-  // lannot is identity ordering
-  auto const lannot = perm | ranges::views::transform([](size_t v) {
-                        return static_cast<int64_t>(v);
-                      }) |
-                      ranges::to<container::svector<int64_t>>;
-
   auto result = TAPPTensor<T, Alloc>(arr.extents());
-  result.fill(T{0});
-
-  auto call_back = [&result, &lannot, &arr, &perm = std::as_const(perm)]() {
-    auto perm_annot = perm | ranges::views::transform([](size_t v) {
-                        return static_cast<int64_t>(v);
-                      }) |
-                      ranges::to<container::svector<int64_t>>;
-    TAPPTensor<T, Alloc> temp;
-    tapp_ops::permute(arr, lannot, temp, perm_annot);
-    result += temp;
-  };
-
-  auto const nparticles = rank / 2;
-  symmetric_permutation(SymmetricParticleRange{perm.begin(),               //
-                                               perm.begin() + nparticles,  //
-                                               nparticles},
-                        call_back);
-  auto const nf = static_cast<double>(rational{1, factorial(nparticles)});
-  tapp_ops::scal(static_cast<T>(nf), result);
-
+  column_symmetrize_dense(arr.data(), result.data(), tapp_extents(arr));
   return result;
 }
 
@@ -82,65 +57,11 @@ auto column_symmetrize_tapp(TAPPTensor<T, Alloc> const& arr) {
 template <typename T, typename Alloc>
 auto particle_antisymmetrize_tapp(TAPPTensor<T, Alloc> const& arr,
                                   size_t bra_rank) {
-  using ranges::views::concat;
-  using ranges::views::iota;
-  size_t const rank = arr.rank();
-  SEQUANT_ASSERT(bra_rank <= rank);
-  size_t const ket_rank = rank - bra_rank;
-
-  perm_t bra_perm = iota(size_t{0}, bra_rank) | ranges::to<perm_t>;
-  perm_t ket_perm = iota(bra_rank, rank) | ranges::to<perm_t>;
-  const auto lannot_perm = iota(size_t{0}, rank) | ranges::to<perm_t>;
-
-  // Convert perm_t (svector<size_t>) to annot (svector<int64_t>)
-  auto to_annot = [](perm_t const& p) {
-    return p | ranges::views::transform([](size_t v) {
-             return static_cast<int64_t>(v);
-           }) |
-           ranges::to<container::svector<int64_t>>;
-  };
-
-  auto const lannot = to_annot(lannot_perm);
-
-  auto process_permutations = [&lannot, &to_annot](
-                                  const TAPPTensor<T, Alloc>& input_arr,
-                                  size_t range_rank, perm_t range_perm,
-                                  const perm_t& other_perm, bool is_bra) {
-    if (range_rank <= 1) return input_arr;
-    TAPPTensor<T, Alloc> result{input_arr.extents()};
-    result.fill(T{0});
-
-    auto callback = [&](int parity) {
-      const auto annot_perm =
-          is_bra ? concat(range_perm, other_perm) | ranges::to<perm_t>()
-                 : concat(other_perm, range_perm) | ranges::to<perm_t>();
-
-      auto const annot = to_annot(annot_perm);
-
-      T p_ = parity == 0 ? T{1} : T{-1};
-      TAPPTensor<T, Alloc> temp;
-      tapp_ops::permute(input_arr, lannot, temp, annot);
-      tapp_ops::scal(p_, temp);
-      result += temp;
-    };
-
-    antisymmetric_permutation(ParticleRange{range_perm.begin(), range_rank},
-                              callback);
-    return result;
-  };
-
-  // Process bra permutations first
-  const auto ket_annot = ket_rank == 0 ? perm_t{} : ket_perm;
-  auto result = process_permutations(arr, bra_rank, bra_perm, ket_annot, true);
-
-  // Process ket permutations if needed
-  const auto bra_annot = bra_rank == 0 ? perm_t{} : bra_perm;
-  result = process_permutations(result, ket_rank, ket_perm, bra_annot, false);
-
-  auto const nf = static_cast<double>(
-      rational{1, factorial(bra_rank) * factorial(ket_rank)});
-  tapp_ops::scal(static_cast<T>(nf), result);
+  SEQUANT_ASSERT(bra_rank <= static_cast<size_t>(arr.rank()));
 
+  auto result = TAPPTensor<T, Alloc>(arr.extents());
+  particle_antisymmetrize_dense(arr.data(), result.data(), tapp_extents(arr),
+                                bra_rank);
   return result;
 }
 
@@ -291,6 +212,31 @@ class ResultTensorTAPP final : public Result {
         detail::particle_antisymmetrize_tapp(get<T>(), bra_rank));
   }
 
+  void add_symmetrized_inplace(Result const& other) override {
+    auto& t = get<T>();
+    auto const& o = other.get<T>();
+    SEQUANT_ASSERT(t.extents() == o.extents());
+    if (o.rank() % 2 != 0)
+      throw Exception("This function only supports even-ranked tensors");
+
+    detail::log_tapp("+= symmetrize\n");
+    detail::column_symmetrize_dense(o.data(), t.data(),
+                                    detail::tapp_extents(o), true);
+  }
+
+  void add_antisymmetrized_inplace(Result const& other,
+                                   size_t bra_rank) override {
+    auto& t = get<T>();
+    auto const& o = other.get<T>();
+    SEQUANT_ASSERT(t.extents() == o.extents());
+    SEQUANT_ASSERT(bra_rank <= static_cast<size_t>(o.rank()));
+
+    detail::log_tapp("+= antisymmetrize\n");
+    detail::particle_antisymmetrize_dense(o.data(), t.data(),
+                                          detail::tapp_extents(o), bra_rank,
+                                          true);
+  }
+
  private:
   [[nodiscard]] std::size_t size_in_bytes() const final {
     const auto& tensor = get<T>();
@@ -53,16 +53,21 @@ template <typename ArrayT>
 
 ///
 /// \brief Particle-symmetrize a TA::DistArray (tensor-of-scalar or
-///        tensor-of-tensor).
+///        tensor-of-tensor) and accumulate the result.
+///
+/// The normalization is folded into every permuted term, so that each term
+/// is accumulated into \p result by a single expression and no separate
+/// scaling pass is needed.
 ///
 /// \param arr The array to be symmetrized.
 ///
-/// \pre ToS: rank is even. ToT: outer rank == inner rank.
+/// \param result The array to accumulate into; assigned if not initialized.
 ///
-/// \return The symmetrized TA::DistArray.
+/// \pre ToS: rank is even. ToT: outer rank == inner rank.
 ///
 template <typename... Args>
-auto column_symmetrize_ta(TA::DistArray<Args...> const& arr) {
+void column_symmetrize_ta(TA::DistArray<Args...> const& arr,
+                          TA::DistArray<Args...>& result) {
   using ranges::views::iota;
   constexpr bool is_tot = TA::detail::is_tensor_of_tensor_v<
       typename TA::DistArray<Args...>::value_type>;
@@ -75,7 +80,10 @@ auto column_symmetrize_ta(TA::DistArray<Args...> const& arr) {
     // to read a rank from, so tot_inner_rank() is 0. It represents zero, and
     // symmetrizing zero is zero -- return unchanged instead of failing the
     // equal-rank check below.
-    if (inner_rank == 0) return arr;
+    if (inner_rank == 0) {
+      if (!result.is_initialized()) result = arr;
+      return;
+    }
     if (outer_rank != inner_rank)
       throw Exception(
           "ToT symmetrization requires equal outer and inner rank (outer=" +
@@ -104,15 +112,15 @@ auto column_symmetrize_ta(TA::DistArray<Args...> const& arr) {
   };
 
   auto const lannot = make_annot(perm);
+  auto const nf = static_cast<double>(rational{1, factorial(nparticles)});
 
-  TA::DistArray<Args...> result;
   auto call_back = [&result, &lannot, &arr, &perm = std::as_const(perm),
-                    &make_annot]() {
+                    &make_annot, nf]() {
     auto const rannot = make_annot(perm);
     if (result.is_initialized()) {
-      result(lannot) += arr(rannot);
+      result(lannot) += nf * arr(rannot);
     } else {
-      result(lannot) = arr(rannot);
+      result(lannot) = nf * arr(rannot);
     }
   };
 
@@ -121,81 +129,127 @@ auto column_symmetrize_ta(TA::DistArray<Args...> const& arr) {
                                                nparticles},
                         call_back);
 
-  auto const nf = static_cast<double>(rational{1, factorial(nparticles)});
-  result(lannot) = nf * result(lannot);
-
   TA::DistArray<Args...>::wait_for_lazy_cleanup(result.world());
+}
 
+///
+/// \brief Particle-symmetrize a TA::DistArray (tensor-of-scalar or
+///        tensor-of-tensor).
+///
+/// \param arr The array to be symmetrized.
+///
+/// \pre ToS: rank is even. ToT: outer rank == inner rank.
+///
+/// \return The symmetrized TA::DistArray.
+///
+template <typename... Args>
+auto column_symmetrize_ta(TA::DistArray<Args...> const& arr) {
+  TA::DistArray<Args...> result;
+  column_symmetrize_ta(arr, result);
   return result;
 }
 
 ///
-/// \brief This function implements the antisymmetrization of TA::DistArray.
+/// \brief Antisymmetrize a TA::DistArray and accumulate the result.
+///
+/// The bra and the ket permutations are applied one after the other; the
+/// normalization is folded into the terms of the last one, which are
+/// accumulated into \p result directly.
 ///
 /// \param arr The array to be antisymmetrized.
 ///
 /// \param bra_rank The rank of the bra indices
 ///
-/// \return The antisymmetrized TA::DistArray.
+/// \param result The array to accumulate into; assigned if not initialized.
 ///
 template <typename... Args>
-auto particle_antisymmetrize_ta(TA::DistArray<Args...> const& arr,
-                                size_t bra_rank) {
+void particle_antisymmetrize_ta(TA::DistArray<Args...> const& arr,
+                                size_t bra_rank,
+                                TA::DistArray<Args...>& result) {
   using ranges::views::iota;
+  using numeric_type = typename TA::DistArray<Args...>::numeric_type;
   size_t const rank = arr.trange().rank();
   SEQUANT_ASSERT(bra_rank <= rank);
   size_t const ket_rank = rank - bra_rank;
 
-  if (bra_rank <= 1 && ket_rank <= 1) {
-    // nothing to do
-    return arr;
-  }
-
   perm_t perm = iota(size_t{0}, rank) | ranges::to<perm_t>;
   perm_t bra_perm = iota(size_t{0}, bra_rank) | ranges::to<perm_t>;
   perm_t ket_perm = iota(bra_rank, rank) | ranges::to<perm_t>;
 
   const auto lannot = ords_to_annot(perm);
 
-  auto process_permutations = [&lannot](const TA::DistArray<Args...>& input_arr,
-                                        size_t range_rank, perm_t range_perm,
-                                        const std::string& other_annot,
-                                        bool is_bra) -> TA::DistArray<Args...> {
-    if (range_rank <= 1) return input_arr;
-    TA::DistArray<Args...> result;
+  auto accumulate = [&lannot](TA::DistArray<Args...>& target,
+                              numeric_type scale,
+                              const TA::DistArray<Args...>& input_arr,
+                              const std::string& annot) {
+    if (target.is_initialized()) {
+      target(lannot) += scale * input_arr(annot);
+    } else {
+      target(lannot) = scale * input_arr(annot);
+    }
+  };
+
+  if (bra_rank <= 1 && ket_rank <= 1) {
+    // nothing to permute
+    if (result.is_initialized())
+      accumulate(result, numeric_type{1}, arr, lannot);
+    else
+      result = arr;
+    return;
+  }
 
+  auto process_permutations = [&accumulate](
+                                  const TA::DistArray<Args...>& input_arr,
+                                  size_t range_rank, perm_t range_perm,
+                                  const std::string& other_annot, bool is_bra,
+                                  numeric_type scale,
+                                  TA::DistArray<Args...>& target) {
     auto callback = [&](int parity) {
       const auto range_annot = ords_to_annot(range_perm);
       const auto annot = other_annot.empty()
                              ? range_annot
                              : (is_bra ? range_annot + "," + other_annot
                                        : other_annot + "," + range_annot);
-
-      typename decltype(result)::numeric_type p_ = parity == 0 ? 1 : -1;
-      if (result.is_initialized()) {
-        result(lannot) += p_ * input_arr(annot);
-      } else {
-        result(lannot) = p_ * input_arr(annot);
-      }
+      accumulate(target, parity == 0 ? scale : -scale, input_arr, annot);
     };
     antisymmetric_permutation(ParticleRange{range_perm.begin(), range_rank},
                               callback);
-    return result;
   };
 
-  // Process bra permutations first
+  numeric_type const nf = static_cast<double>(
+      rational{1, factorial(bra_rank) * factorial(ket_rank)});
   const auto ket_annot = ket_rank == 0 ? "" : ords_to_annot(ket_perm);
-  auto result = process_permutations(arr, bra_rank, bra_perm, ket_annot, true);
-
-  // Process ket permutations
   const auto bra_annot = bra_rank == 0 ? "" : ords_to_annot(bra_perm);
-  result = process_permutations(result, ket_rank, ket_perm, bra_annot, false);
 
-  auto const nf = static_cast<double>(
-      rational{1, factorial(bra_rank) * factorial(ket_rank)});
-  result(lannot) = nf * result(lannot);
+  if (bra_rank <= 1) {
+    process_permutations(arr, ket_rank, ket_perm, bra_annot, false, nf, result);
+  } else if (ket_rank <= 1) {
+    process_permutations(arr, bra_rank, bra_perm, ket_annot, true, nf, result);
+  } else {
+    TA::DistArray<Args...> bra_antisymmetrized;
+    process_permutations(arr, bra_rank, bra_perm, ket_annot, true,
+                         numeric_type{1}, bra_antisymmetrized);
+    process_permutations(bra_antisymmetrized, ket_rank, ket_perm, bra_annot,
+                         false, nf, result);
+  }
 
   TA::DistArray<Args...>::wait_for_lazy_cleanup(result.world());
+}
+
+///
+/// \brief This function implements the antisymmetrization of TA::DistArray.
+///
+/// \param arr The array to be antisymmetrized.
+///
+/// \param bra_rank The rank of the bra indices
+///
+/// \return The antisymmetrized TA::DistArray.
+///
+template <typename... Args>
+auto particle_antisymmetrize_ta(TA::DistArray<Args...> const& arr,
+                                size_t bra_rank) {
+  TA::DistArray<Args...> result;
+  particle_antisymmetrize_ta(arr, bra_rank, result);
   return result;
 }
 
@@ -450,6 +504,23 @@ class ResultTensorTA final : public Result {
         detail::particle_antisymmetrize_ta(get<ArrayT>(), bra_rank));
   }
 
+  void add_symmetrized_inplace(Result const& other) override {
+    SEQUANT_ASSERT(other.is<this_type>());
+    auto& t = get<ArrayT>();
+    SEQUANT_ASSERT(t.trange() == other.get<ArrayT>().trange());
+    detail::column_symmetrize_ta(other.get<ArrayT>(), t);
+    log_ta_tensor_host_memory_use();
+  }
+
+  void add_antisymmetrized_inplace(Result const& other,
+                                   size_t bra_rank) override {
+    SEQUANT_ASSERT(other.is<this_type>());
+    auto& t = get<ArrayT>();
+    SEQUANT_ASSERT(t.trange() == other.get<ArrayT>().trange());
+    detail::particle_antisymmetrize_ta(other.get<ArrayT>(), bra_rank, t);
+    log_ta_tensor_host_memory_use();
+  }
+
  private:
   [[nodiscard]] std::size_t size_in_bytes() const final {
     auto& v = get<ArrayT>();
@@ -20,6 +20,7 @@
 #include <any>
 #include <chrono>
 #include <iostream>
+#include <limits>
 #include <optional>
 #include <stdexcept>
 #include <type_traits>
@@ -895,6 +896,75 @@ ResultPtr evaluate_antisymm(Args&&... args) {
   return result;
 }
 
+///
+/// \tparam EvalTrace If Trace::On, trace is written to the logger's stream.
+///                   Default is to follow Trace::Default, which is itself
+///                   equal to Trace::On or Trace::Off.
+/// \brief Calls sequant::evaluate and accumulates the particle-symmetrized
+///        result into \p result, without creating the symmetrized temporary.
+///        If \p result is null, this is equivalent to sequant::evaluate_symm.
+/// \see evaluate_symm.
+///
+template <Trace EvalTrace = Trace::Default, typename... Args>
+void evaluate_symm_inplace(ResultPtr& result, Args&&... args) {
+  if (!result) {
+    result = evaluate_symm<EvalTrace>(std::forward<Args>(args)...);
+    return;
+  }
+  ResultPtr pre = evaluate<EvalTrace>(std::forward<Args>(args)...);
+  SEQUANT_ASSERT(pre);
+  auto time = detail::timed_eval_inplace(
+      [&]() { result->add_symmetrized_inplace(*pre); });
+
+  // logging
+  if constexpr (detail::trace(EvalTrace)) {
+    auto stat = log::EvalStat{.mode = log::EvalMode::Symmetrize,
+                              .time = time,
+                              .mem_result = log::bytes(result),
+                              .mem_alloc = log::Bytes{0},
+                              .mem_hwmark = log::bytes(pre, result)};
+    log::eval(
+        stat,
+        detail::node0(detail::arg0(std::forward<Args>(args)...))->label());
+  }
+}
+
+///
+/// \tparam EvalTrace If Trace::On, trace is written to the logger's stream.
+///                   Default is to follow Trace::Default, which is itself
+///                   equal to Trace::On or Trace::Off.
+/// \brief Calls sequant::evaluate and accumulates the antisymmetrized result
+///        into \p result, without creating the antisymmetrized temporary.
+///        If \p result is null, this is equivalent to
+///        sequant::evaluate_antisymm.
+/// \see evaluate_antisymm.
+///
+template <Trace EvalTrace = Trace::Default, typename... Args>
+void evaluate_antisymm_inplace(ResultPtr& result, Args&&... args) {
+  if (!result) {
+    result = evaluate_antisymm<EvalTrace>(std::forward<Args>(args)...);
+    return;
+  }
+  ResultPtr pre = evaluate<EvalTrace>(std::forward<Args>(args)...);
+  SEQUANT_ASSERT(pre);
+
+  auto const& n0 = detail::node0(detail::arg0(std::forward<Args>(args)...));
+
+  auto time = detail::timed_eval_inplace([&]() {
+    result->add_antisymmetrized_inplace(*pre, n0->as_tensor().bra_rank());
+  });
+
+  // logging
+  if constexpr (detail::trace(EvalTrace)) {
+    auto stat = log::EvalStat{.mode = log::EvalMode::Antisymmetrize,
+                              .time = time,
+                              .mem_result = log::bytes(result),
+                              .mem_alloc = log::Bytes{0},
+                              .mem_hwmark = log::bytes(pre, result)};
+    log::eval(stat, n0->label());
+  }
+}
+
 /// \brief Builds a custom evaluator (see CacheManager::custom_evaluator_type)
 /// that evaluates a subtree in batches over a contracted index, to bound the
 /// peak memory of intermediates that carry that index.
@@ -945,7 +1015,10 @@ ResultPtr evaluate_antisymm(Args&&... args) {
 ///        user knob; no memory model is assumed). Backend-neutral: a tiled
 ///        backend rounds batch boundaries to tile boundaries, so realized
 ///        batches are uneven and each covers at least this many elements where
-///        possible.
+///        possible. May instead be a batch-size policy, invoked as
+///        `policy(node, K, le)` for each intercepted node (see
+///        memory_budget_batch_size); the trigger's size is then used for the
+///        whole replay group.
 /// \param accept predicate selecting which contracted indices may be batched
 ///        (e.g. only those in the auxiliary/RI IndexSpace). Defaults to any.
 /// \param make_scope_guard factory, called with the batch count, returning an
@@ -1005,8 +1078,88 @@ template <typename Node, typename Pred>
   return subtree_any(n.left(), pred) || subtree_any(n.right(), pred);
 }
 
+/// \return the extent of every index carried by a leaf of the subtree rooted
+///         at \p node, as realized by the leaf evaluator \p le. Backends report
+///         extents through Result::mode_batches, so only backends supporting
+///         batched evaluation are supported.
+template <typename Node, typename F>
+[[nodiscard]] container::map<Index, std::size_t> index_extents(Node const& node,
+                                                              F const& le) {
+  container::map<Index, std::size_t> result;
+  auto visit = [&](auto&& self, Node const& n) -> void {
+    if (!n.leaf()) {
+      self(self, n.left());
+      self(self, n.right());
+      return;
+    }
+    auto const& idxs = n->canon_indices();
+    if (std::all_of(idxs.begin(), idxs.end(),
+                    [&result](Index const& ix) { return result.contains(ix); }))
+      return;
+    ResultPtr const r = le(n);
+    for (std::size_t p = 0; p < idxs.size(); ++p) {
+      if (result.contains(idxs[p])) continue;
+      auto const batches =
+          r->mode_batches(p, std::numeric_limits<std::size_t>::max());
+      result.emplace(idxs[p], batches.empty() ? std::size_t{0}
+                                              : batches.back().second -
+                                                    batches.front().first);
+    }
+  };
+  visit(visit, node);
+  return result;
+}
+
+/// Batch-size policy for make_batched_custom_evaluator that derives the batch
+/// size from a memory budget: every intermediate (and leaf) of the intercepted
+/// subtree that carries the batch axis \c K shrinks proportionally to the
+/// batch, so the largest of them, per element of \c K, bounds the batch size
+/// that keeps it within \c budget_bytes. Extents are taken from the leaves
+/// (see index_extents). A budget too small for a single element of \c K
+/// yields a batch size of 1.
+struct memory_budget_batch_size {
+  /// The memory budget of the largest batched intermediate, in bytes.
+  std::size_t budget_bytes;
+
+  /// The size of a tensor element, in bytes.
+  std::size_t element_bytes = sizeof(double);
+
+  template <typename Node, typename F>
+  [[nodiscard]] std::size_t operator()(Node const& node, Index const& K,
+                                       F const& le) const {
+    auto const extents = index_extents(node, le);
+    std::size_t max_per_element = 1;
+    auto visit = [&](auto&& self, Node const& n) -> void {
+      if (index_position(n, K)) {
+        std::size_t size = element_bytes;
+        for (Index const& ix : n->canon_indices())
+          if (ix != K) size *= extents.at(ix);
+        max_per_element = std::max(max_per_element, size);
+      }
+      if (n.leaf()) return;
+      self(self, n.left());
+      self(self, n.right());
+    };
+    visit(visit, node);
+    return std::max<std::size_t>(budget_bytes / max_per_element, 1);
+  }
+};
+
 namespace detail {
 
+/// \return the target batch size of the subtree at \p node batched over \p K:
+///         \p target itself if it is a number, otherwise the result of the
+///         batch-size policy \p target.
+template <typename BatchSize, typename Node, typename F>
+[[nodiscard]] std::size_t resolve_batch_size(BatchSize const& target,
+                                             Node const& node, Index const& K,
+                                             F const& le) {
+  if constexpr (std::is_integral_v<BatchSize>)
+    return static_cast<std::size_t>(target);
+  else
+    return target(node, K, le);
+}
+
 /// The scratch cache for one batched replay pass, plus the alive persistent
 /// real-cache entries to pre-seed it with (registered persistent in the
 /// scratch, so they survive the per-batch reset()).
@@ -1109,13 +1262,14 @@ template <typename TreeNode, bool FHC, typename Members>
 
 }  // namespace detail
 
-template <typename F, typename IndexPredicate = accept_any_index,
+template <typename F, typename BatchSize = std::size_t,
+          typename IndexPredicate = accept_any_index,
           typename ScopeGuardFactory = make_no_scope_guard,
           typename IsVolatile = never_volatile>
 [[nodiscard]] auto make_batched_custom_evaluator(
-    F le, std::size_t target_batch_size, IndexPredicate accept = {},
+    F le, BatchSize batch_size, IndexPredicate accept = {},
     ScopeGuardFactory make_scope_guard = {}, IsVolatile is_volatile = {}) {
-  return [le = std::move(le), target_batch_size, accept, is_volatile,
+  return [le = std::move(le), batch_size, accept, is_volatile,
           make_scope_guard](auto const& node, auto& cache) -> ResultPtr {
     auto const K = batch_axis(node, accept);
     if (!K) return nullptr;
@@ -1129,6 +1283,8 @@ template <typename F, typename IndexPredicate = accept_any_index,
 
     auto const leaf = find_leaf_carrying(node, *K);
     if (!leaf) return nullptr;
+    std::size_t const target_batch_size =
+        detail::resolve_batch_size(batch_size, node, *K, le);
     auto const batches =
         le(leaf->first)->mode_batches(leaf->second, target_batch_size);
 
@@ -0,0 +1,343 @@
+#ifndef SEQUANT_EVAL_PERMUTED_SUM_HPP
+#define SEQUANT_EVAL_PERMUTED_SUM_HPP
+
+#include <SeQuant/core/container.hpp>
+#include <SeQuant/core/math.hpp>
+#include <SeQuant/core/utility/macros.hpp>
+
+#include <algorithm>
+#include <complex>
+#include <cstddef>
+#include <numeric>
+#include <vector>
+
+namespace sequant::detail {
+
+///
+/// \brief Single-pass weighted sum of mode permutations of a dense tensor.
+///
+/// Computes `out(i_0,...,i_{r-1}) (+)= Σ_p w_p in(i_{a_p[0]},...,i_{a_p[r-1]})`
+/// for row-major contiguous \p in and \p out, where `a_p` is `annots[p]`, i.e.
+/// the same as summing `w_p` times the input permuted from layout `a_p` to the
+/// identity layout, without materializing any permuted copy.
+///
+/// Trailing modes that no permutation moves are fused into one contiguous run.
+/// The remaining modes are traversed in tiles whose permuted images, which are
+/// tiles as well, fit in cache together, so each input element is fetched from
+/// memory once per tile. Permutations sharing a weight are summed before
+/// scaling and those with a vanishing weight are skipped.
+///
+/// \param in The input data.
+/// \param out The output data; must not alias \p in.
+/// \param extents The extents of all modes; modes mapped onto each other by a
+///                permutation must have equal extents.
+/// \param annots The permutations, as layouts of the input.
+/// \param weights The weight of each permutation.
+/// \param accumulate If true, the sum is added to \p out instead of
+///                   overwriting it.
+///
+template <typename T>
+void permuted_sum_dense(
+    T const* in, T* out, container::svector<std::size_t> const& extents,
+    std::vector<container::svector<std::size_t>> const& annots,
+    std::vector<T> const& weights, bool accumulate = false) {
+  // upper bound on the memory touched by one tile and its permuted images
+  constexpr std::size_t tile_bytes = std::size_t{1} << 18;
+  // longest contiguous run of unpermuted elements processed at once
+  constexpr std::size_t max_run = 512;
+
+  SEQUANT_ASSERT(annots.size() == weights.size());
+  SEQUANT_ASSERT(in != out);
+  std::size_t const rank = extents.size();
+
+  std::size_t volume = 1;
+  for (auto e : extents) volume *= e;
+  if (volume == 0) return;
+
+  // group permutations by weight
+  std::vector<std::size_t> order;
+  for (std::size_t p = 0; p < weights.size(); ++p) {
+    SEQUANT_ASSERT(annots[p].size() == rank);
+    if (weights[p] != T(0)) order.push_back(p);
+  }
+  std::stable_sort(order.begin(), order.end(),
+                   [&weights](std::size_t lhs, std::size_t rhs) {
+                     auto const l = weights[lhs];
+                     auto const r = weights[rhs];
+                     return std::real(l) < std::real(r) ||
+                            (std::real(l) == std::real(r) &&
+                             std::imag(l) < std::imag(r));
+                   });
+
+  if (order.empty() || rank == 0) {
+    T w(0);
+    for (auto p : order) w += weights[p];
+    for (std::size_t i = 0; i < volume; ++i) {
+      out[i] = (accumulate ? out[i] : T(0)) + w * in[i];
+    }
+    return;
+  }
+
+  // modes [lead, rank) are not moved by any permutation
+  std::size_t lead = rank;
+  while (lead > 0 &&
+         std::all_of(order.begin(), order.end(), [&](std::size_t p) {
+           return annots[p][lead - 1] == lead - 1;
+         })) {
+    --lead;
+  }
+
+  // effective modes: [0, lead) plus, if any, the fused unpermuted run
+  container::svector<std::size_t> ext(extents.begin(), extents.begin() + lead);
+  if (lead < rank) {
+    std::size_t run = 1;
+    for (std::size_t k = lead; k < rank; ++k) run *= extents[k];
+    ext.push_back(run);
+  }
+  std::size_t const nmodes = ext.size();
+  std::size_t const last = nmodes - 1;
+
+  container::svector<std::size_t> strides(nmodes, 1);
+  for (std::size_t k = last; k > 0; --k) strides[k - 1] = strides[k] * ext[k];
+
+  // copy c reads the input at offset Σ_k i_k copy_strides[c][k]
+  std::size_t const ncopies = order.size();
+  std::vector<container::svector<std::size_t>> copy_strides;
+  copy_strides.reserve(ncopies);
+  container::svector<bool> moved(nmodes, false);
+  container::svector<T> group_weights;
+  container::svector<std::size_t> group_ends;
+  for (auto p : order) {
+    container::svector<std::size_t> s(strides);
+    for (std::size_t k = 0; k < lead; ++k) {
+      SEQUANT_ASSERT(annots[p][k] < lead);
+      SEQUANT_ASSERT(ext[annots[p][k]] == ext[k]);
+      s[annots[p][k]] = strides[k];
+      if (annots[p][k] != k) moved[k] = true;
+    }
+    copy_strides.push_back(std::move(s));
+
+    if (group_weights.empty() || weights[p] != group_weights.back()) {
+      group_weights.push_back(weights[p]);
+      group_ends.push_back(copy_strides.size());
+    } else {
+      group_ends.back() = copy_strides.size();
+    }
+  }
+
+  // tile edges: permuted modes share the edge t, other modes are visited one
+  // index at a time except for the innermost one
+  std::size_t t = 1;
+  std::size_t nmoved = 0;
+  for (std::size_t k = 0; k < nmodes; ++k) {
+    if (moved[k]) {
+      t = std::max(t, ext[k]);
+      ++nmoved;
+    }
+  }
+  std::size_t const inner = moved[last] ? 1 : std::min(ext[last], max_run);
+  auto footprint = [&](std::size_t edge) {
+    std::size_t v = (ncopies + 1) * inner * sizeof(T);
+    for (std::size_t k = 0; k < nmoved; ++k) v *= edge;
+    return v;
+  };
+  while (t > 1 && footprint(t) > tile_bytes) t = (t + 1) / 2;
+
+  container::svector<std::size_t> edges(nmodes, 1);
+  for (std::size_t k = 0; k < nmodes; ++k) {
+    if (moved[k])
+      edges[k] = t;
+    else if (k == last)
+      edges[k] = inner;
+  }
+
+  // odometer over the first nmodes entries of counter; false once exhausted
+  auto advance = [](auto& counter, auto const& lo, auto const& hi,
+                    auto const& step, std::size_t n) {
+    for (std::size_t j = n; j-- > 0;) {
+      counter[j] += step[j];
+      if (counter[j] < hi[j]) return true;
+      counter[j] = lo[j];
+    }
+    return false;
+  };
+
+  container::svector<std::size_t> const zeros(nmodes, 0);
+  container::svector<std::size_t> const ones(nmodes, 1);
+  container::svector<std::size_t> tile_begin(nmodes, 0);
+  container::svector<std::size_t> tile_end(nmodes);
+  container::svector<std::size_t> idx(nmodes);
+  std::vector<std::size_t> base(ncopies);
+  std::vector<T> row_sum(edges[last]);
+  std::vector<T> group_sum(edges[last]);
+
+  do {
+    for (std::size_t k = 0; k < nmodes; ++k) {
+      tile_end[k] = std::min(tile_begin[k] + edges[k], ext[k]);
+    }
+    std::size_t const row_begin = tile_begin[last];
+    std::size_t const row_size = tile_end[last] - row_begin;
+
+    idx = tile_begin;
+    do {
+      std::size_t out_offset = row_begin;
+      for (std::size_t k = 0; k < last; ++k) out_offset += idx[k] * strides[k];
+      for (std::size_t c = 0; c < ncopies; ++c) {
+        std::size_t offset = row_begin * copy_strides[c][last];
+        for (std::size_t k = 0; k < last; ++k) {
+          offset += idx[k] * copy_strides[c][k];
+        }
+        base[c] = offset;
+      }
+
+      std::fill_n(row_sum.begin(), row_size, T(0));
+      for (std::size_t g = 0, c = 0; g < group_weights.size(); ++g) {
+        std::fill_n(group_sum.begin(), row_size, T(0));
+        for (; c < group_ends[g]; ++c) {
+          T const* src = in + base[c];
+          std::size_t const s = copy_strides[c][last];
+          if (s == 1) {
+            for (std::size_t i = 0; i < row_size; ++i) group_sum[i] += src[i];
+          } else {
+            for (std::size_t i = 0; i < row_size; ++i) {
+              group_sum[i] += src[i * s];
+            }
+          }
+        }
+        for (std::size_t i = 0; i < row_size; ++i) {
+          row_sum[i] += group_weights[g] * group_sum[i];
+        }
+      }
+
+      T* dst = out + out_offset;
+      if (accumulate) {
+        for (std::size_t i = 0; i < row_size; ++i) dst[i] += row_sum[i];
+      } else {
+        std::copy_n(row_sum.begin(), row_size, dst);
+      }
+    } while (advance(idx, tile_begin, tile_end, ones, last));
+  } while (advance(tile_begin, zeros, ext, edges, nmodes));
+}
+
+///
+/// \brief Single-pass column (particle) symmetrization of a dense tensor.
+///
+/// Sums the input over all simultaneous permutations of the bra and the ket
+/// modes, normalized by `1/n!`, see permuted_sum_dense.
+///
+/// \param in The input data.
+/// \param out The output data; must not alias \p in.
+/// \param extents The extents of all modes.
+/// \param accumulate If true, the result is added to \p out.
+///
+/// \pre The rank must be even.
+///
+template <typename T>
+void column_symmetrize_dense(T const* in, T* out,
+                             container::svector<std::size_t> const& extents,
+                             bool accumulate = false) {
+  std::size_t const rank = extents.size();
+  SEQUANT_ASSERT(rank % 2 == 0);
+  std::size_t const nparticles = rank / 2;
+
+  container::svector<std::size_t> perm(nparticles);
+  std::iota(perm.begin(), perm.end(), std::size_t{0});
+
+  std::vector<container::svector<std::size_t>> annots;
+  do {
+    container::svector<std::size_t> annot(perm);
+    for (auto p : perm) annot.push_back(nparticles + p);
+    annots.push_back(std::move(annot));
+  } while (std::next_permutation(perm.begin(), perm.end()));
+
+  T const nf = T(static_cast<double>(rational{1, factorial(nparticles)}));
+  permuted_sum_dense(in, out, extents, annots,
+                     std::vector<T>(annots.size(), nf), accumulate);
+}
+
+///
+/// \brief Particle antisymmetrization of a dense tensor.
+///
+/// Sums the signed input over all permutations of the bra modes and of the
+/// ket modes, normalized by `1/(bra_rank! ket_rank!)`. Up to a moderate
+/// number of combined permutations this is done in a single pass, otherwise
+/// the bra and the ket permutations are applied in two passes through a
+/// scratch buffer to keep the operation count at `bra_rank! + ket_rank!`.
+///
+/// \param in The input data.
+/// \param out The output data; must not alias \p in.
+/// \param extents The extents of all modes.
+/// \param bra_rank The number of leading (bra) modes.
+/// \param accumulate If true, the result is added to \p out.
+///
+template <typename T>
+void particle_antisymmetrize_dense(
+    T const* in, T* out, container::svector<std::size_t> const& extents,
+    std::size_t bra_rank, bool accumulate = false) {
+  constexpr std::size_t max_fused_perms = 36;
+
+  std::size_t const rank = extents.size();
+  SEQUANT_ASSERT(bra_rank <= rank);
+  std::size_t const ket_rank = rank - bra_rank;
+
+  // signed permutations of modes [first, first + n), other modes fixed
+  auto signed_perms = [rank](std::size_t first, std::size_t n) {
+    std::vector<std::pair<container::svector<std::size_t>, int>> result;
+    container::svector<std::size_t> perm(n);
+    std::iota(perm.begin(), perm.end(), first);
+    do {
+      int parity = 0;
+      for (std::size_t i = 0; i < n; ++i)
+        for (std::size_t j = i + 1; j < n; ++j)
+          if (perm[i] > perm[j]) parity ^= 1;
+      container::svector<std::size_t> annot(rank);
+      std::iota(annot.begin(), annot.end(), std::size_t{0});
+      std::copy(perm.begin(), perm.end(), annot.begin() + first);
+      result.emplace_back(std::move(annot), parity);
+    } while (std::next_permutation(perm.begin(), perm.end()));
+    return result;
+  };
+
+  auto const bra_perms = signed_perms(0, bra_rank);
+  auto const ket_perms = signed_perms(bra_rank, ket_rank);
+  T const nf = T(static_cast<double>(
+      rational{1, factorial(bra_rank) * factorial(ket_rank)}));
+
+  std::vector<container::svector<std::size_t>> annots;
+  std::vector<T> weights;
+  auto add = [&](container::svector<std::size_t> annot, int parity, T w) {
+    annots.push_back(std::move(annot));
+    weights.push_back(parity == 0 ? w : -w);
+  };
+
+  if (bra_perms.size() == 1 || ket_perms.size() == 1 ||
+      bra_perms.size() * ket_perms.size() <= max_fused_perms) {
+    for (auto const& [bra, bra_parity] : bra_perms) {
+      for (auto const& [ket, ket_parity] : ket_perms) {
+        container::svector<std::size_t> annot(bra.begin(),
+                                              bra.begin() + bra_rank);
+        annot.insert(annot.end(), ket.begin() + bra_rank, ket.end());
+        add(std::move(annot), bra_parity ^ ket_parity, nf);
+      }
+    }
+    permuted_sum_dense(in, out, extents, annots, weights, accumulate);
+    return;
+  }
+
+  std::size_t volume = 1;
+  for (auto e : extents) volume *= e;
+  std::vector<T> scratch(volume);
+
+  for (auto const& [annot, parity] : bra_perms) add(annot, parity, T(1));
+  permuted_sum_dense(in, scratch.data(), extents, annots, weights);
+
+  annots.clear();
+  weights.clear();
+  for (auto const& [annot, parity] : ket_perms) add(annot, parity, nf);
+  permuted_sum_dense(scratch.data(), out, extents, annots, weights,
+                     accumulate);
+}
+
+}  // namespace sequant::detail
+
+#endif  // SEQUANT_EVAL_PERMUTED_SUM_HPP
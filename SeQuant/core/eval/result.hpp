@@ -347,6 +347,30 @@ class Result {
   ///
   [[nodiscard]] virtual ResultPtr antisymmetrize(size_t bra_rank) const = 0;
 
+  ///
+  /// \brief Add the particle symmetrization of other Result object into this
+  ///        object.
+  ///
+  /// Equivalent to `add_inplace(*other.symmetrize())`, which is also the
+  /// default; backends override it to avoid the symmetrized temporary.
+  ///
+  virtual void add_symmetrized_inplace(Result const& other) {
+    add_inplace(*other.symmetrize());
+  }
+
+  ///
+  /// \brief Add the particle antisymmetrization of other Result object into
+  ///        this object.
+  ///
+  /// Equivalent to `add_inplace(*other.antisymmetrize(bra_rank))`, which is
+  /// also the default; backends override it to avoid the antisymmetrized
+  /// temporary.
+  ///
+  virtual void add_antisymmetrized_inplace(Result const& other,
+                                           size_t bra_rank) {
+    add_inplace(*other.antisymmetrize(bra_rank));
+  }
+
   [[nodiscard]] bool has_value() const noexcept;
 
   [[nodiscard]] virtual ResultPtr mult_by_phase(std::int8_t) const = 0;
@@ -0,0 +1,55 @@
+#include <SeQuant/core/export/cpp.hpp>
+#include <SeQuant/core/space.hpp>
+#include <SeQuant/core/utility/string.hpp>
+
+namespace sequant {
+
+CppGeneratorContext::CppGeneratorContext(DimMap index_dims, ExtentMap extents)
+    : ReorderingContext(MemoryLayout::RowMajor),
+      m_index_dims(std::move(index_dims)),
+      m_extents(std::move(extents)) {}
+
+std::string CppGeneratorContext::get_tag(const IndexSpace &space) const {
+  auto it = m_index_tags.find(space);
+  if (it != m_index_tags.end()) {
+    return it->second;
+  }
+
+  // Default: use first character of base key
+  return toUtf8(space.base_key()).substr(0, 1);
+}
+
+void CppGeneratorContext::set_tag(const IndexSpace &space, std::string tag) {
+  m_index_tags[space] = std::move(tag);
+}
+
+std::string CppGeneratorContext::get_dim(const IndexSpace &space) const {
+  auto it = m_index_dims.find(space);
+  if (it != m_index_dims.end()) {
+    return it->second;
+  }
+
+  // Auto-generate a variable name for the space's dimension
+  return "dim_" + get_tag(space);
+}
+
+void CppGeneratorContext::set_dim(const IndexSpace &space, std::string dim) {
+  m_index_dims[space] = std::move(dim);
+}
+
+std::optional<std::size_t> CppGeneratorContext::get_extent(
+    const IndexSpace &space) const {
+  auto it = m_extents.find(space);
+  if (it == m_extents.end()) {
+    return {};
+  }
+
+  return it->second;
+}
+
+void CppGeneratorContext::set_extent(const IndexSpace &space,
+                                     std::size_t extent) {
+  m_extents[space] = extent;
+}
+
+}  // namespace sequant
@@ -0,0 +1,914 @@
+#ifndef SEQUANT_CORE_EXPORT_CPP_HPP
+#define SEQUANT_CORE_EXPORT_CPP_HPP
+
+#include <SeQuant/core/export/context.hpp>
+#include <SeQuant/core/export/generator.hpp>
+#include <SeQuant/core/export/reordering_context.hpp>
+#include <SeQuant/core/expr.hpp>
+#include <SeQuant/core/index.hpp>
+#include <SeQuant/core/rational.hpp>
+#include <SeQuant/core/space.hpp>
+#include <SeQuant/core/utility/macros.hpp>
+#include <SeQuant/core/utility/string.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <map>
+#include <optional>
+#include <set>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace sequant {
+
+/// Context class for the CppGenerator
+class CppGeneratorContext : public ReorderingContext {
+ public:
+  using TagMap = std::map<IndexSpace, std::string>;
+  using DimMap = std::map<IndexSpace, std::string>;
+  using ExtentMap = std::map<IndexSpace, std::size_t>;
+
+  CppGeneratorContext() : ReorderingContext(MemoryLayout::RowMajor) {}
+  ~CppGeneratorContext() = default;
+  CppGeneratorContext(DimMap index_dims, ExtentMap extents = {});
+
+  /// @returns The tag used to distinguish tensor blocks in variable names
+  std::string get_tag(const IndexSpace &space) const;
+  void set_tag(const IndexSpace &space, std::string tag);
+
+  /// @returns The name of the variable holding the extent of the given space
+  std::string get_dim(const IndexSpace &space) const;
+  void set_dim(const IndexSpace &space, std::string dim);
+
+  /// @returns The extent of the given space, if it is known at generation time.
+  /// Known extents are baked into the generated code as compile-time constants,
+  /// all others are queried from the backend at runtime.
+  std::optional<std::size_t> get_extent(const IndexSpace &space) const;
+  void set_extent(const IndexSpace &space, std::size_t extent);
+
+  /// The type of the tensor elements in the generated code
+  const std::string &scalar_type() const { return m_scalar_type; }
+  void set_scalar_type(std::string type) { m_scalar_type = std::move(type); }
+
+  /// The namespace wrapping all generated code
+  const std::string &namespace_name() const { return m_namespace; }
+  void set_namespace_name(std::string name) { m_namespace = std::move(name); }
+
+  /// Contractions whose extents are all known and whose iteration space does
+  /// not exceed this many elements are generated as explicit loop nests
+  /// instead of being mapped onto GEMM
+  std::size_t loop_threshold() const { return m_loop_threshold; }
+  void set_loop_threshold(std::size_t threshold) {
+    m_loop_threshold = threshold;
+  }
+
+  /// Loops over indices of known extent larger than this are blocked (tiled)
+  /// in generated loop nests. Zero disables blocking.
+  std::size_t block_size() const { return m_block_size; }
+  void set_block_size(std::size_t size) { m_block_size = size; }
+
+ protected:
+  TagMap m_index_tags;
+  DimMap m_index_dims;
+  ExtentMap m_extents;
+  std::string m_scalar_type = "double";
+  std::string m_namespace = "sequant_generated";
+  std::size_t m_loop_threshold = 4096;
+  std::size_t m_block_size = 16;
+};
+
+/// Generator for producing native C++ code that can be compiled into a driver
+/// program. Every named section becomes a function template
+/// @code
+/// template <typename Backend>
+/// void <section name>(Backend &backend);
+/// @endcode
+/// whose tensors are dense std::vector objects laid out according to the
+/// context's memory layout. Every computation is either translated into an
+/// explicit (blocked) loop nest, which is done for small contractions and
+/// for those that can't be expressed as a matrix multiplication, or via TTGT
+/// (transpose - transpose - GEMM - transpose) into a GEMM call.
+///
+/// The backend has to provide the following members:
+/// - `std::size_t extent(std::string_view dim)` (only for index spaces whose
+///   extent is not known at generation time)
+/// - `std::vector<T> load(std::string_view name, std::size_t size)`
+/// - `void persist(std::string_view name, const std::vector<T> &tensor)`
+/// - `T load_scalar(std::string_view name)`
+/// - `void persist_scalar(std::string_view name, T value)`
+/// - `void remove(std::string_view name)`
+/// - `void gemm(bool transa, bool transb, std::size_t M, std::size_t N,
+///   std::size_t K, T alpha, const T *A, const T *B, T *C)`, which computes
+///   C += alpha op(A) op(B) for contiguous row-major matrices, i.e. the
+///   semantics of `cblas_?gemm(CblasRowMajor, ...)` with beta = 1 and leading
+///   dimensions implied by the matrix shapes.
+template <typename Context = CppGeneratorContext>
+class CppGenerator : public Generator<Context> {
+ public:
+  CppGenerator() = default;
+  ~CppGenerator() = default;
+
+  std::string get_format_name() const override { return "C++"; }
+
+  bool supports_named_sections() const override { return true; }
+
+  bool requires_named_sections() const override { return true; }
+
+  bool supports_index_batching() const override { return false; }
+
+  DeclarationScope index_declaration_scope() const override {
+    return DeclarationScope::Section;
+  }
+
+  DeclarationScope variable_declaration_scope() const override {
+    return DeclarationScope::Section;
+  }
+
+  DeclarationScope tensor_declaration_scope() const override {
+    return DeclarationScope::Section;
+  }
+
+  PrunableScalars prunable_scalars() const override {
+    return PrunableScalars::All;
+  }
+
+  std::string represent(const Index &idx, const Context &) const override {
+    if (idx.has_proto_indices()) {
+      throw Exception("Proto Indices are not (yet) supported!");
+    }
+
+    return sanitize_name(toUtf8(idx.full_label()));
+  }
+
+  std::string represent(const Tensor &tensor,
+                        const Context &ctx) const override {
+    std::string name = sanitize_name(toUtf8(tensor.label()));
+
+    if (tensor.num_indices() > 0) {
+      name += "_";
+      for (const Index &idx : tensor.const_indices()) {
+        name += ctx.get_tag(idx.space());
+      }
+    }
+
+    return name;
+  }
+
+  std::string represent(const Variable &variable,
+                        const Context &) const override {
+    return sanitize_name(toUtf8(variable.label()));
+  }
+
+  std::string represent(const Constant &constant,
+                        const Context &) const override {
+    if (constant.value().imag() != 0) {
+      throw Exception("The C++ generator doesn't support complex constants");
+    }
+
+    return format_rational(constant.value().real());
+  }
+
+  std::string represent(const Power &power, const Context &ctx) const override {
+    if (power.conjugated() || (power.base()->is<Variable>() &&
+                               power.base()->as<Variable>().conjugated())) {
+      throw Exception("The C++ generator doesn't support complex conjugation");
+    }
+
+    return "std::pow(" + to_scalar_expr(*power.base(), ctx) + ", " +
+           format_rational(power.exponent()) + ")";
+  }
+
+  void create(const Tensor &tensor, bool zero_init,
+              const Context &ctx) override {
+    if (zero_init) {
+      emit(represent(tensor, ctx) + ".assign(" + size_of(tensor, ctx) +
+           ", 0);");
+    } else {
+      emit(represent(tensor, ctx) + ".resize(" + size_of(tensor, ctx) + ");");
+    }
+  }
+
+  void load(const Tensor &tensor, bool set_to_zero,
+            const Context &ctx) override {
+    if (set_to_zero) {
+      create(tensor, true, ctx);
+    } else {
+      const std::string name = represent(tensor, ctx);
+      emit(name + " = backend.load(\"" + name + "\", " + size_of(tensor, ctx) +
+           ");");
+    }
+  }
+
+  void set_to_zero(const Tensor &tensor, const Context &ctx) override {
+    emit("std::ranges::fill(" + represent(tensor, ctx) + ", 0);");
+  }
+
+  void unload(const Tensor &tensor, const Context &ctx) override {
+    const std::string name = represent(tensor, ctx);
+    emit(name + ".clear();");
+    emit(name + ".shrink_to_fit();");
+  }
+
+  void destroy(const Tensor &tensor, const Context &ctx) override {
+    unload(tensor, ctx);
+    emit("backend.remove(\"" + represent(tensor, ctx) + "\");");
+  }
+
+  void persist(const Tensor &tensor, const Context &ctx) override {
+    const std::string name = represent(tensor, ctx);
+    emit("backend.persist(\"" + name + "\", " + name + ");");
+    unload(tensor, ctx);
+  }
+
+  void create(const Variable &variable, bool zero_init,
+              const Context &ctx) override {
+    if (zero_init) {
+      set_to_zero(variable, ctx);
+    }
+  }
+
+  void load(const Variable &variable, bool set_to_zero,
+            const Context &ctx) override {
+    if (set_to_zero) {
+      this->set_to_zero(variable, ctx);
+    } else {
+      const std::string name = represent(variable, ctx);
+      emit(name + " = backend.load_scalar(\"" + name + "\");");
+    }
+  }
+
+  void set_to_zero(const Variable &variable, const Context &ctx) override {
+    emit(represent(variable, ctx) + " = 0;");
+  }
+
+  void unload(const Variable &, const Context &) override {
+    // Scalars are simply left on the stack
+  }
+
+  void destroy(const Variable &variable, const Context &ctx) override {
+    emit("backend.remove(\"" + represent(variable, ctx) + "\");");
+  }
+
+  void persist(const Variable &variable, const Context &ctx) override {
+    const std::string name = represent(variable, ctx);
+    emit("backend.persist_scalar(\"" + name + "\", " + name + ");");
+  }
+
+  void compute(const Expr &expression, const Tensor &result,
+               const Context &ctx) override {
+    emit_compute(expression, Target{.name = represent(result, ctx),
+                                    .order = storage_order(result, ctx),
+                                    .scalar = false},
+                 ctx);
+  }
+
+  void compute(const Expr &expression, const Variable &result,
+               const Context &ctx) override {
+    emit_compute(expression,
+                 Target{.name = represent(result, ctx), .scalar = true}, ctx);
+  }
+
+  void declare(const Index &idx, const Context &ctx) override {
+    const IndexSpace &space = idx.space();
+    const std::string dim = ctx.get_dim(space);
+    if (!m_declared_dims.insert(dim).second) {
+      return;
+    }
+
+    if (std::optional<std::size_t> extent = ctx.get_extent(space)) {
+      emit("constexpr std::size_t " + dim + " = " + std::to_string(*extent) +
+           ";");
+    } else {
+      emit("const std::size_t " + dim + " = backend.extent(\"" + dim +
+           "\");");
+    }
+  }
+
+  void declare(const Variable &variable, UsageSet,
+               const Context &ctx) override {
+    emit(ctx.scalar_type() + " " + represent(variable, ctx) + " = 0;");
+  }
+
+  void declare(const Tensor &tensor, UsageSet, const Context &ctx) override {
+    emit("std::vector<" + ctx.scalar_type() + "> " + represent(tensor, ctx) +
+         ";");
+  }
+
+  void all_indices_declared(std::size_t amount, const Context &) override {
+    if (amount > 0) {
+      m_generated += "\n";
+    }
+  }
+
+  void all_variables_declared(std::size_t amount, const Context &) override {
+    if (amount > 0) {
+      m_generated += "\n";
+    }
+  }
+
+  void all_tensors_declared(std::size_t amount, const Context &) override {
+    if (amount > 0) {
+      m_generated += "\n";
+    }
+  }
+
+  void begin_declarations(DeclarationScope, const Context &) override {}
+
+  void end_declarations(DeclarationScope, const Context &) override {}
+
+  void insert_comment(const std::string &comment, const Context &) override {
+    emit("// " + comment);
+  }
+
+  void begin_named_section(std::string_view name, const Context &) override {
+    m_generated += "template <typename Backend>\n";
+    m_generated += "void " + sanitize_name(std::string(name)) +
+                   "([[maybe_unused]] Backend &backend) {\n";
+    m_indent += "  ";
+    m_declared_dims.clear();
+  }
+
+  void end_named_section(std::string_view, const Context &) override {
+    SEQUANT_ASSERT(m_indent.size() >= 2);
+    m_indent.resize(m_indent.size() - 2);
+    while (m_generated.ends_with("\n\n")) {
+      m_generated.pop_back();
+    }
+    m_generated += "}\n\n";
+  }
+
+  void begin_expression(const Context &) override {
+    if (!m_generated.empty() && !m_generated.ends_with("\n\n") &&
+        !m_generated.ends_with("{\n")) {
+      m_generated += "\n";
+    }
+  }
+
+  void end_expression(const Context &) override {}
+
+  void begin_export(const Context &ctx) override {
+    m_generated = "// Generated by SeQuant\n";
+    m_generated += "\n";
+    m_generated += "#include <algorithm>\n";
+    m_generated += "#include <array>\n";
+    m_generated += "#include <cmath>\n";
+    m_generated += "#include <cstddef>\n";
+    m_generated += "#include <vector>\n";
+    m_generated += "\n";
+    m_generated += "namespace " + ctx.namespace_name() + " {\n";
+    m_generated += "\n";
+    m_generated += permute_kernel();
+    m_generated += "\n";
+  }
+
+  void end_export(const Context &ctx) override {
+    while (m_generated.ends_with("\n\n")) {
+      m_generated.pop_back();
+    }
+    m_generated += "\n}  // namespace " + ctx.namespace_name() + "\n";
+  }
+
+  std::string get_generated_code() const override { return m_generated; }
+
+ protected:
+  /// The object a computation is written into
+  struct Target {
+    std::string name;
+    /// Indices in storage order (slowest-varying first)
+    std::vector<Index> order = {};
+    bool scalar = false;
+  };
+
+  /// A tensor operand of a computation
+  struct Operand {
+    std::string name;
+    /// Indices in storage order (slowest-varying first)
+    std::vector<Index> order;
+  };
+
+  std::string m_generated;
+  std::string m_indent;
+  std::set<std::string> m_declared_dims;
+
+  void emit(const std::string &line) {
+    m_generated += m_indent + line + "\n";
+  }
+
+  /// Sanitize a label to be a valid C++ identifier
+  static std::string sanitize_name(std::string name) {
+    for (char &c : name) {
+      unsigned char uc = static_cast<unsigned char>(c);
+      // Non-ASCII bytes are kept as part of (valid) UTF-8 identifiers
+      if (uc < 128 && !std::isalnum(uc) && c != '_') {
+        c = '_';
+      }
+    }
+
+    if (name.empty() || std::isdigit(static_cast<unsigned char>(name[0]))) {
+      name = "_" + name;
+    }
+
+    return name;
+  }
+
+  /// @returns The given rational as a floating-point literal expression
+  static std::string format_rational(const rational &number) {
+    std::stringstream sstream;
+    if (denominator(number) == 1) {
+      sstream << numerator(number) << ".0";
+    } else {
+      sstream << "(" << numerator(number) << ".0 / " << denominator(number)
+              << ".0)";
+    }
+
+    return sstream.str();
+  }
+
+  /// @returns The indices of the given tensor, ordered from the slowest- to
+  /// the fastest-varying one in memory
+  std::vector<Index> storage_order(const Tensor &tensor,
+                                   const Context &ctx) const {
+    std::vector<Index> order;
+    for (const Index &idx : tensor.const_indices()) {
+      order.push_back(idx);
+    }
+    if (ctx.memory_layout() == MemoryLayout::ColumnMajor) {
+      std::ranges::reverse(order);
+    }
+
+    return order;
+  }
+
+  std::string size_of(const std::vector<Index> &indices,
+                      const Context &ctx) const {
+    if (indices.empty()) {
+      return "1";
+    }
+
+    std::string size;
+    for (const Index &idx : indices) {
+      if (!size.empty()) {
+        size += " * ";
+      }
+      size += ctx.get_dim(idx.space());
+    }
+
+    return size;
+  }
+
+  std::string size_of(const Tensor &tensor, const Context &ctx) const {
+    return size_of(storage_order(tensor, ctx), ctx);
+  }
+
+  /// @returns The expression for the offset of the element addressed by the
+  /// loop variables of the given indices
+  std::string offset_of(const std::vector<Index> &order,
+                        const Context &ctx) const {
+    if (order.empty()) {
+      return "0";
+    }
+
+    std::string offset = represent(order.front(), ctx);
+    for (std::size_t i = 1; i < order.size(); ++i) {
+      if (i > 1) {
+        offset = "(" + offset + ")";
+      }
+      offset += " * " + ctx.get_dim(order[i].space()) + " + " +
+                represent(order[i], ctx);
+    }
+
+    return offset;
+  }
+
+  std::string to_scalar_expr(const Expr &expr, const Context &ctx) const {
+    if (expr.is<Variable>()) {
+      if (expr.as<Variable>().conjugated()) {
+        throw Exception(
+            "The C++ generator doesn't support complex conjugation");
+      }
+      return represent(expr.as<Variable>(), ctx);
+    } else if (expr.is<Constant>()) {
+      return represent(expr.as<Constant>(), ctx);
+    } else if (expr.is<Power>()) {
+      return represent(expr.as<Power>(), ctx);
+    } else if (expr.is<Product>()) {
+      const Product &product = expr.as<Product>();
+      std::string repr = represent(Constant(product.scalar()), ctx);
+      for (const ExprPtr &factor : product.factors()) {
+        repr += " * " + to_scalar_expr(*factor, ctx);
+      }
+      return repr;
+    } else if (expr.is<Sum>()) {
+      const Sum &sum = expr.as<Sum>();
+      std::string repr = "(";
+      for (std::size_t i = 0; i < sum.size(); ++i) {
+        if (i > 0) {
+          repr += " + ";
+        }
+        repr += to_scalar_expr(*sum.summand(i), ctx);
+      }
+      return repr + ")";
+    }
+
+    throw Exception("Unsupported expression type in scalar C++ expression: " +
+                    expr.type_name());
+  }
+
+  /// Splits the given expression into a scalar prefactor and tensor operands
+  void collect_factors(const Expr &expr, std::vector<std::string> &scalars,
+                       std::vector<Operand> &operands,
+                       const Context &ctx) const {
+    if (expr.is<Tensor>()) {
+      const Tensor &tensor = expr.as<Tensor>();
+      operands.push_back(
+          Operand{represent(tensor, ctx), storage_order(tensor, ctx)});
+    } else if (expr.is<Product>()) {
+      const Product &product = expr.as<Product>();
+      if (!product.scalar().is_identity()) {
+        scalars.push_back(represent(Constant(product.scalar()), ctx));
+      }
+      for (const ExprPtr &factor : product.factors()) {
+        collect_factors(*factor, scalars, operands, ctx);
+      }
+    } else if (expr.is<Sum>()) {
+      if (!expr.is_scalar()) {
+        throw Exception(
+            "Sums of tensors have to be split into individual computations");
+      }
+      scalars.push_back(to_scalar_expr(expr, ctx));
+    } else {
+      scalars.push_back(to_scalar_expr(expr, ctx));
+    }
+  }
+
+  void emit_compute(const Expr &expression, const Target &target,
+                    const Context &ctx) {
+    std::vector<std::string> scalars;
+    std::vector<Operand> operands;
+    collect_factors(expression, scalars, operands, ctx);
+
+    std::string alpha;
+    for (const std::string &scalar : scalars) {
+      alpha += (alpha.empty() ? "" : " * ") + scalar;
+    }
+    if (alpha.empty()) {
+      alpha = "1";
+    }
+
+    if (operands.empty()) {
+      if (!target.scalar) {
+        throw Exception("Can't add a scalar to a tensor in C++ export");
+      }
+      emit(target.name + " += " + alpha + ";");
+      return;
+    }
+
+    if (operands.size() > 2) {
+      throw Exception("The C++ generator expects binary contractions");
+    }
+
+    if (is_small(target, operands, ctx) ||
+        !(operands.size() == 1 ? emit_permutation(alpha, target, operands, ctx)
+                               : emit_ttgt(alpha, target, operands, ctx))) {
+      emit_loop_nest(alpha, target, operands, ctx);
+    }
+  }
+
+  /// @returns The distinct indices involved in a computation
+  static std::vector<Index> all_indices(const Target &target,
+                                        const std::vector<Operand> &operands) {
+    std::vector<Index> indices;
+    auto add = [&](const std::vector<Index> &order) {
+      for (const Index &idx : order) {
+        if (std::ranges::find(indices, idx) == indices.end()) {
+          indices.push_back(idx);
+        }
+      }
+    };
+
+    add(target.order);
+    for (const Operand &operand : operands) {
+      add(operand.order);
+    }
+
+    return indices;
+  }
+
+  /// @returns Whether the computation's extents are all known and its
+  /// iteration space is below the threshold for using loop nests
+  bool is_small(const Target &target, const std::vector<Operand> &operands,
+                const Context &ctx) const {
+    std::size_t volume = 1;
+    for (const Index &idx : all_indices(target, operands)) {
+      std::optional<std::size_t> extent = ctx.get_extent(idx.space());
+      if (!extent.has_value()) {
+        return false;
+      }
+      volume *= *extent;
+      if (volume > ctx.loop_threshold()) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  /// Emits the computation as a loop nest over all involved indices. Loops are
+  /// ordered such that indices that are fast-varying in memory are iterated
+  /// over in the innermost loops, and loops over large extents are blocked.
+  void emit_loop_nest(const std::string &alpha, const Target &target,
+                      const std::vector<Operand> &operands,
+                      const Context &ctx) {
+    std::vector<Index> indices = all_indices(target, operands);
+
+    // Distance of an index from the fastest-varying slot, summed over all
+    // objects containing it
+    auto weight = [&](const Index &idx) {
+      std::size_t sum = 0;
+      auto add = [&](const std::vector<Index> &order) {
+        auto it = std::ranges::find(order, idx);
+        if (it != order.end()) {
+          sum += std::distance(it, order.end()) - 1;
+        }
+      };
+      add(target.order);
+      for (const Operand &operand : operands) {
+        add(operand.order);
+      }
+      return sum;
+    };
+    std::ranges::stable_sort(indices, [&](const Index &lhs, const Index &rhs) {
+      return weight(lhs) > weight(rhs);
+    });
+
+    std::vector<Index> blocked;
+    for (const Index &idx : indices) {
+      std::optional<std::size_t> extent = ctx.get_extent(idx.space());
+      if (ctx.block_size() > 0 && extent.has_value() &&
+          *extent > ctx.block_size()) {
+        blocked.push_back(idx);
+      }
+    }
+
+    const std::string block = std::to_string(ctx.block_size());
+    std::size_t depth = 0;
+    auto open = [&](const std::string &header) {
+      emit("for (" + header + ") {");
+      m_indent += "  ";
+      ++depth;
+    };
+
+    for (const Index &idx : blocked) {
+      const std::string var = represent(idx, ctx) + "_block";
+      const std::string dim = ctx.get_dim(idx.space());
+      open("std::size_t " + var + " = 0; " + var + " < " + dim + "; " + var +
+           " += " + block);
+    }
+
+    for (const Index &idx : indices) {
+      const std::string var = represent(idx, ctx);
+      const std::string dim = ctx.get_dim(idx.space());
+      if (std::ranges::find(blocked, idx) != blocked.end()) {
+        open("std::size_t " + var + " = " + var + "_block; " + var +
+             " < std::min<std::size_t>(" + var + "_block + " + block + ", " +
+             dim + "); ++" + var);
+      } else {
+        open("std::size_t " + var + " = 0; " + var + " < " + dim + "; ++" +
+             var);
+      }
+    }
+
+    std::string term = alpha == "1" ? "" : alpha;
+    for (const Operand &operand : operands) {
+      term += (term.empty() ? "" : " * ") + operand.name + "[" +
+              offset_of(operand.order, ctx) + "]";
+    }
+
+    emit((target.scalar ? target.name
+                        : target.name + "[" + offset_of(target.order, ctx) +
+                              "]") +
+         " += " + term + ";");
+
+    for (; depth > 0; --depth) {
+      m_indent.resize(m_indent.size() - 2);
+      emit("}");
+    }
+  }
+
+  /// @returns The positions of the indices in @p to within @p from, i.e. the
+  /// permutation of @p from that yields @p to
+  static std::vector<std::size_t> permutation(const std::vector<Index> &from,
+                                              const std::vector<Index> &to) {
+    std::vector<std::size_t> perm;
+    for (const Index &idx : to) {
+      perm.push_back(std::distance(from.begin(), std::ranges::find(from, idx)));
+    }
+
+    return perm;
+  }
+
+  /// @returns A call of the permute kernel writing (or adding) the elements of
+  /// @p src, with indices in @p from order, into @p dst in @p to order
+  std::string permute_call(const std::string &alpha, const std::string &src,
+                           const std::vector<Index> &from,
+                           const std::vector<Index> &to,
+                           const std::string &dst, bool accumulate,
+                           const Context &ctx) const {
+    std::string extents;
+    for (const Index &idx : from) {
+      extents += (extents.empty() ? "" : ", ") + ctx.get_dim(idx.space());
+    }
+    std::string perm;
+    for (std::size_t pos : permutation(from, to)) {
+      perm += (perm.empty() ? "" : ", ") + std::to_string(pos);
+    }
+
+    return "permute<" + ctx.scalar_type() + ", " + std::to_string(from.size()) +
+           ">(" + alpha + ", " + src + ", {" + extents + "}, {" + perm + "}, " +
+           dst + ", " + (accumulate ? "true" : "false") + ");";
+  }
+
+  static bool is_permutation_of(const std::vector<Index> &lhs,
+                                const std::vector<Index> &rhs) {
+    return lhs.size() == rhs.size() &&
+           std::ranges::all_of(lhs, [&](const Index &idx) {
+             return std::ranges::count(lhs, idx) == 1 &&
+                    std::ranges::count(rhs, idx) == 1;
+           });
+  }
+
+  /// Emits the addition of a (scaled) permutation of a single tensor
+  /// @returns Whether this was possible
+  bool emit_permutation(const std::string &alpha, const Target &target,
+                        const std::vector<Operand> &operands,
+                        const Context &ctx) {
+    SEQUANT_ASSERT(operands.size() == 1);
+    const Operand &operand = operands.front();
+    if (target.scalar || !is_permutation_of(operand.order, target.order)) {
+      return false;
+    }
+
+    emit(permute_call(alpha, operand.name + ".data()", operand.order,
+                      target.order, target.name + ".data()", true, ctx));
+
+    return true;
+  }
+
+  /// Emits the contraction of two tensors as a GEMM call, transposing
+  /// operands (and the result) as needed
+  /// @returns Whether the contraction could be expressed as a GEMM
+  bool emit_ttgt(const std::string &alpha, const Target &target,
+                 const std::vector<Operand> &operands, const Context &ctx) {
+    SEQUANT_ASSERT(operands.size() == 2);
+    using Indices = std::vector<Index>;
+    auto contains = [](const Indices &indices, const Index &idx) {
+      return std::ranges::find(indices, idx) != indices.end();
+    };
+    auto select = [&](const Indices &from, const Indices &other) {
+      Indices selected;
+      for (const Index &idx : from) {
+        if (contains(other, idx)) {
+          selected.push_back(idx);
+        }
+      }
+      return selected;
+    };
+    auto concat = [](Indices first, const Indices &second) {
+      first.insert(first.end(), second.begin(), second.end());
+      return first;
+    };
+    auto unique = [](const Indices &indices) {
+      return std::ranges::all_of(indices, [&](const Index &idx) {
+        return std::ranges::count(indices, idx) == 1;
+      });
+    };
+
+    const Operand *lhs = &operands[0];
+    const Operand *rhs = &operands[1];
+    const Indices &c = target.order;
+    if (!unique(lhs->order) || !unique(rhs->order) || !unique(c)) {
+      return false;
+    }
+
+    // Every index has to appear in exactly two of the three objects (no
+    // Hadamard products or traces)
+    for (const Index &idx : all_indices(target, operands)) {
+      const int count = contains(lhs->order, idx) + contains(rhs->order, idx) +
+                        contains(c, idx);
+      if (count != 2) {
+        return false;
+      }
+    }
+
+    // Orient the operands such that the result is (M x N) with row indices
+    // from lhs and column indices from rhs
+    if (c != concat(select(c, lhs->order), select(c, rhs->order)) &&
+        c == concat(select(c, rhs->order), select(c, lhs->order))) {
+      std::swap(lhs, rhs);
+    }
+    const Indices m = select(c, lhs->order);
+    const Indices n = select(c, rhs->order);
+    const Indices &a = lhs->order;
+    const Indices &b = rhs->order;
+
+    // Prefer an order of the contracted indices that spares transposing
+    const Indices ka = select(a, b);
+    const Indices kb = select(b, a);
+    Indices k = ka;
+    if (a != concat(m, ka) && a != concat(ka, m) &&
+        (b == concat(kb, n) || b == concat(n, kb))) {
+      k = kb;
+    }
+
+    emit("{");
+    m_indent += "  ";
+
+    std::string a_ptr = lhs->name + ".data()";
+    const bool transa = a != concat(m, k) && a == concat(k, m);
+    if (a != concat(m, k) && !transa) {
+      const std::string tmp = lhs->name + "_a";
+      emit("std::vector<" + ctx.scalar_type() + "> " + tmp + "(" +
+           size_of(a, ctx) + ");");
+      emit(permute_call("1", a_ptr, a, concat(m, k), tmp + ".data()", false,
+                        ctx));
+      a_ptr = tmp + ".data()";
+    }
+
+    std::string b_ptr = rhs->name + ".data()";
+    const bool transb = b != concat(k, n) && b == concat(n, k);
+    if (b != concat(k, n) && !transb) {
+      const std::string tmp = rhs->name + "_b";
+      emit("std::vector<" + ctx.scalar_type() + "> " + tmp + "(" +
+           size_of(b, ctx) + ");");
+      emit(permute_call("1", b_ptr, b, concat(k, n), tmp + ".data()", false,
+                        ctx));
+      b_ptr = tmp + ".data()";
+    }
+
+    std::string c_ptr =
+        target.scalar ? "&" + target.name : target.name + ".data()";
+    const bool permute_result = !target.scalar && c != concat(m, n);
+    if (permute_result) {
+      const std::string tmp = target.name + "_c";
+      emit("std::vector<" + ctx.scalar_type() + "> " + tmp + "(" +
+           size_of(c, ctx) + ", 0);");
+      c_ptr = tmp + ".data()";
+    }
+
+    emit(std::string("backend.gemm(") + (transa ? "true" : "false") + ", " +
+         (transb ? "true" : "false") + ", " + size_of(m, ctx) + ", " +
+         size_of(n, ctx) + ", " + size_of(k, ctx) + ", " + alpha + ", " +
+         a_ptr + ", " + b_ptr + ", " + c_ptr + ");");
+
+    if (permute_result) {
+      emit(permute_call("1", c_ptr, concat(m, n), c, target.name + ".data()",
+                        true, ctx));
+    }
+
+    m_indent.resize(m_indent.size() - 2);
+    emit("}");
+
+    return true;
+  }
+
+  /// @returns The definition of the kernel used for permuting tensors
+  static std::string permute_kernel() {
+    return "/// dst[j] (+)= alpha * src[i] for all row-major multi-indices j "
+           "of dst,\n"
+           "/// where i[perm[k]] = j[k]\n"
+           "template <typename T, std::size_t N>\n"
+           "void permute(T alpha, const T *src,\n"
+           "             const std::array<std::size_t, N> &extents,\n"
+           "             const std::array<std::size_t, N> &perm, T *dst,\n"
+           "             bool accumulate) {\n"
+           "  std::array<std::size_t, N> strides{};\n"
+           "  std::size_t size = 1;\n"
+           "  for (std::size_t k = N; k-- > 0;) {\n"
+           "    strides[k] = size;\n"
+           "    size *= extents[k];\n"
+           "  }\n"
+           "\n"
+           "  std::array<std::size_t, N> idx{};\n"
+           "  for (std::size_t j = 0; j < size; ++j) {\n"
+           "    std::size_t offset = 0;\n"
+           "    for (std::size_t k = 0; k < N; ++k) {\n"
+           "      offset += idx[k] * strides[perm[k]];\n"
+           "    }\n"
+           "    dst[j] = accumulate ? dst[j] + alpha * src[offset]\n"
+           "                        : alpha * src[offset];\n"
+           "    for (std::size_t k = N; k-- > 0;) {\n"
+           "      if (++idx[k] < extents[perm[k]]) break;\n"
+           "      idx[k] = 0;\n"
+           "    }\n"
+           "  }\n"
+           "}\n";
+  }
+};
+
+}  // namespace sequant
+
+#endif  // SEQUANT_CORE_EXPORT_CPP_HPP
@@ -9,12 +9,18 @@
 
 #include <pv/polymorphic_variant.hpp>
 
+#include <range/v3/algorithm/contains.hpp>
 #include <range/v3/algorithm/find.hpp>
 
 #include <algorithm>
+#include <map>
+#include <numeric>
+#include <optional>
 #include <stack>
+#include <string>
 #include <utility>
 #include <variant>
+#include <vector>
 
 namespace sequant {
 
@@ -59,6 +65,13 @@ class GenerationOptimizer final : public Generator<MainContext> {
 
     virtual OperationType type() const = 0;
 
+    /// @returns The object this operation acts on (for computations: the
+    /// result)
+    const Object &object() const { return m_object; }
+
+    /// @returns The expression evaluated by this operation, if any
+    virtual const Expr *expression() const { return nullptr; }
+
     /// @returns Whether this operation cancels the provided operation. That is,
     /// executing them both in sequence will result in a no-op
     bool cancels(const AbstractOperation &other,
@@ -337,6 +350,8 @@ class GenerationOptimizer final : public Generator<MainContext> {
 
     OperationType type() const override { return OperationType::Compute; }
 
+    const Expr *expression() const override { return m_expr.get(); }
+
    private:
     ExprPtr m_expr;
   };
@@ -448,11 +463,33 @@ class GenerationOptimizer final : public Generator<MainContext> {
   }
 
   void begin_expression(const MainContext &ctx) override {
-    m_cmp.set_indices(ctx.batch_indices(ctx.current_expression_id()));
+    m_batch_indices = ctx.batch_indices(ctx.current_expression_id());
+    m_cmp.set_indices(m_batch_indices);
 
     m_generator.begin_expression(ctx);
   }
 
+  /// @returns Whether operations are rescheduled in order to reduce the peak
+  /// memory of the generated code (enabled by default)
+  /// @see enable_memory_scheduling
+  bool memory_scheduling_enabled() const { return m_schedule_memory; }
+
+  /// Enables or disables the rescheduling of operations that reduces the peak
+  /// memory of the generated code. The rescheduling works on one expression
+  /// at a time; if disabled, the operations are emitted in the order in which
+  /// they were received (after load/unload elision).
+  void enable_memory_scheduling(bool enable) { m_schedule_memory = enable; }
+
+  /// @returns The predicted peak memory of the generated code per named
+  /// section (code outside of named sections is listed under an empty name).
+  /// Memory is measured as the approximate number of elements of all objects
+  /// that are resident at the same time, where a tensor's size is estimated
+  /// from the approximate sizes of its (non-batched) index spaces and a
+  /// variable counts as a single element.
+  const container::map<std::string, double> &predicted_peak_memory() const {
+    return m_peak_memory;
+  }
+
   /////////////////////////////////////////////////////////
   /////////// Pass-through implementations ////////////////
   /////////////////////////////////////////////////////////
@@ -491,6 +528,9 @@ class GenerationOptimizer final : public Generator<MainContext> {
   container::svector<Operation> m_cache;
   container::svector<std::pair<std::size_t, std::size_t>> m_paired;
   IndexSpecificTensorBlockEqualComparator m_cmp;
+  std::vector<Index> m_batch_indices;
+  container::map<std::string, double> m_peak_memory;
+  bool m_schedule_memory = true;
 
   template <typename Iterator>
   static Iterator find_unpaired_allocation(
@@ -527,20 +567,25 @@ class GenerationOptimizer final : public Generator<MainContext> {
     return end;
   }
 
-  void process_operation_queue(const MainContext &) {
+  /// Erases all pairs of subsequent operations that cancel each other
+  void erase_cancelling_neighbors(container::svector<Operation> &operations) {
     // If two subsequent elements cancel each other, they can be erased without
     // having to worry about potentially violating the stack-like ordering of
     // memory operations (it will be preserved).
-    for (std::size_t i = 0; i < m_queue.size() - 1; ++i) {
-      if (m_queue[i]->cancels(m_queue.at(i + 1), m_cmp)) {
-        m_queue.erase(m_queue.begin() + i + 1);
-        m_queue.erase(m_queue.begin() + i);
+    for (std::size_t i = 0; i + 1 < operations.size(); ++i) {
+      if (operations[i]->cancels(operations.at(i + 1), m_cmp)) {
+        operations.erase(operations.begin() + i + 1);
+        operations.erase(operations.begin() + i);
         // Re-visit the previous value of i in the next iteration
         // (keep in mind that i gets incremented at the end of the loop)
         static_assert(static_cast<decltype(i)>(-1) + 1 == 0);
         i = std::max(i - 2, static_cast<decltype(i)>(-1));
       }
     }
+  }
+
+  void process_operation_queue(const MainContext &) {
+    erase_cancelling_neighbors(m_queue);
 
     // If, within the given block, we have two operations that cancel each other
     // but which do not appear in subsequent order, we **might** be able to
@@ -678,6 +723,352 @@ class GenerationOptimizer final : public Generator<MainContext> {
     }
   }
 
+  bool same_object(const Object &lhs, const Object &rhs) const {
+    if (lhs.index() != rhs.index()) {
+      return false;
+    }
+
+    if (std::holds_alternative<Tensor>(lhs)) {
+      return m_cmp(std::get<Tensor>(lhs), std::get<Tensor>(rhs));
+    }
+
+    return std::get<Variable>(lhs) == std::get<Variable>(rhs);
+  }
+
+  /// @returns The approximate number of elements held by the given object
+  double object_size(const Object &object) const {
+    if (!std::holds_alternative<Tensor>(object)) {
+      return 1;
+    }
+
+    double size = 1;
+    for (const Index &idx : std::get<Tensor>(object).indices()) {
+      if (ranges::find(m_batch_indices, idx) != m_batch_indices.end()) {
+        // Only a single slice along batched indices is resident at a time
+        continue;
+      }
+
+      size *= idx.space().approximate_size();
+    }
+
+    return size;
+  }
+
+  /// @returns The peak memory held by the objects allocated in the given
+  /// sequence of operations
+  double peak_memory(const container::svector<Operation> &operations) const {
+    double current = 0;
+    double peak = 0;
+
+    for (const Operation &op : operations) {
+      switch (op->memory_action()) {
+        case MemoryAction::Allocate:
+          current += object_size(op->object());
+          peak = std::max(peak, current);
+          break;
+        case MemoryAction::Deallocate:
+          current -= object_size(op->object());
+          break;
+        case MemoryAction::None:
+          break;
+      }
+    }
+
+    return peak;
+  }
+
+  /// Reschedules the cached operations in order to reduce the peak memory of
+  /// the generated code. Based on a liveness analysis of all objects,
+  /// computations (and zeroing) are reordered within the constraints of their
+  /// data dependencies and every allocation (deallocation) is moved right
+  /// before (after) the first (last) operation using the respective object.
+  /// Lifetimes that would otherwise overlap without being nested are extended
+  /// such that the stack-like ordering of memory operations is retained. The
+  /// new schedule is only adopted if it lowers the predicted peak memory.
+  /// @returns The predicted peak memory of the (possibly rescheduled) cache
+  double schedule_operation_cache() {
+    const double initial_peak = peak_memory(m_cache);
+
+    // Objects are referred to by their position in this list
+    container::svector<Object> objects;
+    auto object_id = [&](const Object &obj) -> std::size_t {
+      auto it = std::ranges::find_if(objects, [&](const Object &other) {
+        return same_object(obj, other);
+      });
+      if (it != objects.end()) {
+        return std::distance(objects.begin(), it);
+      }
+
+      objects.push_back(obj);
+      return objects.size() - 1;
+    };
+
+    // A matching pair of allocation and deallocation of an object
+    struct Instance {
+      std::size_t object;
+      std::size_t allocation;
+      std::size_t deallocation = 0;
+      double size = 0;
+      // Steps using this instance
+      container::svector<std::size_t> uses = {};
+      // Positions of the first and last use in the new schedule
+      std::size_t begin = 0;
+      std::size_t end = 0;
+    };
+
+    // A non-memory operation
+    struct Step {
+      std::size_t operation;
+      std::size_t written;
+      container::svector<std::size_t> read = {};
+      container::svector<std::size_t> instances = {};
+
+      bool touches(std::size_t object) const {
+        return written == object || ranges::contains(read, object);
+      }
+    };
+
+    container::svector<Instance> instances;
+    container::svector<Step> steps;
+    // Maps objects onto their currently allocated instance
+    std::map<std::size_t, std::size_t> live;
+
+    for (std::size_t i = 0; i < m_cache.size(); ++i) {
+      const Operation &op = m_cache.at(i);
+      const std::size_t obj = object_id(op->object());
+
+      switch (op->memory_action()) {
+        case MemoryAction::Allocate:
+          if (live.contains(obj)) {
+            return initial_peak;
+          }
+          live.emplace(obj, instances.size());
+          instances.push_back(Instance{.object = obj,
+                                       .allocation = i,
+                                       .size = object_size(op->object())});
+          break;
+        case MemoryAction::Deallocate: {
+          auto it = live.find(obj);
+          if (it == live.end()) {
+            return initial_peak;
+          }
+          instances.at(it->second).deallocation = i;
+          live.erase(it);
+          break;
+        }
+        case MemoryAction::None: {
+          Step step{.operation = i, .written = obj};
+          if (const Expr *expr = op->expression()) {
+            expr->visit(
+                [&](const ExprPtr &leaf) {
+                  if (leaf.is<Tensor>()) {
+                    step.read.push_back(object_id(leaf.as<Tensor>()));
+                  } else if (leaf.is<Variable>()) {
+                    step.read.push_back(object_id(leaf.as<Variable>()));
+                  }
+                },
+                true);
+          }
+
+          for (const auto &[used, instance] : live) {
+            if (step.touches(used)) {
+              step.instances.push_back(instance);
+              instances.at(instance).uses.push_back(steps.size());
+            }
+          }
+
+          steps.push_back(std::move(step));
+          break;
+        }
+      }
+    }
+
+    if (!live.empty() || steps.size() < 2 ||
+        std::ranges::any_of(instances, [](const Instance &instance) {
+          return instance.uses.empty();
+        })) {
+      return initial_peak;
+    }
+
+    // Reads commute with each other, anything else involving the same object
+    // has to retain its order. The same goes for steps using different
+    // instances of the same object.
+    auto conflicting = [&](const Step &lhs, const Step &rhs) {
+      if (lhs.touches(rhs.written) || rhs.touches(lhs.written)) {
+        return true;
+      }
+
+      for (std::size_t first : lhs.instances) {
+        for (std::size_t second : rhs.instances) {
+          if (first != second &&
+              instances.at(first).object == instances.at(second).object) {
+            return true;
+          }
+        }
+      }
+
+      return false;
+    };
+
+    std::vector<container::svector<std::size_t>> predecessors(steps.size());
+    for (std::size_t j = 0; j < steps.size(); ++j) {
+      for (std::size_t i = 0; i < j; ++i) {
+        if (conflicting(steps.at(i), steps.at(j))) {
+          predecessors.at(j).push_back(i);
+        }
+      }
+    }
+
+    // List scheduling that greedily picks the step increasing the resident
+    // memory the least (or decreasing it the most)
+    std::vector<std::size_t> greedy_order;
+    {
+      std::vector<bool> scheduled(steps.size(), false);
+      std::vector<bool> started(instances.size(), false);
+      std::vector<std::size_t> remaining_uses;
+      for (const Instance &instance : instances) {
+        remaining_uses.push_back(instance.uses.size());
+      }
+
+      while (greedy_order.size() < steps.size()) {
+        std::optional<std::size_t> best;
+        double best_delta = 0;
+
+        for (std::size_t s = 0; s < steps.size(); ++s) {
+          if (scheduled.at(s) ||
+              !std::ranges::all_of(predecessors.at(s), [&](std::size_t pred) {
+                return scheduled.at(pred);
+              })) {
+            continue;
+          }
+
+          double delta = 0;
+          for (std::size_t inst : steps.at(s).instances) {
+            if (!started.at(inst)) {
+              delta += instances.at(inst).size;
+            }
+            if (remaining_uses.at(inst) == 1) {
+              delta -= instances.at(inst).size;
+            }
+          }
+
+          if (!best.has_value() || delta < best_delta) {
+            best = s;
+            best_delta = delta;
+          }
+        }
+
+        SEQUANT_ASSERT(best.has_value());
+        scheduled.at(*best) = true;
+        for (std::size_t inst : steps.at(*best).instances) {
+          started.at(inst) = true;
+          remaining_uses.at(inst)--;
+        }
+        greedy_order.push_back(*best);
+      }
+    }
+
+    // Generates the operations for the given order of steps with allocations
+    // and deallocations as close to the respective uses as the stack-like
+    // ordering of memory operations permits
+    using Schedule = std::pair<container::svector<Operation>, double>;
+    auto emit = [&](const std::vector<std::size_t> &order)
+        -> std::optional<Schedule> {
+      std::vector<std::size_t> position(order.size());
+      for (std::size_t p = 0; p < order.size(); ++p) {
+        position.at(order.at(p)) = p;
+      }
+
+      std::vector<std::size_t> sorted;
+      for (std::size_t i = 0; i < instances.size(); ++i) {
+        Instance &instance = instances.at(i);
+        instance.begin = position.at(instance.uses.front());
+        instance.end = instance.begin;
+        for (std::size_t step : instance.uses) {
+          instance.begin = std::min(instance.begin, position.at(step));
+          instance.end = std::max(instance.end, position.at(step));
+        }
+        sorted.push_back(i);
+      }
+      std::ranges::sort(sorted, [&](std::size_t lhs, std::size_t rhs) {
+        const Instance &first = instances.at(lhs);
+        const Instance &second = instances.at(rhs);
+        if (first.begin != second.begin) {
+          return first.begin < second.begin;
+        }
+        if (first.end != second.end) {
+          return first.end > second.end;
+        }
+        return first.allocation < second.allocation;
+      });
+
+      Schedule schedule;
+      auto &[operations, peak] = schedule;
+      peak = 0;
+      double current = 0;
+      std::vector<std::size_t> stack;
+      auto next = sorted.begin();
+
+      for (std::size_t p = 0; p < order.size(); ++p) {
+        for (; next != sorted.end() && instances.at(*next).begin == p;
+             ++next) {
+          const Instance &instance = instances.at(*next);
+          for (auto it = stack.rbegin(); it != stack.rend(); ++it) {
+            Instance &enclosing = instances.at(*it);
+            if (enclosing.object == instance.object) {
+              // The same object can't be allocated twice at the same time
+              return std::nullopt;
+            }
+            // Extend lifetimes to retain a stack-like ordering
+            enclosing.end = std::max(enclosing.end, instance.end);
+          }
+
+          stack.push_back(*next);
+          operations.push_back(m_cache.at(instance.allocation));
+          current += instance.size;
+          peak = std::max(peak, current);
+        }
+
+        operations.push_back(m_cache.at(steps.at(order.at(p)).operation));
+
+        while (!stack.empty() && instances.at(stack.back()).end == p) {
+          const Instance &instance = instances.at(stack.back());
+          operations.push_back(m_cache.at(instance.deallocation));
+          current -= instance.size;
+          stack.pop_back();
+        }
+      }
+
+      SEQUANT_ASSERT(stack.empty());
+      SEQUANT_ASSERT(operations.size() == m_cache.size());
+
+      return schedule;
+    };
+
+    std::vector<std::size_t> original_order(steps.size());
+    std::iota(original_order.begin(), original_order.end(), 0);
+
+    std::optional<Schedule> best;
+    for (const auto &order : {original_order, greedy_order}) {
+      std::optional<Schedule> candidate = emit(order);
+      if (candidate.has_value() &&
+          candidate->second < (best ? best->second : initial_peak)) {
+        best = std::move(candidate);
+      }
+    }
+
+    if (!best.has_value()) {
+      return initial_peak;
+    }
+
+    m_cache = std::move(best->first);
+    // Deallocations directly followed by a re-allocation of the same object
+    // can be elided without affecting the peak memory
+    erase_cancelling_neighbors(m_cache);
+
+    return best->second;
+  }
+
   void process_operation_cache(const MainContext &ctx) {
     SEQUANT_ASSERT(m_queue.empty());
     SEQUANT_ASSERT(m_cache.empty() ||
@@ -685,6 +1076,13 @@ class GenerationOptimizer final : public Generator<MainContext> {
 
     optimize_operation_cache(ctx);
 
+    const double peak = m_schedule_memory ? schedule_operation_cache()
+                                          : peak_memory(m_cache);
+    double &section_peak = m_peak_memory[ctx.inside_named_section()
+                                             ? ctx.current_section_name()
+                                             : std::string{}];
+    section_peak = std::max(section_peak, peak);
+
     for (Operation &op : m_cache) {
       op->execute(m_generator, ctx);
     }
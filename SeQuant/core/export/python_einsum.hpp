@@ -17,6 +17,7 @@
 #include <boost/unordered/unordered_map.hpp>
 #include <boost/unordered/unordered_set.hpp>
 
+#include <algorithm>
 #include <cctype>
 #include <cstdlib>
 #include <sstream>
@@ -345,9 +346,13 @@ class PythonEinsumGeneratorBase : public Generator<Context> {
   /// Get the available characters for einsum indices
   virtual const std::string &available_index_chars() const = 0;
 
-  /// Backend-specific flag for optimize parameter in einsum
+  /// Whether einsum accepts an explicit contraction path via its optimize
+  /// parameter
   virtual bool use_optimize_parameter() const = 0;
 
+  /// Get the name of the function permuting the modes of a tensor
+  virtual std::string permute_function() const = 0;
+
   /// Get the Python order string from memory layout
   std::string get_order_string(const Context &ctx) const {
     switch (ctx.memory_layout()) {
@@ -453,48 +458,212 @@ class PythonEinsumGeneratorBase : public Generator<Context> {
   /// Convert an expression to an einsum call
   std::string to_einsum_expr(const Expr &expr, const Tensor &result,
                              const Context &ctx) const {
-    // Create local index mapping for this einsum operation
-    // This ensures each operation uses optimal character assignments
-    boost::unordered::unordered_map<std::string, std::string> index_map;
-    boost::unordered::unordered_set<std::string> used_chars;
-
-    std::string einsum_spec;
-    std::vector<std::string> tensor_names;
+    std::vector<const Tensor *> tensors;
     std::string scalar_factor;
 
     // Extract scalar prefactor and tensors from the expression
-    extract_einsum_components(expr, einsum_spec, tensor_names, scalar_factor,
-                              ctx, index_map, used_chars);
-
-    // Add output specification
-    einsum_spec +=
-        "->" + tensor_to_einsum_subscript(result, ctx, index_map, used_chars);
+    extract_einsum_components(expr, tensors, scalar_factor, ctx);
 
     // make sure there is at least one tensor, else return the scalar
-    if (tensor_names.empty()) {
+    if (tensors.empty()) {
       return scalar_factor.empty() ? std::string{"1"} : scalar_factor;
     }
 
-    // Build einsum call
-    std::string einsum_call = module_prefix() + "einsum('" + einsum_spec + "'";
+    return apply_scalar_factor(scalar_factor,
+                               contraction_call(tensors, &result, ctx));
+  }
 
-    for (const std::string &name : tensor_names) {
-      einsum_call += ", " + name;
+  /// Prefix a call with the given scalar factor unless it is trivial
+  static std::string apply_scalar_factor(const std::string &scalar_factor,
+                                         std::string call) {
+    if (!scalar_factor.empty() && scalar_factor != "1" &&
+        scalar_factor != "1.0") {
+      return scalar_factor + " * " + call;
     }
+    return call;
+  }
+
+  /// Build the call contracting the given tensors into the indices of
+  /// @p result (a full contraction if @p result is null)
+  ///
+  /// Indices are spelled as characters of the subscript string as long as
+  /// the backend has enough of them; beyond that the interleaved
+  /// operand/sublist form (which admits up to 52 distinct integer labels) is
+  /// used, and binary contractions exceeding even that are spelled as
+  /// tensordot followed by a permutation of the result.
+  std::string contraction_call(const std::vector<const Tensor *> &tensors,
+                               const Tensor *result, const Context &ctx) const {
+    // All distinct indices in order of first appearance
+    std::vector<std::string> labels;
+    boost::unordered::unordered_map<std::string, std::size_t> label_ids;
+    auto label_id = [&](const Index &idx) {
+      auto [it, inserted] =
+          label_ids.try_emplace(toUtf8(idx.full_label()), labels.size());
+      if (inserted) {
+        labels.push_back(it->first);
+      }
+      return it->second;
+    };
 
-    if (use_optimize_parameter()) {
-      einsum_call += ", optimize=True";
+    std::vector<std::vector<std::size_t>> operand_ids;
+    for (const Tensor *tensor : tensors) {
+      std::vector<std::size_t> &ids = operand_ids.emplace_back();
+      for (const Index &idx : tensor->const_indices()) {
+        ids.push_back(label_id(idx));
+      }
+    }
+    std::vector<std::size_t> result_ids;
+    if (result) {
+      for (const Index &idx : result->const_indices()) {
+        result_ids.push_back(label_id(idx));
+      }
     }
 
-    einsum_call += ")";
+    std::string call;
+    if (labels.size() <= available_index_chars().size()) {
+      // Create local index mapping for this einsum operation
+      // This ensures each operation uses optimal character assignments
+      boost::unordered::unordered_map<std::string, std::string> index_map;
+      boost::unordered::unordered_set<std::string> used_chars;
 
-    // Apply scalar factor if present
-    if (!scalar_factor.empty() && scalar_factor != "1" &&
-        scalar_factor != "1.0") {
-      einsum_call = scalar_factor + " * " + einsum_call;
+      std::string einsum_spec;
+      for (const Tensor *tensor : tensors) {
+        if (!einsum_spec.empty()) einsum_spec += ",";
+        einsum_spec +=
+            tensor_to_einsum_subscript(*tensor, ctx, index_map, used_chars);
+      }
+      einsum_spec += "->";
+      if (result) {
+        einsum_spec +=
+            tensor_to_einsum_subscript(*result, ctx, index_map, used_chars);
+      }
+
+      call = module_prefix() + "einsum('" + einsum_spec + "'";
+      for (const Tensor *tensor : tensors) {
+        call += ", " + represent(*tensor, ctx);
+      }
+    } else if (labels.size() <= max_sublist_labels) {
+      call = module_prefix() + "einsum(";
+      for (std::size_t i = 0; i < tensors.size(); ++i) {
+        call += represent(*tensors[i], ctx) + ", " +
+                to_python_list(operand_ids[i]) + ", ";
+      }
+      call += to_python_list(result_ids);
+    } else {
+      return tensordot_call(tensors, operand_ids, result_ids, ctx);
     }
 
-    return einsum_call;
+    call += contraction_path(tensors.size());
+    call += ")";
+
+    return call;
+  }
+
+  /// Largest number of distinct labels accepted by einsum's sublist form
+  static constexpr std::size_t max_sublist_labels = 52;
+
+  /// @return the optimize argument pinning the contraction order to the one
+  /// found by SeQuant, i.e. pairwise from left to right, so that the backend
+  /// doesn't search for a path on every call (empty if not applicable)
+  std::string contraction_path(std::size_t num_operands) const {
+    if (!use_optimize_parameter() || num_operands < 2) {
+      return {};
+    }
+
+    // Every contraction appends its intermediate to the end of the operand
+    // list, so the next operand in line is always at position 0
+    std::string path = ", optimize=['einsum_path', (0, 1)";
+    for (std::size_t k = 1; k + 1 < num_operands; ++k) {
+      path += ", (0, " + std::to_string(num_operands - 1 - k) + ")";
+    }
+    path += "]";
+
+    return path;
+  }
+
+  /// Spell a unary or binary contraction via tensordot and a permutation of
+  /// the result, which doesn't limit the number of distinct indices
+  std::string tensordot_call(
+      const std::vector<const Tensor *> &tensors,
+      const std::vector<std::vector<std::size_t>> &operand_ids,
+      const std::vector<std::size_t> &result_ids, const Context &ctx) const {
+    auto position = [](const std::vector<std::size_t> &ids, std::size_t id) {
+      return static_cast<std::size_t>(std::find(ids.begin(), ids.end(), id) -
+                                      ids.begin());
+    };
+    auto contains = [&](const std::vector<std::size_t> &ids, std::size_t id) {
+      return position(ids, id) < ids.size();
+    };
+
+    std::string call;
+    std::vector<std::size_t> produced;
+    if (tensors.size() == 1) {
+      call = represent(*tensors[0], ctx);
+      produced = operand_ids[0];
+    } else if (tensors.size() == 2) {
+      const std::vector<std::size_t> &lhs = operand_ids[0];
+      const std::vector<std::size_t> &rhs = operand_ids[1];
+
+      std::vector<std::size_t> lhs_axes;
+      std::vector<std::size_t> rhs_axes;
+      for (std::size_t i = 0; i < lhs.size(); ++i) {
+        if (!contains(rhs, lhs[i])) {
+          produced.push_back(lhs[i]);
+        } else if (!contains(result_ids, lhs[i])) {
+          lhs_axes.push_back(i);
+          rhs_axes.push_back(position(rhs, lhs[i]));
+        } else {
+          throw Exception(
+              "Too many unique indices for einsum notation (Hadamard "
+              "products can't be expressed via tensordot)");
+        }
+      }
+      for (std::size_t id : rhs) {
+        if (!contains(lhs, id)) {
+          produced.push_back(id);
+        }
+      }
+
+      call = module_prefix() + "tensordot(" + represent(*tensors[0], ctx) +
+             ", " + represent(*tensors[1], ctx) + ", (" +
+             to_python_list(lhs_axes) + ", " + to_python_list(rhs_axes) + "))";
+    } else {
+      throw Exception("Too many unique indices for einsum notation");
+    }
+
+    if (produced.size() != result_ids.size() ||
+        !std::ranges::all_of(produced, [&](std::size_t id) {
+          return contains(result_ids, id);
+        })) {
+      throw Exception(
+          "Too many unique indices for einsum notation (traces can't be "
+          "expressed via tensordot)");
+    }
+
+    if (produced == result_ids) {
+      return call;
+    }
+
+    std::string permutation = "(";
+    for (std::size_t i = 0; i < result_ids.size(); ++i) {
+      if (i > 0) permutation += ", ";
+      permutation += std::to_string(position(produced, result_ids[i]));
+    }
+    permutation += ")";
+
+    return module_prefix() + permute_function() + "(" + call + ", " +
+           permutation + ")";
+  }
+
+  /// Format a sequence of integers as a Python list
+  static std::string to_python_list(const std::vector<std::size_t> &values) {
+    std::string list = "[";
+    for (std::size_t i = 0; i < values.size(); ++i) {
+      if (i > 0) list += ", ";
+      list += std::to_string(values[i]);
+    }
+    list += "]";
+    return list;
   }
 
   /// Render a scalar leaf expression (Variable, Constant, or Power thereof)
@@ -512,18 +681,12 @@ class PythonEinsumGeneratorBase : public Generator<Context> {
   }
 
   /// Extract einsum components from an expression
-  void extract_einsum_components(
-      const Expr &expr, std::string &einsum_spec,
-      std::vector<std::string> &tensor_names, std::string &scalar_factor,
-      const Context &ctx,
-      boost::unordered::unordered_map<std::string, std::string> &index_map,
-      boost::unordered::unordered_set<std::string> &used_chars) const {
+  void extract_einsum_components(const Expr &expr,
+                                 std::vector<const Tensor *> &tensors,
+                                 std::string &scalar_factor,
+                                 const Context &ctx) const {
     if (expr.is<Tensor>()) {
-      const Tensor &tensor = expr.as<Tensor>();
-      if (!einsum_spec.empty()) einsum_spec += ",";
-      einsum_spec +=
-          tensor_to_einsum_subscript(tensor, ctx, index_map, used_chars);
-      tensor_names.push_back(represent(tensor, ctx));
+      tensors.push_back(&expr.as<Tensor>());
     } else if (expr.is<Variable>() || expr.is<Constant>() || expr.is<Power>()) {
       std::string repr = stringify_scalar(expr, ctx);
       if (scalar_factor.empty()) {
@@ -546,8 +709,8 @@ class PythonEinsumGeneratorBase : public Generator<Context> {
 
       // Handle tensor factors
       for (std::size_t i = 0; i < product.size(); ++i) {
-        extract_einsum_components(*product.factor(i), einsum_spec, tensor_names,
-                                  scalar_factor, ctx, index_map, used_chars);
+        extract_einsum_components(*product.factor(i), tensors, scalar_factor,
+                                  ctx);
       }
     } else if (expr.is<Sum>()) {
       // For sums, we can't use a single einsum call
@@ -569,44 +732,18 @@ class PythonEinsumGeneratorBase : public Generator<Context> {
       // For a scalar result, we need to contract all indices
       // This is an einsum with no output indices
 
-      // Create local index mapping for this einsum operation
-      boost::unordered::unordered_map<std::string, std::string> index_map;
-      boost::unordered::unordered_set<std::string> used_chars;
-
-      std::string einsum_spec;
-      std::vector<std::string> tensor_names;
+      std::vector<const Tensor *> tensors;
       std::string scalar_factor;
 
-      extract_einsum_components(expr, einsum_spec, tensor_names, scalar_factor,
-                                ctx, index_map, used_chars);
+      extract_einsum_components(expr, tensors, scalar_factor, ctx);
 
       // make sure there is at least one tensor, else return the scalar
-      if (tensor_names.empty()) {
+      if (tensors.empty()) {
         return scalar_factor.empty() ? std::string{"1"} : scalar_factor;
       }
 
-      // For scalar result, use "->" or "->..."
-      einsum_spec += "->";
-
-      std::string einsum_call =
-          module_prefix() + "einsum('" + einsum_spec + "'";
-
-      for (const std::string &name : tensor_names) {
-        einsum_call += ", " + name;
-      }
-
-      if (use_optimize_parameter()) {
-        einsum_call += ", optimize=True";
-      }
-
-      einsum_call += ")";
-
-      if (!scalar_factor.empty() && scalar_factor != "1" &&
-          scalar_factor != "1.0") {
-        einsum_call = scalar_factor + " * " + einsum_call;
-      }
-
-      return einsum_call;
+      return apply_scalar_factor(scalar_factor,
+                                 contraction_call(tensors, nullptr, ctx));
     } else if (expr.is<Sum>()) {
       const Sum &sum = expr.as<Sum>();
       std::string result = "(";
@@ -730,6 +867,8 @@ class NumPyEinsumGenerator
   }
 
   bool use_optimize_parameter() const override { return true; }
+
+  std::string permute_function() const override { return "transpose"; }
 };
 
 /// Generator for PyTorch einsum
@@ -838,7 +977,10 @@ class PyTorchEinsumGenerator
     return chars;
   }
 
+  // torch.einsum takes the contraction path from opt_einsum, if at all
   bool use_optimize_parameter() const override { return false; }
+
+  std::string permute_function() const override { return "permute"; }
 };
 
 /// Backward compatibility alias - default to NumPy
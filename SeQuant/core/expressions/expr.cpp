@@ -519,6 +519,41 @@ ExprPtr HashingAccumulator::make_expr(bool canonicalize) {
     return make_sum_impl(canonicalize);
 }
 
+ShardedHashingAccumulator::ShardedHashingAccumulator(std::size_t nshards) {
+  if (nshards == 0) nshards = 4 * static_cast<std::size_t>(num_threads());
+  shards_.reserve(nshards);
+  for (std::size_t s = 0; s != nshards; ++s)
+    shards_.emplace_back(std::make_unique<Shard>());
+}
+
+ShardedHashingAccumulator &ShardedHashingAccumulator::append(ExprPtr summand,
+                                                             bool flatten) {
+  // flatten, if needed, before sharding since subsummands hash differently
+  if (flatten && summand.is<Sum>()) {
+    for (auto &subsummand : summand.as<Sum>().summands()) {
+      this->append(subsummand, flatten);
+    }
+    return *this;
+  }
+
+  auto &shard =
+      *shards_[sequant::hash::_<ExprPtr>{}(summand) % shards_.size()];
+  std::scoped_lock lock(shard.mtx);
+  shard.acc.append(std::move(summand), flatten);
+  return *this;
+}
+
+ExprPtr ShardedHashingAccumulator::make_expr(bool canonicalize) {
+  // shards are disjoint, hence merging them does not combine any summands
+  HashingAccumulator result;
+  for (auto &shard : shards_) {
+    if (shard->acc.empty()) continue;
+    for (auto &summand : shard->acc.make_sum()->summands())
+      result.append(summand, /* flatten = */ false);
+  }
+  return result.make_expr(canonicalize);
+}
+
 bool proportional_to::operator()(const ExprPtr &expr1,
                                  const ExprPtr &expr2) const {
   if (expr1->type_id() !=
@@ -9,13 +9,18 @@
 #include <SeQuant/core/io/latex/latex.hpp>
 #include <SeQuant/core/logger.hpp>
 #include <SeQuant/core/options.hpp>
+#include <SeQuant/core/runtime.hpp>
 #include <SeQuant/core/utility/macros.hpp>
 
 #include <range/v3/range/primitives.hpp>
 
+#include <algorithm>
+#include <cstddef>
 #include <iostream>
+#include <numeric>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace sequant {
 
@@ -132,40 +137,79 @@ struct ExpandVisitor {
     // simplification and canonicalization are to be done by other visitors
   }
 
-  /// expands the first Sum in a Product
-  /// @param[in,out] expr (shared_ptr to ) a Product whose first Sum gets
+  /// if true, terms produced by expand_product are canonicalized and
+  /// accumulated on the fly
+  /// @sa ExpandOptions::canonicalize
+  bool canonicalize_terms = false;
+  /// @sa ExpandOptions::parallel_threshold
+  std::size_t parallel_threshold = ExpandOptions{}.parallel_threshold;
+
+  /// expands all Sums in a Product at once, i.e. generates the Cartesian
+  /// product of their summands
+  /// @param[in,out] expr (shared_ptr to ) a Product whose Sums get
   /// expanded; on return @c expr contains the result
   bool expand_product(ExprPtr& expr) {
-    auto& expr_ref = *expr;
-    std::shared_ptr<Sum> result;
-    const auto nsubexpr = size(expr);
-    for (std::size_t i = 0; i != nsubexpr; ++i) {
-      if (expr_ref[i]->is<Sum>()) {
-        // make template for expr cloning to avoid cloning the Sum we are about
-        // to expand
-        auto scalar = std::static_pointer_cast<Product>(expr)->scalar();
-        auto exprseq_clone_template = container::svector<ExprPtr>(
-            ranges::begin(*expr), ranges::end(*expr));
-        exprseq_clone_template[i].reset();
-        // allocate the result, if not done yet
-        if (!result) result = std::make_shared<Sum>();
-        ExprPtr subexpr_to_expand = expr_ref[i];
-        for (auto& subsubexpr : *subexpr_to_expand) {
-          auto exprseq_clone =
-              clone(exprseq_clone_template);  // clone the product factors
-                                              // without the expanded sum
-          exprseq_clone[i] = subsubexpr;      // scavenging summands here
-          using std::begin;
-          using std::end;
-          result->append(
-              ex<Product>(scalar, begin(exprseq_clone), end(exprseq_clone)));
-        }
-        expr =
-            std::static_pointer_cast<Expr>(result);  // expanded one Sum, return
-        return true;
+    const auto& product = expr->as<Product>();
+    const auto& factors = product.factors();
+
+    // locate the Sums and count the terms of the expansion up front
+    container::svector<std::size_t> sum_positions;
+    std::size_t nterms = 1;
+    for (std::size_t i = 0; i != factors.size(); ++i) {
+      if (factors[i]->is<Sum>()) {
+        sum_positions.push_back(i);
+        nterms *= factors[i]->as<Sum>().summands().size();
       }
     }
-    return false;
+    if (sum_positions.empty()) return false;
+
+    // term k picks summand k_s of Sum s, with k = (k_0, k_1, ...) in mixed
+    // radix (the last Sum varies fastest); all factors are cloned since
+    // each summand appears in more than one term
+    auto make_term = [&factors, &sum_positions, scalar = product.scalar()](
+                         std::size_t k) -> ExprPtr {
+      container::svector<ExprPtr> term_factors(factors.begin(), factors.end());
+      for (auto s = sum_positions.size(); s-- != 0;) {
+        const auto pos = sum_positions[s];
+        const auto& sum = factors[pos]->as<Sum>();
+        const auto nsummands = sum.summands().size();
+        term_factors[pos] = sum.summand(k % nsummands);
+        k /= nsummands;
+      }
+      for (auto& factor : term_factors) factor = factor->clone();
+      return ex<Product>(scalar, term_factors.begin(), term_factors.end());
+    };
+
+    // applies op to all term ordinals, in parallel chunks if worthwhile
+    const bool parallel = nterms >= parallel_threshold && num_threads() > 1;
+    auto generate = [nterms, parallel](const auto& op) {
+      if (!parallel) {
+        for (std::size_t k = 0; k != nterms; ++k) op(k);
+        return;
+      }
+      const std::size_t nchunks =
+          std::min(nterms, 4 * static_cast<std::size_t>(num_threads()));
+      std::vector<std::size_t> chunks(nchunks);
+      std::iota(chunks.begin(), chunks.end(), 0);
+      sequant::for_each(chunks, [&](std::size_t c) {
+        const auto k_end = (c + 1) * nterms / nchunks;
+        for (auto k = c * nterms / nchunks; k != k_end; ++k) op(k);
+      });
+    };
+
+    if (canonicalize_terms) {
+      ShardedHashingAccumulator acc(parallel ? 0 : 1);
+      generate([&](std::size_t k) {
+        auto term = make_term(k);
+        acc.append(sequant::canonicalize(term));
+      });
+      expr = acc.make_expr();
+    } else {
+      Sum::summands_type terms(nterms);
+      generate([&](std::size_t k) { terms[k] = make_term(k); });
+      expr = std::make_shared<Sum>(std::move(terms), Sum::move_only_tag{});
+    }
+    return true;
   }
 
   /// expands a Sum
@@ -241,14 +285,20 @@ struct ExpandVisitor {
   }
 };
 
-ExprPtr& expand(ExprPtr& expr) {
-  ExpandVisitor expander{};
+ExprPtr& expand(ExprPtr& expr, const ExpandOptions& opts) {
+  // N.B. only top-level terms can be canonicalized on the fly, hence
+  // subexpressions are expanded without canonicalization
+  ExpandVisitor expander{.parallel_threshold = opts.parallel_threshold};
   expr->visit(expander);
-  expander(expr);
+  ExpandVisitor top_expander{.canonicalize_terms = opts.canonicalize,
+                             .parallel_threshold = opts.parallel_threshold};
+  top_expander(expr);
   return expr;
 }
 
-ExprPtr expand(ExprPtr&& expr) { return expand(expr); }
+ExprPtr expand(ExprPtr&& expr, const ExpandOptions& opts) {
+  return expand(expr, opts);
+}
 
 ResultExpr& expand(ResultExpr& expr) {
   expr.expression() = expand(expr.expression());
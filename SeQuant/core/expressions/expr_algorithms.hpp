@@ -145,13 +145,15 @@ ResultExpr& canonicalize(
 
 /// Recursively expands products of sums
 /// @param[in,out] expr expression to be expanded
+/// @param[in] opts expansion options
 /// @return \p expr to facilitate chaining
-ExprPtr& expand(ExprPtr& expr);
+ExprPtr& expand(ExprPtr& expr, const ExpandOptions& opts = {});
 
 /// Recursively expands products of sums
 /// @param[in,out] expr expression to be expanded
+/// @param[in] opts expansion options
 /// @return \p expr to facilitate chaining
-ExprPtr expand(ExprPtr&& expr);
+ExprPtr expand(ExprPtr&& expr, const ExpandOptions& opts = {});
 
 /// Recursively expands products of sums
 /// @param[in,out] expr expression to be expanded
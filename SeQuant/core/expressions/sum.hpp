@@ -14,8 +14,12 @@
 #include <range/v3/view/filter.hpp>
 #include <range/v3/view/transform.hpp>
 
+#include <cstddef>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <type_traits>
+#include <vector>
 
 namespace sequant {
 
@@ -375,6 +379,10 @@ class HashingAccumulator {
 
   bool empty() const { return summands_.empty(); }
 
+  /// preallocates space for @p n distinct summands
+  /// @param n the expected number of distinct summands
+  void reserve(std::size_t n) { summands_.reserve(n); }
+
  private:
   /// @brief Common implementation for make_sum and make_canonicalized_sum
   /// @param canonicalize if true, sort the summands by hash value
@@ -384,6 +392,36 @@ class HashingAccumulator {
       summands_;
 };
 
+/// @brief thread-safe variant of HashingAccumulator
+/// Summands are partitioned by their hash value into independently locked
+/// shards; since proportional summands have identical hash values they
+/// always land in the same shard, hence concurrent appends only contend when
+/// they hit the same shard.
+class ShardedHashingAccumulator {
+ public:
+  /// @param nshards the number of shards; if 0, will use 4 shards per thread
+  /// @sa num_threads()
+  explicit ShardedHashingAccumulator(std::size_t nshards = 0);
+
+  /// @p summand expr to append to the sum; can be called concurrently
+  /// @p flatten if true, and @p summand is a Sum, will flatten the sum
+  ShardedHashingAccumulator &append(ExprPtr summand, bool flatten = true);
+
+  /// @param canonicalize if true, will sort the summands to canonical order
+  /// defined by ExprPtr::operator<
+  /// @return summands as a Sum (if have more than 1 summand), Constant (if have
+  /// zero summands), or the lone summand itself
+  /// @warning must not be called concurrently with append()
+  ExprPtr make_expr(bool canonicalize = true);
+
+ private:
+  struct Shard {
+    std::mutex mtx;
+    HashingAccumulator acc;
+  };
+  std::vector<std::unique_ptr<Shard>> shards_;
+};
+
 struct TransformSumExprOptions {
   bool canonicalize = true;
   bool flatten = true;
@@ -395,10 +433,9 @@ template <typename SizedRange, typename UnaryMapOp>
   requires(meta::is_range_v<std::remove_cvref_t<SizedRange>>)
 ExprPtr transform_sum_expr(SizedRange &&rng, const UnaryMapOp &map,
                            const TransformSumExprOptions &options = {}) {
-  HashingAccumulator result_acc;
-  std::mutex result_mtx;  // serializes updates of result
+  ShardedHashingAccumulator result_acc;
 
-  auto task = [&result_acc, &result_mtx, &map,
+  auto task = [&result_acc, &map,
                canonicalize = options.canonicalize,
                flatten = options.flatten](const ExprPtr &input) {
     auto task_result = map(input);
@@ -410,7 +447,6 @@ ExprPtr transform_sum_expr(SizedRange &&rng, const UnaryMapOp &map,
         }
       }
 
-      std::scoped_lock<std::mutex> lock(result_mtx);
       result_acc.append(task_result, flatten);
     }
   };
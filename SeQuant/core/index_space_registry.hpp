@@ -21,8 +21,11 @@
 #include <boost/hana.hpp>
 #include <boost/hana/ext/std/integral_constant.hpp>
 
+#include <atomic>
+#include <memory>
 #include <mutex>
 #include <ranges>
+#include <vector>
 
 namespace sequant {
 
@@ -135,7 +138,7 @@ class IndexSpaceRegistry {
     complete_ = other.complete_;
     hole_space_ = other.hole_space_;
     particle_space_ = other.particle_space_;
-    return *this;
+    return clear_memoized_data_and_return_this();
   }
 
   /// move assignment operator
@@ -148,7 +151,7 @@ class IndexSpaceRegistry {
     complete_ = std::move(other.complete_);
     hole_space_ = std::move(other.hole_space_);
     particle_space_ = std::move(other.particle_space_);
-    return *this;
+    return clear_memoized_data_and_return_this();
   }
 
   /// deep copy of this object, creates a copy of its spaces
@@ -826,19 +829,7 @@ class IndexSpaceRegistry {
   /// @return (memoized) set of base IndexSpace::Type objects, sorted in
   /// increasing order
   const std::vector<IndexSpace::Type>& base_space_types() const {
-    if (!base_space_types_) {
-      auto types = *spaces_ | ranges::views::transform([](const auto& s) {
-        return s.type();
-      }) | ranges::views::filter([](const auto& t) { return is_base(t); }) |
-                   ranges::views::unique | ranges::to_vector;
-      ranges::sort(types, [](auto t1, auto t2) { return t1 < t2; });
-      std::scoped_lock guard{mtx_memoized_};
-      if (!base_space_types_) {
-        base_space_types_ =
-            std::make_shared<std::vector<IndexSpace::Type>>(std::move(types));
-      }
-    }
-    return *base_space_types_;
+    return memoized().base_space_types;
   }
 
   /// @brief returns the list of _basis_ IndexSpace objects
@@ -848,20 +839,7 @@ class IndexSpaceRegistry {
   /// @return (memoized) set of base IndexSpace objects, sorted in the order of
   /// increasing type()
   const std::vector<IndexSpace>& base_spaces() const {
-    if (!base_spaces_) {
-      auto spaces = *spaces_ | ranges::views::filter([this](const auto& s) {
-        return this->is_base(s);
-      }) | ranges::views::unique |
-                    ranges::to_vector;
-      ranges::sort(spaces,
-                   [](auto s1, auto s2) { return s1.type() < s2.type(); });
-      std::scoped_lock guard{mtx_memoized_};
-      if (!base_spaces_) {
-        base_spaces_ =
-            std::make_shared<std::vector<IndexSpace>>(std::move(spaces));
-      }
-    }
-    return *base_spaces_;
+    return memoized().base_spaces;
   }
 
   /// @brief checks if an IndexSpace is in the basis
@@ -1368,15 +1346,49 @@ class IndexSpaceRegistry {
 
   bitset_t physical_particle_attribute_mask_ = bitset::null;
 
-  // memoized data
-  mutable std::shared_ptr<std::vector<IndexSpace::Type>> base_space_types_;
-  mutable std::shared_ptr<std::vector<IndexSpace>> base_spaces_;
-  mutable std::recursive_mutex
-      mtx_memoized_;  // used to update the memoized data
+  // memoized data, computed lazily and published atomically so that readers
+  // never lock; it is released by the mutators, which (like any modification
+  // of the spaces) require exclusive access to this object, hence at most one
+  // memo is alive at any time
+  struct Memo {
+    std::vector<IndexSpace::Type> base_space_types;
+    std::vector<IndexSpace> base_spaces;
+  };
+  mutable std::atomic<const Memo*> memo_ = nullptr;
+  mutable std::unique_ptr<const Memo> memo_owner_;
+  mutable std::mutex mtx_memoized_;  // used to publish the memoized data
+
+  const Memo& memoized() const {
+    if (auto* memo = memo_.load(std::memory_order_acquire)) return *memo;
+
+    auto memo = std::make_unique<Memo>();
+    memo->base_space_types =
+        *spaces_ |
+        ranges::views::transform([](const auto& s) { return s.type(); }) |
+        ranges::views::filter([](const auto& t) { return is_base(t); }) |
+        ranges::views::unique | ranges::to_vector;
+    ranges::sort(memo->base_space_types,
+                 [](auto t1, auto t2) { return t1 < t2; });
+    memo->base_spaces =
+        *spaces_ |
+        ranges::views::filter([this](const auto& s) { return is_base(s); }) |
+        ranges::views::unique | ranges::to_vector;
+    ranges::sort(memo->base_spaces,
+                 [](auto s1, auto s2) { return s1.type() < s2.type(); });
+
+    std::scoped_lock guard{mtx_memoized_};
+    // another thread may have published while we were computing
+    if (auto* published = memo_.load(std::memory_order_relaxed))
+      return *published;
+    memo_owner_ = std::move(memo);
+    memo_.store(memo_owner_.get(), std::memory_order_release);
+    return *memo_owner_;
+  }
+
   IndexSpaceRegistry& clear_memoized_data_and_return_this() {
     std::scoped_lock guard{mtx_memoized_};
-    base_space_types_.reset();
-    base_spaces_.reset();
+    memo_.store(nullptr, std::memory_order_release);
+    memo_owner_.reset();
     return *this;
   }
 
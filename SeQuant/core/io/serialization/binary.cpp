@@ -0,0 +1,725 @@
+#include <SeQuant/core/io/serialization/binary.hpp>
+
+#include <SeQuant/core/attr.hpp>
+#include <SeQuant/core/complex.hpp>
+#include <SeQuant/core/context.hpp>
+#include <SeQuant/core/expr.hpp>
+#include <SeQuant/core/op.hpp>
+#include <SeQuant/core/rational.hpp>
+#include <SeQuant/core/utility/macros.hpp>
+#include <SeQuant/core/utility/string.hpp>
+
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <ostream>
+#include <sstream>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define SEQUANT_BINARY_HAS_MMAP 1
+#endif
+
+namespace sequant::io::serialization::binary {
+
+namespace {
+
+constexpr std::string_view magic{"SQB\x01", 4};
+
+/// flush the Writer's buffer into its stream once it grows beyond this size
+constexpr std::size_t flush_threshold = 1 << 16;
+
+enum class DocumentKind : std::uint8_t { Expr = 0, Result = 1 };
+
+enum class BodyKind : std::uint8_t { Null = 0, Single = 1, Sum = 2 };
+
+enum class Tag : std::uint8_t {
+  Constant = 1,
+  Tensor,
+  Product,
+  Sum,
+  Variable,
+  Power,
+  FNOperator,
+  BNOperator,
+};
+
+/// index references: 0 is the null index, 1 introduces a new index, any other
+/// value n refers to the (n-2)th index introduced so far
+constexpr std::uint64_t null_index_ref = 0;
+constexpr std::uint64_t new_index_ref = 1;
+
+void write_byte(std::string &buf, std::uint8_t byte) {
+  buf.push_back(static_cast<char>(byte));
+}
+
+void write_varint(std::string &buf, std::uint64_t value) {
+  while (value >= 0x80) {
+    write_byte(buf, static_cast<std::uint8_t>(value) | 0x80);
+    value >>= 7;
+  }
+  write_byte(buf, static_cast<std::uint8_t>(value));
+}
+
+/// writes a nonnegative integer of arbitrary size as a varint
+void write_varint(std::string &buf, intmax_t value) {
+  SEQUANT_ASSERT(value >= 0);
+  if (value <= std::numeric_limits<std::uint64_t>::max()) {
+    write_varint(buf, static_cast<std::uint64_t>(value));
+    return;
+  }
+  while (value >= 0x80) {
+    write_byte(buf, static_cast<std::uint8_t>(value & 0x7f) | 0x80);
+    value >>= 7;
+  }
+  write_byte(buf, static_cast<std::uint8_t>(value));
+}
+
+/// a rational is written as the zigzag-encoded numerator followed by the
+/// denominator
+void write_rational(std::string &buf, const rational &r) {
+  const intmax_t &num = numerator(r);
+  write_varint(buf, num < 0 ? intmax_t(-num * 2 - 1) : intmax_t(num * 2));
+  write_varint(buf, intmax_t(denominator(r)));
+}
+
+void write_scalar(std::string &buf, const Constant::scalar_type &value) {
+  write_rational(buf, value.real());
+  const bool has_imag = value.imag() != 0;
+  write_byte(buf, has_imag);
+  if (has_imag) write_rational(buf, value.imag());
+}
+
+/// reads a nonnegative integer of arbitrary size written by write_varint()
+template <typename ReadByte>
+intmax_t read_bigint(ReadByte &&read_byte) {
+  std::uint64_t low = 0;
+  unsigned shift = 0;
+  std::uint8_t byte;
+  do {
+    byte = read_byte();
+    low |= std::uint64_t{byte & 0x7fu} << shift;
+    shift += 7;
+  } while ((byte & 0x80) != 0 && shift < 63);
+
+  intmax_t value = low;
+  while ((byte & 0x80) != 0) {
+    byte = read_byte();
+    value |= intmax_t(byte & 0x7f) << shift;
+    shift += 7;
+  }
+  return value;
+}
+
+std::uint8_t pack_symmetries(Symmetry s, BraKetSymmetry bks,
+                             ColumnSymmetry cs) {
+  return static_cast<std::uint8_t>(s) |
+         (static_cast<std::uint8_t>(bks) << 2) |
+         (static_cast<std::uint8_t>(cs) << 4);
+}
+
+}  // namespace
+
+//
+// Writer
+//
+
+std::size_t Writer::IndexHasher::operator()(const Index &idx) const {
+  return hash_value(idx);
+}
+
+Writer::Writer(std::ostream &os) : os_(&os) {
+  buffer_.append(magic);
+  write_varint(buffer_, std::uint64_t{format_version});
+  flush();
+}
+
+void Writer::flush() {
+  os_->write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+  buffer_.clear();
+}
+
+void Writer::write(const ExprPtr &expr) {
+  SEQUANT_ASSERT(!in_sum_);
+  if (expr && expr->is<Sum>()) {
+    begin_sum();
+    for (const ExprPtr &term : expr->as<Sum>().summands()) write_term(term);
+    end_sum();
+    return;
+  }
+
+  write_byte(buffer_, static_cast<std::uint8_t>(DocumentKind::Expr));
+  if (expr) {
+    write_byte(buffer_, static_cast<std::uint8_t>(BodyKind::Single));
+    write_node(*expr);
+  } else {
+    write_byte(buffer_, static_cast<std::uint8_t>(BodyKind::Null));
+  }
+  flush();
+}
+
+void Writer::write(const ResultExpr &result) {
+  SEQUANT_ASSERT(!in_sum_);
+  const ExprPtr &expr = result.expression();
+  if (expr && expr->is<Sum>()) {
+    begin_sum(result);
+    for (const ExprPtr &term : expr->as<Sum>().summands()) write_term(term);
+    end_sum();
+    return;
+  }
+
+  write_result_header(result);
+  if (expr) {
+    write_byte(buffer_, static_cast<std::uint8_t>(BodyKind::Single));
+    write_node(*expr);
+  } else {
+    write_byte(buffer_, static_cast<std::uint8_t>(BodyKind::Null));
+  }
+  flush();
+}
+
+void Writer::begin_sum() {
+  SEQUANT_ASSERT(!in_sum_);
+  write_byte(buffer_, static_cast<std::uint8_t>(DocumentKind::Expr));
+  write_byte(buffer_, static_cast<std::uint8_t>(BodyKind::Sum));
+  in_sum_ = true;
+}
+
+void Writer::begin_sum(const ResultExpr &result) {
+  SEQUANT_ASSERT(!in_sum_);
+  write_result_header(result);
+  write_byte(buffer_, static_cast<std::uint8_t>(BodyKind::Sum));
+  in_sum_ = true;
+}
+
+void Writer::write_term(const ExprPtr &term) {
+  SEQUANT_ASSERT(in_sum_);
+  SEQUANT_ASSERT(term);
+  write_byte(buffer_, 1);
+  write_node(*term);
+  if (buffer_.size() >= flush_threshold) flush();
+}
+
+void Writer::end_sum() {
+  SEQUANT_ASSERT(in_sum_);
+  write_byte(buffer_, 0);
+  in_sum_ = false;
+  flush();
+}
+
+void Writer::write_result_header(const ResultExpr &result) {
+  write_byte(buffer_, static_cast<std::uint8_t>(DocumentKind::Result));
+  write_byte(buffer_, result.has_label());
+  if (result.has_label()) write_string(result.label());
+  write_byte(buffer_,
+             pack_symmetries(result.symmetry(), result.braket_symmetry(),
+                             result.column_symmetry()));
+  for (const auto *slots : {&result.bra(), &result.ket(), &result.aux()}) {
+    write_varint(buffer_, std::uint64_t{slots->size()});
+    for (const Index &idx : *slots) write_index(idx);
+  }
+}
+
+void Writer::write_node(const Expr &expr) {
+  if (expr.is<Constant>()) {
+    write_byte(buffer_, static_cast<std::uint8_t>(Tag::Constant));
+    write_scalar(buffer_, expr.as<Constant>().value());
+  } else if (expr.is<Tensor>()) {
+    const auto &tensor = expr.as<Tensor>();
+    write_byte(buffer_, static_cast<std::uint8_t>(Tag::Tensor));
+    write_string(tensor.label());
+    write_byte(buffer_,
+               pack_symmetries(tensor.symmetry(), tensor.braket_symmetry(),
+                               tensor.column_symmetry()));
+    write_varint(buffer_, std::uint64_t{tensor.bra().size()});
+    write_varint(buffer_, std::uint64_t{tensor.ket().size()});
+    write_varint(buffer_, std::uint64_t{tensor.aux().size()});
+    for (const Index &idx : tensor.braketaux()) write_index(idx);
+  } else if (expr.is<Product>()) {
+    const auto &product = expr.as<Product>();
+    write_byte(buffer_, static_cast<std::uint8_t>(Tag::Product));
+    write_scalar(buffer_, product.scalar());
+    write_varint(buffer_, std::uint64_t{product.factors().size()});
+    for (const ExprPtr &factor : product.factors()) write_node(*factor);
+  } else if (expr.is<Sum>()) {
+    const auto &sum = expr.as<Sum>();
+    write_byte(buffer_, static_cast<std::uint8_t>(Tag::Sum));
+    write_varint(buffer_, std::uint64_t{sum.summands().size()});
+    for (const ExprPtr &summand : sum.summands()) write_node(*summand);
+  } else if (expr.is<Variable>()) {
+    const auto &var = expr.as<Variable>();
+    write_byte(buffer_, static_cast<std::uint8_t>(Tag::Variable));
+    write_string(var.label());
+    write_byte(buffer_, var.conjugated());
+  } else if (expr.is<Power>()) {
+    const auto &power = expr.as<Power>();
+    write_byte(buffer_, static_cast<std::uint8_t>(Tag::Power));
+    write_byte(buffer_, power.conjugated());
+    write_rational(buffer_, power.exponent());
+    write_node(*power.base());
+  } else if (expr.is<FNOperator>() || expr.is<BNOperator>()) {
+    auto write_nop = [this](Tag tag, const auto &nop) {
+      write_byte(buffer_, static_cast<std::uint8_t>(tag));
+      write_byte(buffer_, static_cast<std::uint8_t>(nop.vacuum()));
+      write_varint(buffer_, std::uint64_t{nop.ncreators()});
+      for (const auto &op : nop.creators()) write_index(op.index());
+      write_varint(buffer_, std::uint64_t{nop.nannihilators()});
+      for (const auto &op : nop.annihilators()) write_index(op.index());
+    };
+    if (expr.is<FNOperator>())
+      write_nop(Tag::FNOperator, expr.as<FNOperator>());
+    else
+      write_nop(Tag::BNOperator, expr.as<BNOperator>());
+  } else {
+    throw Exception("binary serialization: unsupported expression type '" +
+                    expr.type_name() + "'");
+  }
+}
+
+void Writer::write_string(std::wstring_view str) {
+  auto [it, inserted] =
+      strings_.try_emplace(std::wstring(str), strings_.size());
+  if (!inserted) {
+    write_varint(buffer_, std::uint64_t{it->second + 1});
+    return;
+  }
+  const std::string utf8 = toUtf8(str);
+  write_varint(buffer_, std::uint64_t{0});
+  write_varint(buffer_, std::uint64_t{utf8.size()});
+  buffer_.append(utf8);
+}
+
+void Writer::write_space(const IndexSpace &space) {
+  auto [it, inserted] =
+      spaces_.try_emplace(space.base_key(), spaces_.size());
+  if (!inserted) {
+    write_varint(buffer_, std::uint64_t{it->second + 1});
+    return;
+  }
+  write_varint(buffer_, std::uint64_t{0});
+  write_string(space.base_key());
+}
+
+void Writer::write_index(const Index &idx) {
+  if (!idx.nonnull()) {
+    write_varint(buffer_, null_index_ref);
+    return;
+  }
+  if (auto it = indices_.find(idx); it != indices_.end()) {
+    write_varint(buffer_, std::uint64_t{it->second + 2});
+    return;
+  }
+
+  write_varint(buffer_, new_index_ref);
+  write_space(idx.space());
+  write_varint(buffer_, idx.ordinal() ? *idx.ordinal() + 1 : 0);
+  write_byte(buffer_, idx.symmetric_proto_indices());
+  write_varint(buffer_, std::uint64_t{idx.proto_indices().size()});
+  for (const Index &proto : idx.proto_indices()) write_index(proto);
+  // N.B. proto indices are numbered before the index that carries them, the
+  // Reader relies on this
+  indices_.emplace(idx, indices_.size());
+}
+
+//
+// Reader
+//
+
+Reader::Reader(std::string_view data) : data_(data) {
+  if (data_.substr(0, magic.size()) != magic)
+    error("not a SeQuant binary stream", magic.size());
+  pos_ = magic.size();
+  const auto version = read_varint();
+  if (version == 0 || version > format_version)
+    error("unsupported binary format version " + std::to_string(version));
+  version_ = static_cast<std::uint32_t>(version);
+}
+
+bool Reader::at_end() const {
+  return state_ == State::Document && pos_ == data_.size();
+}
+
+std::optional<ResultExpr> Reader::begin_document() {
+  if (state_ != State::Document)
+    error("the current document has not been read completely");
+
+  std::optional<ResultExpr> result;
+  switch (static_cast<DocumentKind>(read_byte())) {
+    case DocumentKind::Expr:
+      break;
+    case DocumentKind::Result: {
+      std::optional<std::wstring> label;
+      if (read_byte() != 0) label = read_string();
+      const std::uint8_t symm = read_byte();
+      auto bra_indices = read_indices();
+      auto ket_indices = read_indices();
+      auto aux_indices = read_indices();
+      if ((symm & 0x3) > 2 || ((symm >> 2) & 0x3) > 2 || (symm >> 5) != 0)
+        error("invalid symmetry specification");
+      result.emplace(bra(std::move(bra_indices)), ket(std::move(ket_indices)),
+                     aux(std::move(aux_indices)),
+                     static_cast<Symmetry>(symm & 0x3),
+                     static_cast<BraKetSymmetry>((symm >> 2) & 0x3),
+                     static_cast<ColumnSymmetry>((symm >> 4) & 0x1),
+                     std::move(label), nullptr);
+      break;
+    }
+    default:
+      --pos_;
+      error("invalid document kind");
+  }
+
+  switch (static_cast<BodyKind>(read_byte())) {
+    case BodyKind::Null:
+      state_ = State::Done;
+      break;
+    case BodyKind::Single:
+      state_ = State::Single;
+      break;
+    case BodyKind::Sum:
+      state_ = State::Sum;
+      break;
+    default:
+      --pos_;
+      error("invalid document body");
+  }
+  document_is_sum_ = state_ == State::Sum;
+
+  return result;
+}
+
+ExprPtr Reader::next_term() {
+  switch (state_) {
+    case State::Document:
+      error("no document has been begun");
+    case State::Done:
+      state_ = State::Document;
+      return nullptr;
+    case State::Single:
+      state_ = State::Done;
+      return read_node();
+    case State::Sum:
+      switch (read_byte()) {
+        case 0:
+          state_ = State::Document;
+          return nullptr;
+        case 1:
+          return read_node();
+        default:
+          --pos_;
+          error("invalid term marker");
+      }
+  }
+
+  SEQUANT_UNREACHABLE;
+}
+
+ExprPtr Reader::read_body_expr() {
+  if (document_is_sum_) {
+    container::svector<ExprPtr> terms;
+    while (ExprPtr term = next_term()) terms.push_back(std::move(term));
+    return ex<Sum>(std::move(terms));
+  }
+
+  ExprPtr expr = state_ == State::Single ? read_node() : nullptr;
+  state_ = State::Document;
+  return expr;
+}
+
+ExprPtr Reader::read_expr() {
+  const std::size_t start = pos_;
+  if (begin_document().has_value()) {
+    pos_ = start;
+    error("expected an expression, found a result expression");
+  }
+  return read_body_expr();
+}
+
+ResultExpr Reader::read_result() {
+  const std::size_t start = pos_;
+  std::optional<ResultExpr> result = begin_document();
+  if (!result.has_value()) {
+    pos_ = start;
+    error("expected a result expression, found an expression");
+  }
+  result->expression() = read_body_expr();
+  return std::move(*result);
+}
+
+void Reader::error(std::string message, std::size_t length) const {
+  throw SerializationError(pos_, length, "binary deserialization: " + message);
+}
+
+std::uint8_t Reader::read_byte() {
+  if (pos_ >= data_.size()) error("unexpected end of input", 0);
+  return static_cast<std::uint8_t>(data_[pos_++]);
+}
+
+std::uint64_t Reader::read_varint() {
+  const std::size_t start = pos_;
+  std::uint64_t value = 0;
+  for (unsigned shift = 0;; shift += 7) {
+    const std::uint8_t byte = read_byte();
+    if (shift > 63 || (shift == 63 && (byte & 0x7e) != 0)) {
+      pos_ = start;
+      error("integer out of range");
+    }
+    value |= std::uint64_t{byte & 0x7fu} << shift;
+    if ((byte & 0x80) == 0) return value;
+  }
+}
+
+ExprPtr Reader::read_node() {
+  auto read_rational = [this]() -> rational {
+    auto byte = [this]() { return read_byte(); };
+    const intmax_t zigzag = read_bigint(byte);
+    const intmax_t den = read_bigint(byte);
+    if (den == 0) error("zero denominator");
+    const intmax_t num = (zigzag & 1) != 0 ? intmax_t(-((zigzag + 1) >> 1))
+                                           : intmax_t(zigzag >> 1);
+    return rational{num, den};
+  };
+  auto read_scalar = [&]() -> Constant::scalar_type {
+    rational re = read_rational();
+    rational im = read_byte() != 0 ? read_rational() : rational{0};
+    return {std::move(re), std::move(im)};
+  };
+  auto read_count = [this]() {
+    const std::uint64_t count = read_varint();
+    // every element occupies at least one byte
+    if (count > data_.size() - pos_) error("invalid element count");
+    return static_cast<std::size_t>(count);
+  };
+
+  const std::size_t start = pos_;
+  switch (static_cast<Tag>(read_byte())) {
+    case Tag::Constant:
+      return ex<Constant>(read_scalar());
+    case Tag::Tensor: {
+      std::wstring label = read_string();
+      const std::uint8_t symm = read_byte();
+      if ((symm & 0x3) > 2 || ((symm >> 2) & 0x3) > 2 || (symm >> 5) != 0)
+        error("invalid symmetry specification");
+      const std::size_t nbra = read_count();
+      const std::size_t nket = read_count();
+      const std::size_t naux = read_count();
+      auto read_n_indices = [this](std::size_t n) {
+        container::vector<Index> indices;
+        indices.reserve(n);
+        for (std::size_t i = 0; i < n; ++i) indices.push_back(read_index());
+        return indices;
+      };
+      auto bra_indices = read_n_indices(nbra);
+      auto ket_indices = read_n_indices(nket);
+      auto aux_indices = read_n_indices(naux);
+      try {
+        return ex<Tensor>(std::move(label), bra(std::move(bra_indices)),
+                          ket(std::move(ket_indices)),
+                          aux(std::move(aux_indices)),
+                          static_cast<Symmetry>(symm & 0x3),
+                          static_cast<BraKetSymmetry>((symm >> 2) & 0x3),
+                          static_cast<ColumnSymmetry>((symm >> 4) & 0x1));
+      } catch (const Exception &e) {
+        throw SerializationError(start, pos_ - start,
+                                 std::string("invalid tensor: ") + e.what());
+      }
+    }
+    case Tag::Product: {
+      Constant::scalar_type scalar = read_scalar();
+      const std::size_t n = read_count();
+      container::svector<ExprPtr> factors;
+      factors.reserve(n);
+      for (std::size_t i = 0; i < n; ++i) factors.push_back(read_node());
+      return ex<Product>(std::move(scalar), std::move(factors),
+                         Product::Flatten::No);
+    }
+    case Tag::Sum: {
+      const std::size_t n = read_count();
+      container::svector<ExprPtr> summands;
+      summands.reserve(n);
+      for (std::size_t i = 0; i < n; ++i) summands.push_back(read_node());
+      return ex<Sum>(std::move(summands));
+    }
+    case Tag::Variable: {
+      auto var = ex<Variable>(read_string());
+      if (read_byte() != 0) var->as<Variable>().conjugate();
+      return var;
+    }
+    case Tag::Power: {
+      const bool conjugated = read_byte() != 0;
+      rational exponent = read_rational();
+      ExprPtr base = read_node();
+      auto power = ex<Power>(std::move(base), std::move(exponent));
+      if (conjugated) power->as<Power>().conjugate();
+      return power;
+    }
+    case Tag::FNOperator:
+    case Tag::BNOperator: {
+      const auto tag = static_cast<Tag>(data_[start]);
+      const std::uint8_t vacuum = read_byte();
+      if (vacuum > static_cast<std::uint8_t>(Vacuum::MultiProduct))
+        error("invalid vacuum");
+      container::vector<Index> creators = read_indices();
+      container::vector<Index> annihilators = read_indices();
+      const auto vac = static_cast<Vacuum>(vacuum);
+      if (tag == Tag::FNOperator)
+        return ex<FNOperator>(cre(std::move(creators)),
+                              ann(std::move(annihilators)), vac);
+      return ex<BNOperator>(cre(std::move(creators)),
+                            ann(std::move(annihilators)), vac);
+    }
+  }
+
+  pos_ = start;
+  error("invalid expression tag");
+}
+
+const std::wstring &Reader::read_string() {
+  const std::size_t start = pos_;
+  const std::uint64_t ref = read_varint();
+  if (ref != 0) {
+    if (ref > strings_.size()) {
+      pos_ = start;
+      error("invalid string reference");
+    }
+    return strings_[ref - 1];
+  }
+
+  const std::uint64_t length = read_varint();
+  if (length > data_.size() - pos_) error("unexpected end of input", 0);
+  strings_.push_back(toUtf16(data_.substr(pos_, length)));
+  pos_ += length;
+  return strings_.back();
+}
+
+const IndexSpace &Reader::read_space() {
+  const std::size_t start = pos_;
+  const std::uint64_t ref = read_varint();
+  if (ref != 0) {
+    if (ref > spaces_.size()) {
+      pos_ = start;
+      error("invalid index space reference");
+    }
+    return spaces_[ref - 1];
+  }
+
+  const std::wstring &key = read_string();
+  try {
+    spaces_.push_back(
+        get_default_context().index_space_registry()->retrieve(key));
+  } catch (const IndexSpace::bad_key &) {
+    throw SerializationError(start, pos_ - start,
+                             "binary deserialization: unknown index space '" +
+                                 toUtf8(key) + "'");
+  }
+  return spaces_.back();
+}
+
+const Index &Reader::read_index() {
+  static const Index null_index;
+
+  const std::size_t start = pos_;
+  const std::uint64_t ref = read_varint();
+  if (ref == null_index_ref) return null_index;
+  if (ref != new_index_ref) {
+    if (ref - 2 >= indices_.size()) {
+      pos_ = start;
+      error("invalid index reference");
+    }
+    return indices_[ref - 2];
+  }
+
+  const IndexSpace space = read_space();
+  const std::uint64_t ordinal = read_varint();
+  const bool symmetric_protos = read_byte() != 0;
+  container::vector<Index> protos = read_indices();
+  try {
+    indices_.push_back(Index(space,
+                             ordinal == 0 ? std::nullopt
+                                          : std::optional<Index::ordinal_type>(
+                                                ordinal - 1),
+                             std::move(protos), symmetric_protos));
+  } catch (const Exception &e) {
+    throw SerializationError(start, pos_ - start,
+                             std::string("invalid index: ") + e.what());
+  }
+  return indices_.back();
+}
+
+container::vector<Index> Reader::read_indices() {
+  const std::uint64_t n = read_varint();
+  if (n > data_.size() - pos_) error("invalid index count");
+  container::vector<Index> result;
+  result.reserve(n);
+  for (std::uint64_t i = 0; i < n; ++i) result.push_back(read_index());
+  return result;
+}
+
+//
+// MappedFile
+//
+
+MappedFile::MappedFile(const std::filesystem::path &path) {
+#ifdef SEQUANT_BINARY_HAS_MMAP
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd >= 0) {
+    struct stat st;
+    if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+      void *addr = ::mmap(nullptr, static_cast<std::size_t>(st.st_size),
+                          PROT_READ, MAP_PRIVATE, fd, 0);
+      if (addr != MAP_FAILED) {
+        data_ = static_cast<const char *>(addr);
+        size_ = static_cast<std::size_t>(st.st_size);
+      }
+    }
+    ::close(fd);
+    if (data_ != nullptr) return;
+  }
+#endif
+
+  std::ifstream in(path, std::ios::binary);
+  if (!in) throw Exception("unable to open '" + path.string() + "'");
+  fallback_.assign(std::istreambuf_iterator<char>(in),
+                   std::istreambuf_iterator<char>());
+  data_ = fallback_.data();
+  size_ = fallback_.size();
+}
+
+MappedFile::~MappedFile() {
+#ifdef SEQUANT_BINARY_HAS_MMAP
+  if (data_ != nullptr && data_ != fallback_.data())
+    ::munmap(const_cast<char *>(data_), size_);
+#endif
+}
+
+//
+// convenience functions
+//
+
+std::string to_binary(const ExprPtr &expr) {
+  std::ostringstream os;
+  Writer(os).write(expr);
+  return std::move(os).str();
+}
+
+std::string to_binary(const ResultExpr &result) {
+  std::ostringstream os;
+  Writer(os).write(result);
+  return std::move(os).str();
+}
+
+template <>
+ExprPtr from_binary<ExprPtr>(std::string_view input) {
+  return Reader(input).read_expr();
+}
+
+template <>
+ResultExpr from_binary<ResultExpr>(std::string_view input) {
+  return Reader(input).read_result();
+}
+
+}  // namespace sequant::io::serialization::binary
@@ -0,0 +1,181 @@
+#ifndef SEQUANT_CORE_IO_SERIALIZATION_BINARY_HPP
+#define SEQUANT_CORE_IO_SERIALIZATION_BINARY_HPP
+
+#include <SeQuant/core/container.hpp>
+#include <SeQuant/core/expr_fwd.hpp>
+#include <SeQuant/core/index.hpp>
+#include <SeQuant/core/io/serialization/serialization.hpp>
+#include <SeQuant/core/space.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <iosfwd>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/// Compact binary representation of expressions.
+///
+/// A binary stream starts with a header (magic bytes and the format version),
+/// followed by any number of documents, each holding either an ExprPtr or a
+/// ResultExpr. The body of a document is a single expression or, for a Sum, a
+/// sequence of terms that can be read back one at a time.
+///
+/// Strings (labels), index spaces and indices are interned: each is written in
+/// full at its first occurrence and referred to by a small integer thereafter.
+/// Integers (counts, references, numerators and denominators of rationals of
+/// any size) are written as LEB128 varints. Index spaces are written by their
+/// base key and resolved through the default Context's IndexSpaceRegistry on
+/// reading, as in the text format.
+namespace sequant::io::serialization::binary {
+
+/// The version of the binary format written by Writer. Reader accepts inputs
+/// of this or any older version.
+inline constexpr std::uint32_t format_version = 1;
+
+/// Writes expressions into the binary format, one document at a time. Terms
+/// of a Sum are written as soon as they are given, so that arbitrarily large
+/// sums can be streamed out with begin_sum() / write_term() / end_sum().
+/// @sa TextWriter, which has the same interface
+class Writer {
+ public:
+  /// \param os the stream to write to; it must outlive this object
+  explicit Writer(std::ostream &os);
+
+  Writer(const Writer &) = delete;
+  Writer &operator=(const Writer &) = delete;
+
+  /// Writes \p expr as an ExprPtr document
+  void write(const ExprPtr &expr);
+
+  /// Writes \p result as a ResultExpr document
+  void write(const ResultExpr &result);
+
+  /// Begins an ExprPtr document holding a Sum whose terms follow via
+  /// write_term()
+  void begin_sum();
+
+  /// Begins a ResultExpr document for \p result (whose expression is
+  /// ignored), holding a Sum whose terms follow via write_term()
+  void begin_sum(const ResultExpr &result);
+
+  /// Writes the next term of the Sum begun by begin_sum()
+  void write_term(const ExprPtr &term);
+
+  /// Ends the Sum begun by begin_sum()
+  void end_sum();
+
+ private:
+  std::ostream *os_;
+  std::string buffer_;
+  bool in_sum_ = false;
+
+  struct IndexHasher {
+    std::size_t operator()(const Index &idx) const;
+  };
+
+  std::unordered_map<std::wstring, std::size_t> strings_;
+  std::unordered_map<std::wstring, std::size_t> spaces_;
+  std::unordered_map<Index, std::size_t, IndexHasher> indices_;
+
+  void flush();
+  void write_result_header(const ResultExpr &result);
+  void write_node(const Expr &expr);
+  void write_string(std::wstring_view str);
+  void write_space(const IndexSpace &space);
+  void write_index(const Index &idx);
+};
+
+/// Reads documents from binary input that is not copied, e.g. a MappedFile.
+/// Expressions are constructed on demand, so the terms of a large Sum can be
+/// processed one at a time (begin_document() / next_term()).
+class Reader {
+ public:
+  /// \param data the binary input; it must outlive this object
+  /// \throw SerializationError if \p data does not start with a valid header
+  explicit Reader(std::string_view data);
+
+  /// \return the format version of the input
+  [[nodiscard]] std::uint32_t version() const { return version_; }
+
+  /// \return whether all documents have been read
+  [[nodiscard]] bool at_end() const;
+
+  /// Begins reading the next document.
+  /// \return for a ResultExpr document its result, with a null expression;
+  /// nullopt for an ExprPtr document
+  std::optional<ResultExpr> begin_document();
+
+  /// \return the next term of the current document; null once the document
+  /// is exhausted. A document not holding a Sum has a single term.
+  ExprPtr next_term();
+
+  /// Reads the next document, which must be an ExprPtr document
+  ExprPtr read_expr();
+
+  /// Reads the next document, which must be a ResultExpr document
+  ResultExpr read_result();
+
+ private:
+  std::string_view data_;
+  std::size_t pos_ = 0;
+  std::uint32_t version_ = 0;
+
+  enum class State { Document, Single, Sum, Done };
+  State state_ = State::Document;
+  bool document_is_sum_ = false;
+
+  std::vector<std::wstring> strings_;
+  std::vector<IndexSpace> spaces_;
+  std::vector<Index> indices_;
+
+  [[noreturn]] void error(std::string message, std::size_t length = 1) const;
+  std::uint8_t read_byte();
+  std::uint64_t read_varint();
+  ExprPtr read_body_expr();
+  ExprPtr read_node();
+  const std::wstring &read_string();
+  const IndexSpace &read_space();
+  const Index &read_index();
+  container::vector<Index> read_indices();
+};
+
+/// A read-only view of a file's contents, memory-mapped where supported
+class MappedFile {
+ public:
+  explicit MappedFile(const std::filesystem::path &path);
+  ~MappedFile();
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  [[nodiscard]] std::string_view data() const { return {data_, size_}; }
+
+ private:
+  const char *data_ = nullptr;
+  std::size_t size_ = 0;
+  std::string fallback_;
+};
+
+/// \return \p expr as a binary stream holding a single document
+[[nodiscard]] std::string to_binary(const ExprPtr &expr);
+
+/// \return \p result as a binary stream holding a single document
+[[nodiscard]] std::string to_binary(const ResultExpr &result);
+
+/// \return the expression held by the first document of binary stream
+/// \p input
+template <typename T = ExprPtr>
+T from_binary(std::string_view input) = delete;
+
+template <>
+ExprPtr from_binary<ExprPtr>(std::string_view input);
+template <>
+ResultExpr from_binary<ResultExpr>(std::string_view input);
+
+}  // namespace sequant::io::serialization::binary
+
+#endif  // SEQUANT_CORE_IO_SERIALIZATION_BINARY_HPP
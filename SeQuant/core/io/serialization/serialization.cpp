@@ -1,8 +1,12 @@
 #include <SeQuant/core/expr.hpp>
 #include <SeQuant/core/io/serialization/serialization.hpp>
 #include <SeQuant/core/utility/macros.hpp>
+#include <SeQuant/core/utility/string.hpp>
 
+#include <ostream>
+#include <string>
 #include <string_view>
+#include <utility>
 
 namespace sequant::io::serialization {
 
@@ -50,4 +54,78 @@ SEQUANT_RESOLVE_SERIALIZE_FUNC(NormalOperator<Statistics::FermiDirac>)
 #undef SEQUANT_RESOLVE_SERIALIZE_FUNC
 #undef SEQUANT_RESOLVE_DESERIALIZATION_FUNC
 
+TextWriter::TextWriter(std::ostream &os, SerializationOptions options)
+    : os_(&os), options_(std::move(options)) {}
+
+void TextWriter::put(std::wstring_view text) {
+  const std::string utf8 = toUtf8(text);
+  os_->write(utf8.data(), static_cast<std::streamsize>(utf8.size()));
+}
+
+void TextWriter::write(const ExprPtr &expr) {
+  SEQUANT_ASSERT(!in_sum_);
+  if (expr && expr->is<Sum>()) {
+    begin_sum();
+    for (const ExprPtr &term : expr->as<Sum>().summands()) write_term(term);
+    end_sum();
+    return;
+  }
+
+  put(to_string(expr, options_));
+  put(L"\n");
+}
+
+void TextWriter::write(const ResultExpr &result) {
+  SEQUANT_ASSERT(!in_sum_);
+  const ExprPtr &expr = result.expression();
+  if (expr && expr->is<Sum>()) {
+    begin_sum(result);
+    for (const ExprPtr &term : expr->as<Sum>().summands()) write_term(term);
+    end_sum();
+    return;
+  }
+
+  put(to_string(result, options_));
+  put(L"\n");
+}
+
+void TextWriter::begin_sum() {
+  SEQUANT_ASSERT(!in_sum_);
+  in_sum_ = true;
+  first_term_ = true;
+}
+
+void TextWriter::begin_sum(const ResultExpr &result) {
+  begin_sum();
+  // the left-hand side followed by " = "
+  ResultExpr lhs = result;
+  lhs.expression() = nullptr;
+  put(to_string(lhs, options_));
+}
+
+void TextWriter::write_term(const ExprPtr &term) {
+  SEQUANT_ASSERT(in_sum_);
+  SEQUANT_ASSERT(term);
+  // N.B. mirrors the serialization of the terms of a Sum
+  std::wstring serialized = to_string(term, options_);
+  if (term->is<Sum>()) serialized = L"(" + serialized + L")";
+
+  if (first_term_) {
+    put(serialized);
+    first_term_ = false;
+  } else if (serialized.front() == L'-') {
+    put(L" - ");
+    put(std::wstring_view(serialized).substr(1));
+  } else {
+    put(L" + ");
+    put(serialized);
+  }
+}
+
+void TextWriter::end_sum() {
+  SEQUANT_ASSERT(in_sum_);
+  put(L"\n");
+  in_sum_ = false;
+}
+
 }  // namespace sequant::io::serialization
@@ -7,6 +7,8 @@
 #include <SeQuant/core/op.hpp>
 #include <SeQuant/core/utility/exception.hpp>
 
+#include <cstddef>
+#include <iosfwd>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -51,6 +53,15 @@ struct DeserializationOptions {
   std::optional<ColumnSymmetry> def_col_symm = std::nullopt;
   /// The expected syntax version of the input
   SerializationSyntax syntax = SerializationSyntax::Latest;
+  /// If nonzero, the input is split at the +/- separating the terms of its
+  /// top-level sum into chunks of (at least) this many characters, which are
+  /// deserialized concurrently (see num_threads()). The result is the same as
+  /// that of deserializing the input as a whole.
+  std::size_t parallel_chunk_size = 0;
+  /// Whether to canonicalize every term as soon as it has been deserialized
+  /// and to combine terms that only differ in their scalar prefactor. Terms
+  /// are ordered by their first occurrence in the input.
+  bool canonicalize_terms = false;
 };
 
 struct SerializationOptions {
@@ -119,6 +130,51 @@ SEQUANT_DECLARE_DESERIALIZATION_FUNC_SPECIALIZATION(ResultExpr);
 /// \return wstring of the expression.
 SEQUANT_DECLARE_SERIALIZATION_FUNC
 
+/// Writes expressions in their textual representation (see to_string()) to a
+/// stream, encoded as UTF-8, one expression per line. The terms of a Sum are
+/// serialized and written one at a time, so the memory needed is bounded by
+/// the largest term rather than by the whole expression, and arbitrarily large
+/// sums can be streamed out via begin_sum() / write_term() / end_sum().
+///
+/// @note this has the same interface as binary::Writer, so either can be used
+/// to stream out expressions
+class TextWriter {
+ public:
+  /// \param os the stream to write to; it must outlive this object
+  /// \param options customization options
+  explicit TextWriter(std::ostream &os, SerializationOptions options = {});
+
+  TextWriter(const TextWriter &) = delete;
+  TextWriter &operator=(const TextWriter &) = delete;
+
+  /// Writes \p expr
+  void write(const ExprPtr &expr);
+
+  /// Writes \p result
+  void write(const ResultExpr &result);
+
+  /// Begins a Sum whose terms follow via write_term()
+  void begin_sum();
+
+  /// Begins the result \p result (whose expression is ignored), whose
+  /// expression is a Sum whose terms follow via write_term()
+  void begin_sum(const ResultExpr &result);
+
+  /// Writes the next term of the Sum begun by begin_sum()
+  void write_term(const ExprPtr &term);
+
+  /// Ends the Sum begun by begin_sum()
+  void end_sum();
+
+ private:
+  std::ostream *os_;
+  SerializationOptions options_;
+  bool in_sum_ = false;
+  bool first_term_ = true;
+
+  void put(std::wstring_view text);
+};
+
 // Versioned variants
 namespace v1 {
 SEQUANT_DECLARE_DESERIALIZATION_FUNC;
@@ -10,6 +10,7 @@
 #include <SeQuant/core/io/serialization/v1/ast.hpp>
 #include <SeQuant/core/io/serialization/v1/ast_conversions.hpp>
 #include <SeQuant/core/io/serialization/v1/semantic_actions.hpp>
+#include <SeQuant/core/runtime.hpp>
 #include <SeQuant/core/space.hpp>
 
 #define BOOST_SPIRIT_X3_UNICODE
@@ -21,11 +22,17 @@
 #include <algorithm>
 #include <cassert>
 #include <cstddef>
+#include <cwctype>
+#include <exception>
 #include <functional>
 #include <iterator>
+#include <limits>
+#include <mutex>
+#include <numeric>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -273,25 +280,300 @@ transform::DefaultSymmetries to_default_symms(
   return symms;
 }
 
-#define SEQUANT_DESERIALIZATION_SPECIALIZATION(ExprType, StartRule, ASTType, \
-                                               transformFunc)                \
-  template <>                                                                \
-  ExprType from_string<ExprType>(std::wstring_view input,                    \
-                                 const DeserializationOptions &options) {    \
-    using iterator_type = decltype(input)::iterator;                         \
-    x3::position_cache<std::vector<iterator_type>> positions(input.begin(),  \
-                                                             input.end());   \
-    auto ast = parse::parse<ASTType>(StartRule, input, positions);           \
-                                                                             \
-    return transformFunc(ast, positions, input.begin(),                      \
-                         to_default_symms(options));                         \
+#define SEQUANT_DESERIALIZATION_FUNC(ExprType, StartRule, ASTType,          \
+                                     transformFunc)                         \
+  ExprType deserialize_##ExprType(std::wstring_view input,                  \
+                                  const DeserializationOptions &options) {  \
+    using iterator_type = decltype(input)::iterator;                        \
+    x3::position_cache<std::vector<iterator_type>> positions(input.begin(), \
+                                                             input.end());  \
+    auto ast = parse::parse<ASTType>(StartRule, input, positions);          \
+                                                                            \
+    return transformFunc(ast, positions, input.begin(),                     \
+                         to_default_symms(options));                        \
   }
 
-SEQUANT_DESERIALIZATION_SPECIALIZATION(ResultExpr, parse::resultExpr,
-                                       ast::ResultExpr,
-                                       transform::ast_to_result)
-SEQUANT_DESERIALIZATION_SPECIALIZATION(ExprPtr, parse::expr, ast::Sum,
-                                       transform::ast_to_expr)
+namespace {
+
+SEQUANT_DESERIALIZATION_FUNC(ResultExpr, parse::resultExpr, ast::ResultExpr,
+                             transform::ast_to_result)
+SEQUANT_DESERIALIZATION_FUNC(ExprPtr, parse::expr, ast::Sum,
+                             transform::ast_to_expr)
+
+}  // namespace
+
+namespace chunked {
+
+/// @return whether \p options ask for the input to be deserialized in chunks
+bool enabled(const DeserializationOptions &options) {
+  return options.parallel_chunk_size > 0 || options.canonicalize_terms;
+}
+
+/// @return the offsets at which \p input is split into chunks of at least
+/// \p chunk_size characters, each holding whole terms of the top-level sum;
+/// the first offset is 0
+std::vector<std::size_t> chunk_offsets(std::wstring_view input,
+                                       std::size_t chunk_size) {
+  std::vector<std::size_t> offsets{0};
+  int depth = 0;
+  // whether the current chunk contains the beginning of a term
+  bool in_term = false;
+
+  for (std::size_t i = 0; i < input.size(); ++i) {
+    const wchar_t c = input[i];
+    switch (c) {
+      case L'(':
+      case L'{':
+      case L'<':
+        ++depth;
+        break;
+      case L')':
+      case L'}':
+      case L'>':
+        --depth;
+        break;
+      case L':':
+        // symmetry annotation, e.g. :A-N-S
+        if (i + 1 < input.size() && std::iswupper(input[i + 1])) {
+          ++i;
+          for (int k = 0; k < 2 && i + 2 < input.size() &&
+                          input[i + 1] == L'-' && std::iswupper(input[i + 2]);
+               ++k)
+            i += 2;
+        }
+        break;
+      case L'+':
+      case L'-': {
+        // a sign immediately followed by a number is parsed as part of that
+        // number, i.e. as a factor of the current term
+        const bool signs_number =
+            i + 1 < input.size() &&
+            (std::iswdigit(input[i + 1]) || input[i + 1] == L'.');
+        if (depth == 0 && in_term && !signs_number &&
+            i - offsets.back() >= chunk_size) {
+          offsets.push_back(i);
+          in_term = false;
+        }
+        continue;
+      }
+      default:
+        break;
+    }
+    if (!std::iswspace(c)) in_term = true;
+  }
+
+  return offsets;
+}
+
+/// @return the offset of the right-hand side of the ResultExpr \p input,
+/// unless its left-hand side is not followed by = or ->
+std::optional<std::size_t> rhs_offset(std::wstring_view input) {
+  int depth = 0;
+  for (std::size_t i = 0; i < input.size(); ++i) {
+    switch (input[i]) {
+      case L'(':
+      case L'{':
+      case L'<':
+        ++depth;
+        break;
+      case L')':
+      case L'}':
+      case L'>':
+        --depth;
+        break;
+      case L'=':
+        if (depth == 0) return i + 1;
+        break;
+      case L'-':
+        if (depth == 0 && i + 1 < input.size() && input[i + 1] == L'>')
+          return i + 2;
+        break;
+      default:
+        break;
+    }
+  }
+  return std::nullopt;
+}
+
+/// Combines terms that only differ in their scalar prefactor. Terms are
+/// distributed over independently locked shards by the hash of their
+/// nonscalar factors, so that concurrent insertions rarely contend.
+class TermAccumulator {
+ public:
+  /// the position of a term in the input: chunk and index within the chunk
+  using Position = std::pair<std::size_t, std::size_t>;
+
+  explicit TermAccumulator(std::size_t nshards) : shards_(nshards) {}
+
+  void add(const ExprPtr &term, Position position) {
+    Constant::scalar_type scalar{1};
+    container::svector<ExprPtr> factors;
+    if (term->is<Constant>()) {
+      scalar = term->as<Constant>().value();
+    } else if (term->is<Product>()) {
+      const auto &product = term->as<Product>();
+      scalar = product.scalar();
+      factors.assign(product.factors().begin(), product.factors().end());
+    } else {
+      factors.push_back(term);
+    }
+
+    std::size_t hash = factors.size();
+    for (const ExprPtr &factor : factors)
+      hash::combine(hash, factor->hash_value());
+
+    Shard &shard = shards_[hash % shards_.size()];
+    std::scoped_lock lock(shard.mutex);
+    auto [begin, end] = shard.entries.equal_range(hash);
+    for (auto it = begin; it != end; ++it) {
+      Entry &entry = it->second;
+      if (std::equal(
+              entry.factors.begin(), entry.factors.end(), factors.begin(),
+              factors.end(),
+              [](const ExprPtr &a, const ExprPtr &b) { return *a == *b; })) {
+        entry.scalar += scalar;
+        entry.position = std::min(entry.position, position);
+        return;
+      }
+    }
+    shard.entries.emplace(hash, Entry{position, std::move(scalar),
+                                      std::move(factors)});
+  }
+
+  /// @return the sum of the accumulated terms, ordered by their first
+  /// occurrence
+  ExprPtr result() {
+    std::vector<Entry *> entries;
+    for (Shard &shard : shards_)
+      for (auto &[hash, entry] : shard.entries)
+        if (!entry.scalar.is_zero()) entries.push_back(&entry);
+    std::sort(entries.begin(), entries.end(),
+              [](const Entry *a, const Entry *b) {
+                return a->position < b->position;
+              });
+
+    std::vector<ExprPtr> terms;
+    terms.reserve(entries.size());
+    for (Entry *entry : entries) {
+      if (entry->factors.empty())
+        terms.push_back(ex<Constant>(std::move(entry->scalar)));
+      else if (entry->factors.size() == 1 && entry->scalar == 1)
+        terms.push_back(std::move(entry->factors.front()));
+      else
+        terms.push_back(ex<Product>(std::move(entry->scalar),
+                                    std::move(entry->factors),
+                                    Product::Flatten::No));
+    }
+
+    if (terms.empty()) return ex<Constant>(0);
+    if (terms.size() == 1) return std::move(terms.front());
+    return ex<Sum>(std::move(terms));
+  }
+
+ private:
+  struct Entry {
+    Position position;
+    Constant::scalar_type scalar;
+    container::svector<ExprPtr> factors;
+  };
+  struct Shard {
+    std::mutex mutex;
+    std::unordered_multimap<std::size_t, Entry> entries;
+  };
+  std::vector<Shard> shards_;
+};
+
+/// Deserializes the sum \p input, found at \p offset in the original input,
+/// in chunks
+ExprPtr deserialize_sum(std::wstring_view input, std::size_t offset,
+                        const DeserializationOptions &options) {
+  const std::vector<std::size_t> offsets = chunk_offsets(
+      input, options.parallel_chunk_size > 0
+                 ? options.parallel_chunk_size
+                 : std::numeric_limits<std::size_t>::max());
+  const std::size_t nchunks = offsets.size();
+
+  std::vector<ExprPtr> results(nchunks);
+  std::vector<std::exception_ptr> errors(nchunks);
+  std::optional<TermAccumulator> accumulator;
+  if (options.canonicalize_terms)
+    accumulator.emplace(4 * static_cast<std::size_t>(num_threads()));
+
+  std::vector<std::size_t> chunks(nchunks);
+  std::iota(chunks.begin(), chunks.end(), 0);
+  sequant::for_each(chunks, [&](std::size_t chunk) {
+    const std::size_t begin = offsets[chunk];
+    const std::size_t end =
+        chunk + 1 < nchunks ? offsets[chunk + 1] : input.size();
+    try {
+      ExprPtr expr =
+          deserialize_ExprPtr(input.substr(begin, end - begin), options);
+      if (!accumulator || !expr) {
+        results[chunk] = std::move(expr);
+        return;
+      }
+
+      std::size_t index = 0;
+      auto accumulate = [&](ExprPtr term) {
+        canonicalize(term);
+        if (term->is<Sum>()) {
+          for (const ExprPtr &summand : term->as<Sum>().summands())
+            accumulator->add(summand, {chunk, index++});
+        } else {
+          accumulator->add(term, {chunk, index++});
+        }
+      };
+      if (expr->is<Sum>()) {
+        for (const ExprPtr &term : expr->as<Sum>().summands())
+          accumulate(term);
+      } else {
+        accumulate(std::move(expr));
+      }
+    } catch (const SerializationError &e) {
+      errors[chunk] = std::make_exception_ptr(SerializationError(
+          offset + begin + e.offset, e.length, e.what()));
+    } catch (...) {
+      errors[chunk] = std::current_exception();
+    }
+  });
+
+  for (const std::exception_ptr &error : errors)
+    if (error) std::rethrow_exception(error);
+
+  if (accumulator) return accumulator->result();
+
+  std::erase_if(results, [](const ExprPtr &expr) { return !expr; });
+  if (results.empty()) return {};
+  if (results.size() == 1) return std::move(results.front());
+  return ex<Sum>(std::move(results));
+}
+
+}  // namespace chunked
+
+template <>
+ResultExpr from_string<ResultExpr>(std::wstring_view input,
+                                   const DeserializationOptions &options) {
+  if (!chunked::enabled(options))
+    return deserialize_ResultExpr(input, options);
+
+  const std::optional<std::size_t> rhs = chunked::rhs_offset(input);
+  if (!rhs.has_value()) {
+    // let the parser report the malformed input
+    return deserialize_ResultExpr(input, options);
+  }
+
+  ResultExpr result = deserialize_ResultExpr(input.substr(0, *rhs), options);
+  result = chunked::deserialize_sum(input.substr(*rhs), *rhs, options);
+  return result;
+}
+
+template <>
+ExprPtr from_string<ExprPtr>(std::wstring_view input,
+                             const DeserializationOptions &options) {
+  if (!chunked::enabled(options)) return deserialize_ExprPtr(input, options);
+
+  return chunked::deserialize_sum(input, 0, options);
+}
 
 template <>
 ResultExpr from_string<ResultExpr>(std::string_view input,
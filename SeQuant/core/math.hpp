@@ -10,6 +10,7 @@
 
 #include <atomic>
 #include <cstddef>
+#include <limits>
 
 namespace sequant {
 
@@ -18,6 +19,20 @@ constexpr std::size_t pow2(std::size_t n) {
   return 1ul << n;
 }
 
+/// @return `a + b`, or `std::numeric_limits<std::size_t>::max()` if the sum
+/// overflows
+constexpr std::size_t saturating_add(std::size_t a, std::size_t b) {
+  constexpr auto max = std::numeric_limits<std::size_t>::max();
+  return a > max - b ? max : a + b;
+}
+
+/// @return `a * b`, or `std::numeric_limits<std::size_t>::max()` if the
+/// product overflows
+constexpr std::size_t saturating_mul(std::size_t a, std::size_t b) {
+  constexpr auto max = std::numeric_limits<std::size_t>::max();
+  return b != 0 && a > max / b ? max : a * b;
+}
+
 /// Returns the factorial of `n`
 
 /// @param n the argument; there is no practical limit on the supported
@@ -7,6 +7,7 @@
 #include <SeQuant/core/eval/eval_node.hpp>
 #include <SeQuant/core/eval/eval_node_compare.hpp>
 #include <SeQuant/core/expr.hpp>
+#include <SeQuant/core/optimize/cse_cost_model.hpp>
 #include <SeQuant/core/utility/macros.hpp>
 #include <SeQuant/core/utility/string.hpp>
 
@@ -227,12 +228,9 @@ class SubexpressionReplacer {
 
 template <typename TreeNode>
 struct CSEOptions {
-  // TODO: provide predicate that computes the FLOPs required to compute the CSE
-  // and compares that with the expected speed for reading the CSE from disk.
-  // Use typical FLOPs/s and I/O rates from e.g. https://ssd.userbenchmark.com/
-  // https://openbenchmarking.org/test/pts/mt-dgemm
-  // to determine whether or not pre-computing the CSE is worth it.
-  // Note: of course the number of reusages of the CSE plays into this.
+  /// Decides whether a given subexpression, used the given number of times,
+  /// shall be eliminated. Use CSECostModel to only eliminate subexpressions
+  /// for which this is expected to pay off.
   std::function<bool(const TreeNode &, std::size_t)> filter_predicate =
       [](const TreeNode &, std::size_t) { return true; };
   std::function<std::string(const TreeNode &, std::size_t)> label_gen =
@@ -0,0 +1,98 @@
+#include <SeQuant/core/optimize/cse_cost_model.hpp>
+#include <SeQuant/core/utility/exception.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace sequant::opt {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double seconds_since(Clock::time_point start) {
+  return std::max(std::chrono::duration<double>(Clock::now() - start).count(),
+                  1e-9);
+}
+
+/// @returns the FLOP rate of a plain matrix multiplication
+double measure_flops_per_second() {
+  constexpr std::size_t n = 256;
+  constexpr std::size_t repetitions = 4;
+
+  std::vector<double> a(n * n, 1.0);
+  std::vector<double> b(n * n, 0.5);
+  std::vector<double> c(n * n, 0.0);
+
+  const auto start = Clock::now();
+  for (std::size_t rep = 0; rep < repetitions; ++rep) {
+    // i-k-j loop order keeps the innermost loop contiguous for all operands
+    for (std::size_t i = 0; i < n; ++i) {
+      for (std::size_t k = 0; k < n; ++k) {
+        const double aik = a[i * n + k];
+        for (std::size_t j = 0; j < n; ++j) {
+          c[i * n + j] += aik * b[k * n + j];
+        }
+      }
+    }
+  }
+  const double elapsed = seconds_since(start);
+
+  // make sure the computation can't be optimized away
+  if (c[0] != 0.5 * static_cast<double>(n * repetitions)) {
+    throw Exception("CSECostModel::calibrate: matrix multiplication failed");
+  }
+
+  return 2.0 * static_cast<double>(n * n * n * repetitions) / elapsed;
+}
+
+}  // namespace
+
+CSECostModel CSECostModel::calibrate(const std::filesystem::path &scratch_dir) {
+  CSECostModel model;
+
+  model.flops_per_second = measure_flops_per_second();
+
+  constexpr std::size_t num_bytes = std::size_t{64} << 20;
+  const std::vector<char> data(num_bytes, 'x');
+  const std::filesystem::path file =
+      scratch_dir / "sequant_cse_cost_model_calibration.bin";
+
+  {
+    const auto start = Clock::now();
+    std::ofstream out(file, std::ios::binary);
+    out.write(data.data(), static_cast<std::streamsize>(data.size()));
+    out.close();
+    if (!out) {
+      throw Exception("CSECostModel::calibrate: unable to write to '" +
+                      file.string() + "'");
+    }
+    model.write_bandwidth =
+        static_cast<double>(num_bytes) / seconds_since(start);
+  }
+
+  {
+    std::vector<char> buffer(num_bytes);
+    const auto start = Clock::now();
+    std::ifstream in(file, std::ios::binary);
+    in.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    if (!in) {
+      throw Exception("CSECostModel::calibrate: unable to read from '" +
+                      file.string() + "'");
+    }
+    model.read_bandwidth =
+        static_cast<double>(num_bytes) / seconds_since(start);
+  }
+
+  std::error_code ec;
+  std::filesystem::remove(file, ec);
+
+  return model;
+}
+
+}  // namespace sequant::opt
@@ -0,0 +1,105 @@
+#ifndef SEQUANT_CORE_OPTIMIZE_CSE_COST_MODEL_HPP
+#define SEQUANT_CORE_OPTIMIZE_CSE_COST_MODEL_HPP
+
+#include <SeQuant/core/asy_cost.hpp>
+#include <SeQuant/core/eval/eval_node.hpp>
+
+#include <cstddef>
+#include <filesystem>
+#include <limits>
+
+namespace sequant::opt {
+
+/// Cost model deciding whether eliminating a common subexpression (CSE) pays
+/// off. Meant to be used as CSEOptions::filter_predicate for evaluation as
+/// well as export trees.
+///
+/// Eliminating a subexpression that is used @c n times means computing it
+/// once, writing its result to storage and reading it back @c n times instead
+/// of computing it @c n times. Hence, the subexpression is eliminated iff
+/// @code
+/// (n - 1) * t_compute > t_write + n * t_read
+/// @endcode
+/// where @c t_compute follows from the FLOPs needed to evaluate the
+/// subexpression (including its children) and @c t_write and @c t_read follow
+/// from the storage size of its result. Subexpressions whose result is larger
+/// than @c max_elements are never eliminated as keeping them around would
+/// raise the peak memory footprint too much.
+///
+/// The defaults describe a single core running an optimized DGEMM and a
+/// commodity NVMe SSD. Use calibrate() to obtain values for the local machine.
+struct CSECostModel {
+  /// Sustained floating-point throughput in FLOP/s
+  double flops_per_second = 1e10;
+  /// Sustained bandwidth in bytes/s for storing the result of a CSE
+  double write_bandwidth = 1e9;
+  /// Sustained bandwidth in bytes/s for reading the result of a CSE
+  double read_bandwidth = 2e9;
+  /// Size of a single tensor element in bytes
+  std::size_t element_size = sizeof(double);
+  /// The largest number of elements the result of a CSE may have
+  double max_elements = std::numeric_limits<double>::infinity();
+  /// Subexpressions that are used fewer times are never eliminated
+  std::size_t min_usage = 2;
+  /// Extents of index spaces. Spaces not listed here use their
+  /// IndexSpace::approximate_size()
+  AsyCost::ExtentMap extents = {};
+
+  /// Determines flops_per_second, write_bandwidth and read_bandwidth by
+  /// running small microbenchmarks on the local machine. All other members
+  /// retain their default values.
+  /// @param scratch_dir Directory in which a temporary file is written in order
+  /// to measure I/O bandwidths
+  /// @note The FLOP rate is measured with a simple (though cache-friendly)
+  /// matrix multiplication and hence underestimates what optimized BLAS
+  /// libraries achieve. The read bandwidth is typically dominated by the OS's
+  /// page cache.
+  static CSECostModel calibrate(const std::filesystem::path &scratch_dir =
+                                    std::filesystem::temp_directory_path());
+
+  /// @returns The number of FLOPs required to evaluate the given tree
+  template <meta::eval_node TreeNode>
+  double flops(const TreeNode &tree) const {
+    return asy_cost(tree, Flops{}).ops(extents);
+  }
+
+  /// @returns The number of elements of the result of the given tree
+  template <meta::eval_node TreeNode>
+  double elements(const TreeNode &tree) const {
+    if (!tree->is_tensor()) {
+      return 1;
+    }
+
+    return AsyCost{detail::space_counts(tree->as_tensor())}.ops(extents);
+  }
+
+  /// @returns Whether the subexpression represented by the given tree shall be
+  /// eliminated given that it is used @p usage_count times
+  template <meta::eval_node TreeNode>
+  bool operator()(const TreeNode &tree, std::size_t usage_count) const {
+    if (usage_count < min_usage || usage_count < 2) {
+      return false;
+    }
+
+    const double compute_time = flops(tree) / flops_per_second;
+    if (compute_time <= 0) {
+      return false;
+    }
+
+    const double num_elements = elements(tree);
+    if (num_elements > max_elements) {
+      return false;
+    }
+
+    const double bytes = num_elements * static_cast<double>(element_size);
+    const double write_time = bytes / write_bandwidth;
+    const double read_time = bytes / read_bandwidth;
+
+    return static_cast<double>(usage_count - 1) * compute_time >
+           write_time + static_cast<double>(usage_count) * read_time;
+  }
+};
+
+}  // namespace sequant::opt
+
+#endif  // SEQUANT_CORE_OPTIMIZE_CSE_COST_MODEL_HPP
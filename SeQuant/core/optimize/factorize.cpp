@@ -0,0 +1,336 @@
+#include <SeQuant/core/optimize/factorize.hpp>
+
+#include <SeQuant/core/container.hpp>
+#include <SeQuant/core/expr.hpp>
+#include <SeQuant/core/index.hpp>
+#include <SeQuant/core/optimize/optimize.hpp>
+#include <SeQuant/core/runtime.hpp>
+#include <SeQuant/core/utility/indices.hpp>
+
+#include <range/v3/view/iota.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <optional>
+#include <utility>
+
+namespace sequant::opt {
+
+namespace {
+
+using index_set = container::svector<Index>;
+
+/// \return Sorted free indices of \p expr.
+index_set free_indices(ExprPtr const& expr) {
+  auto groups = get_unique_indices<index_set>(expr);
+  index_set result;
+  result.reserve(groups.bra.size() + groups.ket.size() + groups.aux.size());
+  for (auto const* g : {&groups.bra, &groups.ket, &groups.aux})
+    result.insert(result.end(), g->begin(), g->end());
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+index_set set_union(index_set const& lhs, index_set const& rhs) {
+  index_set result;
+  std::set_union(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+                 std::back_inserter(result));
+  return result;
+}
+
+index_set set_symmetric_difference(index_set const& lhs,
+                                   index_set const& rhs) {
+  index_set result;
+  std::set_symmetric_difference(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+                                std::back_inserter(result));
+  return result;
+}
+
+double extent_product(index_set const& idxs,
+                      index_to_extent_t const& idx_to_extent) {
+  double result = 1;
+  for (auto const& ix : idxs) result *= static_cast<double>(idx_to_extent(ix));
+  return result;
+}
+
+double flops_impl(ExprPtr const& expr, index_to_extent_t const& idx_to_extent) {
+  if (expr->is<Sum>()) {
+    auto const& sum = expr->as<Sum>();
+    double result = 0;
+    for (auto const& s : sum.summands()) result += flops_impl(s, idx_to_extent);
+    if (sum.size() > 1)
+      result += static_cast<double>(sum.size() - 1) *
+                extent_product(free_indices(expr), idx_to_extent);
+    return result;
+  }
+
+  if (expr->is<Product>()) {
+    double result = 0;
+    // free indices of the factors contracted so far
+    std::optional<index_set> partial;
+    for (auto const& f : expr->as<Product>()) {
+      result += flops_impl(f, idx_to_extent);
+      auto idxs = free_indices(f);
+      if (idxs.empty()) continue;  // scaling is not counted
+      if (!partial) {
+        partial = std::move(idxs);
+        continue;
+      }
+      result += extent_product(set_union(*partial, idxs), idx_to_extent);
+      partial = set_symmetric_difference(*partial, idxs);
+    }
+    return result;
+  }
+
+  return 0;
+}
+
+/// A summand of a sum being factorized.
+struct Term {
+  /// True if the term is a product of the tensors in \c factors scaled by
+  /// \c scalar, and thus a candidate for factorization.
+  bool factorizable = false;
+  Product::scalar_type scalar = {1, 0};
+  container::svector<ExprPtr> factors;
+
+  /// Operation counts of the optimized remainders of the term without each of
+  /// its factors, computed on demand.
+  container::svector<std::optional<double>> remainder_flops;
+
+  /// The (optimized) expression evaluating the term, and its operation count.
+  ExprPtr expr;
+  double flops = 0;
+};
+
+/// A group of factorizable terms sharing a tensor factor whose remainders
+/// have identical free indices.
+struct Candidate {
+  ExprPtr factor;
+  index_set signature;
+  /// Positions of the terms, and of the factor in each of them.
+  container::svector<std::size_t> terms;
+  container::svector<std::size_t> positions;
+};
+
+/// Collects the scalar and the tensor factors of \p expr into \p term.
+/// \return False if \p expr is not a (nested) product of tensors.
+bool collect_factors(ExprPtr const& expr, Term& term) {
+  if (expr->is<Tensor>()) {
+    term.factors.push_back(expr);
+    return true;
+  }
+  if (expr->is<Product>()) {
+    auto const& prod = expr->as<Product>();
+    term.scalar *= prod.scalar();
+    for (auto const& f : prod)
+      if (!collect_factors(f, term)) return false;
+    return true;
+  }
+  return false;
+}
+
+class Factorizer {
+ public:
+  explicit Factorizer(OptimizeOptions const& opts) : opts_{opts} {
+    opts_.reorder = ReorderSum::NoReorder;
+    opts_.factorize = FactorizeSum::NoFactorize;
+  }
+
+  double flops(ExprPtr const& expr) const {
+    return flops_impl(expr, opts_.idx_to_extent);
+  }
+
+  /// \return \p summand as a single-term optimized Term.
+  Term make_term(ExprPtr const& summand) const {
+    Term result;
+    if (collect_factors(summand, result)) {
+      result.factorizable = true;
+      result.remainder_flops.resize(result.factors.size());
+      optimize_term(result);
+    } else {
+      result = Term{};
+      result.expr = optimize(summand, opts_);
+      result.flops = flops(result.expr);
+    }
+    return result;
+  }
+
+  /// Greedily factorizes \p terms until no factorization reduces the
+  /// operation count.
+  /// \return The expression evaluating the sum of \p terms.
+  ExprPtr factorize(container::svector<Term> terms) const {
+    while (auto best = best_candidate(terms)) apply(*best, terms);
+
+    if (terms.size() == 1) return terms.front().expr;
+    Sum::summands_type summands;
+    summands.reserve(terms.size());
+    for (auto& t : terms) summands.emplace_back(std::move(t.expr));
+    return ex<Sum>(std::move(summands), Sum::move_only_tag{});
+  }
+
+ private:
+  OptimizeOptions opts_;
+
+  /// Single-term optimizes the product of the factors of \p term.
+  void optimize_term(Term& term) const {
+    if (term.factors.empty()) {
+      term.expr = ex<Constant>(term.scalar);
+      term.flops = 0;
+    } else if (term.factors.size() == 1 && term.scalar == 1) {
+      term.expr = term.factors.front()->clone();
+      term.flops = 0;
+    } else {
+      auto prod = ex<Product>(term.scalar, term.factors.begin(),
+                              term.factors.end(), Product::Flatten::No);
+      term.expr = optimize(prod, opts_);
+      term.flops = flops(term.expr);
+    }
+  }
+
+  /// \return Term \p term without its factor at \p pos, single-term optimized.
+  Term remainder(Term const& term, std::size_t pos) const {
+    Term result;
+    result.factorizable = true;
+    result.scalar = term.scalar;
+    result.factors.reserve(term.factors.size() - 1);
+    for (std::size_t i = 0; i < term.factors.size(); ++i)
+      if (i != pos) result.factors.push_back(term.factors[i]);
+    result.remainder_flops.resize(result.factors.size());
+    optimize_term(result);
+    return result;
+  }
+
+  container::svector<Candidate> candidates(
+      container::svector<Term> const& terms) const {
+    container::svector<Candidate> result;
+    for (std::size_t t = 0; t < terms.size(); ++t) {
+      auto const& term = terms[t];
+      if (!term.factorizable) continue;
+      for (std::size_t p = 0; p < term.factors.size(); ++p) {
+        auto const& factor = term.factors[p];
+        // a factor repeated within a term is only extracted once
+        auto first = std::find_if(
+            term.factors.begin(), term.factors.end(),
+            [&factor](ExprPtr const& f) { return *f == *factor; });
+        if (first != term.factors.begin() + p) continue;
+
+        container::svector<ExprPtr> rest;
+        for (std::size_t i = 0; i < term.factors.size(); ++i)
+          if (i != p) rest.push_back(term.factors[i]);
+        auto signature = free_indices(
+            ex<Product>(rest.begin(), rest.end(), Product::Flatten::No));
+
+        auto it = std::find_if(result.begin(), result.end(),
+                               [&factor, &signature](Candidate const& c) {
+                                 return *c.factor == *factor &&
+                                        c.signature == signature;
+                               });
+        if (it == result.end()) {
+          result.push_back(Candidate{factor, std::move(signature), {}, {}});
+          it = std::prev(result.end());
+        }
+        it->terms.push_back(t);
+        it->positions.push_back(p);
+      }
+    }
+    return result;
+  }
+
+  /// \return The candidate whose factorization saves the most operations, if
+  ///         any saves operations at all.
+  std::optional<Candidate> best_candidate(
+      container::svector<Term>& terms) const {
+    if (terms.size() < 2) return std::nullopt;
+
+    // all terms have the same free indices
+    double const sum_size =
+        extent_product(free_indices(terms.front().expr), opts_.idx_to_extent);
+
+    std::optional<Candidate> best;
+    double best_gain = 0;
+    for (auto& c : candidates(terms)) {
+      auto const k = c.terms.size();
+      if (k < 2) continue;
+
+      double before = static_cast<double>(k - 1) * sum_size;
+      double after =
+          static_cast<double>(k - 1) *
+              extent_product(c.signature, opts_.idx_to_extent) +
+          extent_product(set_union(free_indices(c.factor), c.signature),
+                         opts_.idx_to_extent);
+      for (std::size_t i = 0; i < k; ++i) {
+        auto& term = terms[c.terms[i]];
+        auto& rest = term.remainder_flops[c.positions[i]];
+        if (!rest) rest = remainder(term, c.positions[i]).flops;
+        before += term.flops;
+        after += *rest;
+      }
+
+      if (before - after > best_gain) {
+        best_gain = before - after;
+        best = std::move(c);
+      }
+    }
+    return best;
+  }
+
+  /// Replaces the terms of \p c in \p terms by the product of the common
+  /// factor and the (factorized) sum of the remainders.
+  void apply(Candidate const& c, container::svector<Term>& terms) const {
+    container::svector<Term> remainders;
+    remainders.reserve(c.terms.size());
+    for (std::size_t i = 0; i < c.terms.size(); ++i)
+      remainders.push_back(remainder(terms[c.terms[i]], c.positions[i]));
+
+    Term fused;
+    fused.expr = ex<Product>(
+        1, ExprPtrList{c.factor->clone(), factorize(std::move(remainders))},
+        Product::Flatten::No);
+    fused.flops = flops(fused.expr);
+
+    terms[c.terms.front()] = std::move(fused);
+    // c.terms is increasing, erase from the back
+    for (auto it = c.terms.rbegin(); it != std::prev(c.terms.rend()); ++it)
+      terms.erase(terms.begin() + *it);
+  }
+};
+
+}  // namespace
+
+double evaluation_flops(ExprPtr const& expr,
+                        index_to_extent_t const& idx_to_extent) {
+  if (idx_to_extent) return flops_impl(expr, idx_to_extent);
+  return flops_impl(
+      expr, [](Index const& ix) { return ix.space().approximate_size(); });
+}
+
+ExprPtr factorize(Sum const& sum, OptimizeOptions opts) {
+  if (!opts.idx_to_extent)
+    opts.idx_to_extent = [](Index const& ix) {
+      return ix.space().approximate_size();
+    };
+  Factorizer const factorizer{opts};
+
+  // single-term optimization of the summands is independent; see the
+  // thread-safety notes in optimize.cpp
+  container::svector<Term> terms(sum.size());
+  auto indices = ranges::views::iota(std::size_t{0}, sum.size());
+  sequant::for_each(indices, [&](std::size_t i) {
+    terms[i] = factorizer.make_term(sum.summand(i));
+  });
+
+  Sum::summands_type optimized;
+  optimized.reserve(terms.size());
+  for (auto const& t : terms) optimized.push_back(t.expr);
+  auto unfactorized = ex<Sum>(std::move(optimized), Sum::move_only_tag{});
+
+  auto result = factorizer.factorize(std::move(terms));
+  // each step reduces the operation count, so this only guards against
+  // returning a needlessly restructured sum
+  return factorizer.flops(result) < factorizer.flops(unfactorized)
+             ? result
+             : unfactorized;
+}
+
+}  // namespace sequant::opt
@@ -0,0 +1,56 @@
+#ifndef SEQUANT_CORE_OPTIMIZE_FACTORIZE_HPP
+#define SEQUANT_CORE_OPTIMIZE_FACTORIZE_HPP
+
+#include <SeQuant/core/expr_fwd.hpp>
+#include <SeQuant/core/optimize/options.hpp>
+
+namespace sequant::opt {
+
+///
+/// \brief Count the floating-point operations needed to evaluate an expression
+///        in the order given by its parenthesization.
+///
+/// The factors of a Product are contracted left to right (nested Products are
+/// evaluated first), each binary contraction costing the product of the extents
+/// of the union of the indices of its operands, as in
+/// \ref detail::flops_counter. Adding the summands of a Sum costs one operation
+/// per element of the result for each summand but the first. Scaling by scalar
+/// factors is not counted.
+///
+/// \param expr          Expression to count the operations of.
+/// \param idx_to_extent Index to extent provider. If empty, defaults to
+///                      \c IndexSpace::approximate_size().
+/// \return The operation count.
+///
+double evaluation_flops(ExprPtr const& expr,
+                        index_to_extent_t const& idx_to_extent = {});
+
+///
+/// \brief Factorize common tensor factors out of the summands of a sum.
+///
+/// Unlike \ref Fusion, which fuses two products at a time, this pass considers
+/// the whole sum: eg. abc + abd + ae => a(b(c + d) + e).
+///
+/// Summands that are products of tensors (and a scalar) are grouped by a shared
+/// tensor factor; among all such groups the one whose factorization saves the
+/// most operations, as counted by \ref evaluation_flops with every product in
+/// its single-term optimized order, is factorized. This repeats until no group
+/// saves operations, and the sum of the remainders of each factorized group is
+/// factorized the same way. The remaining products are single-term optimized.
+/// Summands of other kinds are optimized by \ref sequant::optimize but are not
+/// factorized.
+///
+/// Since only steps that reduce the operation count are taken, the operation
+/// count of the result never exceeds that of the single-term optimized sum.
+///
+/// \param sum  A Sum to factorize.
+/// \param opts Optimization parameters used to single-term optimize the
+///             products; see \c OptimizeOptions. Factorization itself always
+///             minimizes the operation count. Summands are not reordered.
+/// \return The factorized expression.
+///
+ExprPtr factorize(Sum const& sum, OptimizeOptions opts = {});
+
+}  // namespace sequant::opt
+
+#endif  // SEQUANT_CORE_OPTIMIZE_FACTORIZE_HPP
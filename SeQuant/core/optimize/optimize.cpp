@@ -5,6 +5,7 @@
 #include <SeQuant/core/expr.hpp>
 #include <SeQuant/core/hash.hpp>
 #include <SeQuant/core/index.hpp>
+#include <SeQuant/core/optimize/factorize.hpp>
 #include <SeQuant/core/optimize/optimize.hpp>
 #include <SeQuant/core/optimize/single_term.hpp>
 #include <SeQuant/core/optimize/sum.hpp>
@@ -109,6 +110,9 @@ ExprPtr optimize_impl(ExprPtr const& expr, OptimizeOptions const& opts,
     return pure ? opt_pure_product(prod, opts) : opt_mixed_product(prod, opts);
   }
 
+  if (expr->is<Sum>() && opts.factorize == FactorizeSum::Factorize)
+    return opt::factorize(expr->as<Sum>(), opts);
+
   if (expr->is<Sum>()) {
     auto const& in_sum = expr->as<Sum>();
     Sum::summands_type new_smands(in_sum.size());
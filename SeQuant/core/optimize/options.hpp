@@ -19,6 +19,10 @@ enum class ObjectiveFunction { DenseFLOPs, DenseSize };
 /// closer to each other.
 enum class ReorderSum { Reorder, NoReorder };
 
+/// Whether to factorize common tensor factors out of the summands of a sum
+/// (see \ref opt::factorize).
+enum class FactorizeSum { Factorize, NoFactorize };
+
 /// Common-subexpression-elimination (CSE) options for single-term
 /// optimization. `subnet` recognizes equivalent subnetworks while searching for
 /// an evaluation order, trading extra search time for potentially lower op
@@ -44,6 +48,11 @@ struct OptimizeOptions {
   /// closer to each other.
   ReorderSum reorder = ReorderSum::Reorder;
 
+  /// Whether to factorize common tensor factors out of the summands of a sum,
+  /// eg. abc + abd + ae => a(b(c + d) + e), whenever that lowers the operation
+  /// count. Factorized sums are not reordered.
+  FactorizeSum factorize = FactorizeSum::NoFactorize;
+
   /// Common-subexpression-elimination options. All disabled by default;
   /// enabling can reduce op counts at the cost of additional optimization time.
   CSEOptions CSE = {};
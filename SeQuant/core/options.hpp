@@ -7,6 +7,7 @@
 
 #include <SeQuant/core/index.hpp>
 
+#include <cstddef>
 #include <optional>
 #include <string>
 #include <vector>
@@ -64,6 +65,15 @@ struct CanonicalizeOptions {
   /// contexts where labels are meaningful, e.g. when canonicalizing sum of
   /// tensor networks and will be therefore ignored.
   IgnoreNamedIndexLabel ignore_named_index_labels = IgnoreNamedIndexLabel::Yes;
+  /// nonempty tensor networks with at most this many tensors are
+  /// topologically canonicalized by direct enumeration of tensor orders and
+  /// symmetry-allowed slot permutations instead of canonical labeling of their
+  /// colored graph, unless their symmetries make the search too expensive
+  /// (this is decided from invariants of the network, so equivalent networks
+  /// always take the same path). The result is a canonical form, but it
+  /// differs from that produced by the graph canonicalization, hence this is
+  /// disabled (0) by default to keep existing canonical forms stable.
+  std::size_t enumeration_max_tensors = 0;
 
   static CanonicalizeOptions default_options();
   CanonicalizeOptions copy_and_set(CanonicalizationMethod) const;
@@ -89,6 +99,18 @@ struct SimplifyOptions : public CanonicalizeOptions {
   }
 };
 
+/// @brief options that control behavior of `expand()`
+struct ExpandOptions {
+  /// if true, the terms produced by expanding the top-level Product (or the
+  /// Product summands of a top-level Sum) are canonicalized as soon as they
+  /// are produced and the proportional terms among them are combined, i.e.
+  /// the expansion is fused with the canonicalization step of `simplify()`
+  bool canonicalize = false;
+  /// a Product that expands into at least this many terms is expanded
+  /// concurrently
+  std::size_t parallel_threshold = 256;
+};
+
 }  // namespace sequant
 
 #endif  // SEQUANT_CORE_OPTIONS_HPP
@@ -5,6 +5,7 @@
 #ifndef SEQUANT_RUNTIME_HPP
 #define SEQUANT_RUNTIME_HPP
 
+#include <algorithm>
 #include <cstdlib>
 #include <memory>
 #include <thread>
@@ -37,6 +38,13 @@ inline int& nthreads_accessor() {
   static int nthreads = init_nthreads();
   return nthreads;
 }
+
+/// @return reference to the number of threads available to the concurrent
+/// work launched by the calling thread; 0 means no limit is imposed
+inline int& thread_budget_accessor() {
+  thread_local int budget = 0;
+  return budget;
+}
 }  // namespace detail
 
 /// sets the number of threads to use for concurrent work
@@ -48,8 +56,33 @@ inline void set_num_threads(int nt) {
 /// @return the number of threads to use for concurrent work
 /// @note by default use the value returned std::thread::hardware_concurrency()
 /// if available, otherwise 1
-/// @sa set_num_threads()
-inline int num_threads() { return detail::nthreads_accessor(); }
+/// @note if the calling thread executes within a ThreadBudget, returns the
+/// budget instead
+/// @sa set_num_threads(), ThreadBudget
+inline int num_threads() {
+  const auto budget = detail::thread_budget_accessor();
+  return budget > 0 ? budget : detail::nthreads_accessor();
+}
+
+/// RAII object that limits the number of threads that concurrent work
+/// launched by the calling thread (e.g. nested for_each()) can use, so that
+/// nested parallel regions share the budget rather than oversubscribe
+class ThreadBudget {
+ public:
+  /// @param nthreads the number of threads available to the calling thread;
+  ///        clamped to 1 if smaller
+  explicit ThreadBudget(int nthreads)
+      : prev_budget_(detail::thread_budget_accessor()) {
+    detail::thread_budget_accessor() = nthreads > 1 ? nthreads : 1;
+  }
+  ~ThreadBudget() { detail::thread_budget_accessor() = prev_budget_; }
+
+  ThreadBudget(const ThreadBudget&) = delete;
+  ThreadBudget& operator=(const ThreadBudget&) = delete;
+
+ private:
+  int prev_budget_;
+};
 
 /// Fires off @c nthreads instances of lambda in parallel, each in its own
 /// thread (thus @c nthreads-1 std::thread objects are created), where @c
@@ -85,6 +118,9 @@ void parallel_do(Lambda&& lambda) {
 ///        @c [0,size(rng)) . @c op(t1) will be commenced not
 /// after @c op(t2) if @c t1<t2 .
 /// @note The load is balanced dynamically.
+/// @note Concurrent work launched from within @p op shares the thread budget
+/// (see ThreadBudget) with the other tasks; if the parallel C++ algorithms are
+/// used their runtime is responsible for this.
 /// @sa get_num_threads()
 template <typename SizedRange, typename UnaryOp>
 void for_each(SizedRange& rng, const UnaryOp& op) {
@@ -94,7 +130,14 @@ void for_each(SizedRange& rng, const UnaryOp& op) {
   std::for_each(std::execution::par_unseq, begin(rng), end(rng), op);
 #else
   std::atomic<size_t> work = 0;
-  auto task = [&work, &op, &rng, ntasks = ranges::size(rng)]() {
+  const size_t ntasks = ranges::size(rng);
+  // never launch more workers than tasks, nested concurrent work launched by
+  // the workers shares the remaining budget
+  const auto nthreads = static_cast<int>(
+      std::min<size_t>(num_threads(), ntasks > 0 ? ntasks : 1));
+  const auto worker_budget = num_threads() / nthreads;
+  auto task = [&work, &op, &rng, ntasks, worker_budget]() {
+    ThreadBudget budget(worker_budget);
     auto it = ranges::begin(rng);
     size_t prev_task_id = 0;
     size_t task_id = work.fetch_add(1);
@@ -106,7 +149,6 @@ void for_each(SizedRange& rng, const UnaryOp& op) {
     }
   };
 
-  const auto nthreads = num_threads();
   std::vector<std::thread> threads;
   for (int thread_id = 0; thread_id != nthreads; ++thread_id) {
     if (thread_id != nthreads - 1)
@@ -146,8 +188,13 @@ T transform_reduce(SizedRange&& rng, T init, const BinaryReductionOp& reduce,
   std::atomic<size_t> work = 0;
   std::mutex mtx;
   T result = init;
-  auto task = [&work, &map, &reduce, &rng, &mtx, &result,
-               ntasks = ranges::size(rng)]() {
+  const size_t ntasks = ranges::size(rng);
+  const auto nthreads = static_cast<int>(
+      std::min<size_t>(num_threads(), ntasks > 0 ? ntasks : 1));
+  const auto worker_budget = num_threads() / nthreads;
+  auto task = [&work, &map, &reduce, &rng, &mtx, &result, ntasks,
+               worker_budget]() {
+    ThreadBudget budget(worker_budget);
     size_t task_id = work.fetch_add(1);
     while (task_id < ntasks) {
       const auto& item = rng[task_id];
@@ -160,7 +207,6 @@ T transform_reduce(SizedRange&& rng, T init, const BinaryReductionOp& reduce,
     }
   };
 
-  const auto nthreads = num_threads();
   std::vector<std::thread> threads;
   for (int thread_id = 0; thread_id != nthreads; ++thread_id) {
     if (thread_id != nthreads - 1)
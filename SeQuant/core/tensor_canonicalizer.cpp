@@ -169,13 +169,10 @@ struct TensorIndexComparer {
 
 TensorCanonicalizer::~TensorCanonicalizer() = default;
 
-std::pair<container::map<std::wstring, std::shared_ptr<TensorCanonicalizer>>*,
-          std::unique_lock<std::recursive_mutex>>
+detail::SnapshotCell<TensorCanonicalizer::instance_map_t>&
 TensorCanonicalizer::instance_map_accessor() {
-  static container::map<std::wstring, std::shared_ptr<TensorCanonicalizer>>
-      map_;
-  static std::recursive_mutex mtx_;
-  return std::make_pair(&map_, std::unique_lock<std::recursive_mutex>{mtx_});
+  static detail::SnapshotCell<instance_map_t> map_;
+  return map_;
 }
 
 container::vector<std::wstring>&
@@ -230,10 +227,11 @@ void TensorCanonicalizer::clear_all_cardinal_tensor_labels() {
 
 std::shared_ptr<TensorCanonicalizer>
 TensorCanonicalizer::nondefault_instance_ptr(std::wstring_view label) {
-  auto&& [map_ptr, lock] = instance_map_accessor();
+  // N.B. lock-free, reads the current snapshot
+  const auto& map = instance_map_accessor().get();
   // look for label-specific canonicalizer
-  auto it = map_ptr->find(std::wstring{label});
-  if (it != map_ptr->end()) {
+  auto it = map.find(std::wstring{label});
+  if (it != map.end()) {
     return it->second;
   } else
     return {};
@@ -259,26 +257,25 @@ std::shared_ptr<TensorCanonicalizer> TensorCanonicalizer::instance(
 
 void TensorCanonicalizer::register_instance(
     std::shared_ptr<TensorCanonicalizer> can, std::wstring_view label) {
-  auto&& [map_ptr, lock] = instance_map_accessor();
-  (*map_ptr)[std::wstring{label}] = can;
+  instance_map_accessor().update([&](instance_map_t& map) {
+    map.insert_or_assign(std::wstring{label}, std::move(can));
+  });
 }
 
 bool TensorCanonicalizer::try_register_instance(
     std::shared_ptr<TensorCanonicalizer> can, std::wstring_view label) {
-  auto&& [map_ptr, lock] = instance_map_accessor();
-  if (!map_ptr->contains(std::wstring{label})) {
-    (*map_ptr)[std::wstring{label}] = can;
-    return true;
-  } else
+  // avoid publishing a new snapshot if nothing changes
+  if (instance_map_accessor().get().contains(std::wstring{label}))
     return false;
+  return instance_map_accessor().update([&](instance_map_t& map) {
+    return map.try_emplace(std::wstring{label}, std::move(can)).second;
+  });
 }
 
 void TensorCanonicalizer::deregister_instance(std::wstring_view label) {
-  auto&& [map_ptr, lock] = instance_map_accessor();
-  auto it = map_ptr->find(std::wstring{label});
-  if (it != map_ptr->end()) {
-    map_ptr->erase(it);
-  }
+  if (!instance_map_accessor().get().contains(std::wstring{label})) return;
+  instance_map_accessor().update(
+      [&](instance_map_t& map) { map.erase(std::wstring{label}); });
 }
 
 TensorCanonicalizer::index_comparer_t TensorCanonicalizer::index_comparer_ =
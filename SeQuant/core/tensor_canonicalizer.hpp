@@ -7,6 +7,7 @@
 
 #include <SeQuant/core/expr.hpp>
 #include <SeQuant/core/utility/macros.hpp>
+#include <SeQuant/core/utility/snapshot.hpp>
 
 #include <range/v3/algorithm/for_each.hpp>
 #include <range/v3/algorithm/sort.hpp>
@@ -131,10 +132,11 @@ class TensorCanonicalizer {
   static index_pair_comparer_t index_pair_comparer_;
 
  private:
-  static std::pair<
-      container::map<std::wstring, std::shared_ptr<TensorCanonicalizer>>*,
-      std::unique_lock<std::recursive_mutex>>
-  instance_map_accessor();  // map* + locked recursive mutex
+  using instance_map_t =
+      container::map<std::wstring, std::shared_ptr<TensorCanonicalizer>>;
+  /// @note the map is read on every canonicalization, hence it is kept as
+  /// an immutable snapshot that readers access without locking
+  static detail::SnapshotCell<instance_map_t>& instance_map_accessor();
   static container::vector<std::wstring>& cardinal_tensor_labels_accessor();
   static container::vector<std::wstring>&
   default_cardinal_tensor_labels_accessor();
@@ -13,6 +13,7 @@
 #include <SeQuant/core/io/latex/latex.hpp>
 #include <SeQuant/core/io/shorthands.hpp>
 #include <SeQuant/core/logger.hpp>
+#include <SeQuant/core/math.hpp>
 #include <SeQuant/core/tag.hpp>
 #include <SeQuant/core/tensor_canonicalizer.hpp>
 #include <SeQuant/core/tensor_network/utils.hpp>
@@ -21,16 +22,22 @@
 #include <SeQuant/core/utility/debug.hpp>
 #include <SeQuant/core/utility/indices.hpp>
 #include <SeQuant/core/utility/macros.hpp>
+#include <SeQuant/core/utility/permutation.hpp>
 #include <SeQuant/core/utility/string.hpp>
 #include <SeQuant/core/utility/swap.hpp>
 #include <SeQuant/core/utility/tuple.hpp>
 
 #include <algorithm>
+#include <array>
+#include <compare>
 #include <iostream>
 #include <iterator>
 #include <limits>
+#include <numeric>
+#include <optional>
 #include <sstream>
 #include <string>
+#include <tuple>
 
 #include <range/v3/algorithm/find.hpp>
 #include <range/v3/algorithm/for_each.hpp>
@@ -472,6 +479,512 @@ ExprPtr TensorNetworkV3::canonicalize_graph(const NamedIndexSet &named_indices,
     return {};
 }
 
+namespace {
+
+/// all permutations of {0, ..., n-1} for n <= max_tabulated_tie_size,
+/// used to enumerate orderings of interchangeable slots (or columns) in
+/// TensorNetworkV3::canonicalize_enumerated
+constexpr std::size_t max_tabulated_tie_size = 6;
+
+const std::vector<container::svector<std::size_t, 8>> &permutation_table(
+    std::size_t n) {
+  SEQUANT_ASSERT(n <= max_tabulated_tie_size);
+  static const auto tables = [] {
+    std::array<std::vector<container::svector<std::size_t, 8>>,
+               max_tabulated_tie_size + 1>
+        result;
+    for (std::size_t k = 0; k <= max_tabulated_tie_size; ++k) {
+      container::svector<std::size_t, 8> p(k);
+      std::iota(p.begin(), p.end(), 0);
+      do {
+        result[k].push_back(p);
+      } while (std::next_permutation(p.begin(), p.end()));
+    }
+    return result;
+  }();
+  return tables[n];
+}
+
+/// implements TensorNetworkV3::canonicalize_enumerated by exhaustive search
+/// over tensor orders and symmetry-allowed slot arrangements for the
+/// lexicographically smallest code of the network; slot arrangements are
+/// obtained by sorting interchangeable slots (or columns) by the codes of
+/// their indices and only branching over orderings of ties. Ties between
+/// codes are broken by the labels of named indices, if these are ignored.
+/// Whether the search is affordable is decided by max_search_nodes() before
+/// searching, from invariants of the network only, so that equivalent networks
+/// are either all canonicalized by enumeration or all by the graph.
+class EnumeratedCanonicalizer {
+ public:
+  using Code = std::uint64_t;
+
+  /// how the slots of a tensor can be rearranged
+  enum class SlotGroups {
+    /// no rearrangements
+    Fixed,
+    /// bra and ket slots can be permuted independently
+    BraKet,
+    /// columns ({bra_i,ket_i} slot pairs) can be permuted
+    Columns
+  };
+
+  struct TensorInfo {
+    std::size_t cls;  // equivalence class of the tensor
+    SlotGroups groups;
+    bool swappable;  // bra<->ket swap is a symmetry
+    container::svector<std::size_t> bra, ket, aux;  // index ids in slots
+  };
+
+  struct IndexInfo {
+    Code kind;   // 0 = named (distinct), 1 = named, 2 = anonymous
+    Code value;  // rank of name (kind 0) or of space (kinds 1 and 2)
+    // rank of name (kind 1 only), breaks ties between equal codes
+    Code label = 0;
+  };
+
+  /// arrangement of a tensor at a given position in the canonical order
+  struct Arrangement {
+    std::size_t tensor = 0;
+    bool swap = false;
+    container::svector<std::size_t> bra_perm, ket_perm, column_perm;
+  };
+
+  static constexpr std::uint32_t unassigned =
+      std::numeric_limits<std::uint32_t>::max();
+  /// budget for max_search_nodes()
+  static constexpr std::size_t max_nodes = 1 << 17;
+
+  EnumeratedCanonicalizer(std::vector<TensorInfo> tensors,
+                          std::vector<IndexInfo> indices)
+      : tensors_(std::move(tensors)), indices_(std::move(indices)) {
+    for (const auto &t : tensors_) classes_.push_back(t.cls);
+    std::ranges::sort(classes_);
+  }
+
+  /// bounds the search by counting the arrangements of tensors of equal class
+  /// and of slots (or columns) holding indices of equal kind and value,
+  /// i.e. the largest possible ties; the bound only depends on the multisets
+  /// of classes and index kinds and values, not on the input order
+  /// @return an upper bound on the number of nodes visited by run(), or
+  /// std::nullopt if a tie may be longer than max_tabulated_tie_size
+  std::optional<std::size_t> max_search_nodes() const {
+    std::size_t leaves = 1;
+    for (auto b = classes_.begin(); b != classes_.end();) {
+      const auto e = std::upper_bound(b, classes_.end(), *b);
+      for (std::size_t k = 2; k <= std::size_t(e - b); ++k)
+        leaves = saturating_mul(leaves, k);
+      b = e;
+    }
+
+    // multiplies leaves by n! for every n items with equal keys
+    auto add_group = [&leaves](std::vector<std::array<Code, 4>> &keys) {
+      std::ranges::sort(keys);
+      for (auto b = keys.begin(); b != keys.end();) {
+        const auto e = std::upper_bound(b, keys.end(), *b);
+        if (std::size_t(e - b) > max_tabulated_tie_size) return false;
+        for (std::size_t k = 2; k <= std::size_t(e - b); ++k)
+          leaves = saturating_mul(leaves, k);
+        b = e;
+      }
+      return true;
+    };
+    auto kv = [this](std::size_t id) {
+      return std::pair{indices_[id].kind, indices_[id].value};
+    };
+    for (const auto &t : tensors_) {
+      if (t.swappable) leaves = saturating_mul(leaves, 2);
+      switch (t.groups) {
+        case SlotGroups::Fixed:
+          break;
+        case SlotGroups::BraKet:
+          for (const auto *row : {&t.bra, &t.ket}) {
+            std::vector<std::array<Code, 4>> keys;
+            for (auto id : *row) keys.push_back({kv(id).first, kv(id).second});
+            if (!add_group(keys)) return std::nullopt;
+          }
+          break;
+        case SlotGroups::Columns: {
+          std::vector<std::array<Code, 4>> keys;
+          for (std::size_t i = 0; i != t.bra.size(); ++i)
+            keys.push_back({kv(t.bra[i]).first, kv(t.bra[i]).second,
+                            kv(t.ket[i]).first, kv(t.ket[i]).second});
+          if (!add_group(keys)) return std::nullopt;
+          break;
+        }
+      }
+    }
+    // every node is a prefix of at least one leaf
+    return saturating_mul(leaves, tensors_.size() + 1);
+  }
+
+  /// finds the canonical arrangement
+  /// @pre `max_search_nodes()` is not std::nullopt
+  void run() {
+    State s;
+    s.ordinals.assign(indices_.size(), unassigned);
+    s.used.assign(tensors_.size(), false);
+    place_next_tensor(s);
+    SEQUANT_ASSERT(best_);
+  }
+
+  const auto &arrangements() const { return best_->arrangements; }
+  const auto &ordinals() const { return best_->ordinals; }
+
+ private:
+  struct State {
+    std::vector<Code> code;
+    std::vector<Code> labels;  // labels of kind 1 indices, in code order
+    std::vector<Arrangement> arrangements;
+    std::vector<std::uint32_t> ordinals;  // index id -> first-occurrence rank
+    std::uint32_t next_ordinal = 0;
+    std::vector<bool> used;  // tensor ordinal -> placed?
+    // comparison of code with the prefix of the best code of generation
+    // best_generation (0 = equal, -1 = less)
+    int cmp = 0;
+    std::size_t best_generation = 0;
+  };
+
+  std::vector<TensorInfo> tensors_;
+  std::vector<IndexInfo> indices_;
+  std::vector<std::size_t> classes_;  // sorted tensor classes
+  std::optional<State> best_;
+  std::size_t best_generation_ = 0;  // incremented when best_ changes
+
+  Code key(const State &s, std::size_t id) const {
+    const auto &info = indices_[id];
+    const Code ord = info.kind == 0 ? 0 : s.ordinals[id];
+    return (info.kind << 60) | (info.value << 32) | ord;
+  }
+
+  /// appends @p c to the code of @p s
+  /// @return false if @p s can be pruned
+  bool emit(State &s, Code c) const {
+    if (best_ && s.best_generation != best_generation_) {
+      // best code changed since s was last compared to it
+      const auto n = s.code.size();
+      const auto r = std::lexicographical_compare_three_way(
+          s.code.begin(), s.code.end(), best_->code.begin(),
+          best_->code.begin() + n);
+      if (r > 0) return false;
+      s.cmp = r < 0 ? -1 : 0;
+      s.best_generation = best_generation_;
+    }
+    if (best_ && s.cmp == 0) {
+      const auto c_best = best_->code[s.code.size()];
+      if (c > c_best) return false;
+      if (c < c_best) s.cmp = -1;
+    }
+    s.code.push_back(c);
+    return true;
+  }
+
+  /// emits the codes of the indices @p ids in order, assigning ordinals to
+  /// the indices seen for the first time
+  bool emit_indices(State &s, const container::svector<std::size_t> &ids) {
+    for (auto id : ids) {
+      if (indices_[id].kind != 0 && s.ordinals[id] == unassigned)
+        s.ordinals[id] = s.next_ordinal++;
+      if (!emit(s, key(s, id))) return false;
+      if (indices_[id].kind == 1) s.labels.push_back(indices_[id].label);
+    }
+    return true;
+  }
+
+  void place_next_tensor(State &s) {
+    const auto pos = s.arrangements.size();
+    if (pos == tensors_.size()) {
+      if (!best_ ||
+          std::tie(s.code, s.labels) < std::tie(best_->code, best_->labels)) {
+        best_ = s;
+        ++best_generation_;
+      }
+      return;
+    }
+    for (std::size_t t = 0; t != tensors_.size(); ++t) {
+      if (s.used[t] || tensors_[t].cls != classes_[pos]) continue;
+      for (bool swap : {false, true}) {
+        if (swap && !tensors_[t].swappable) continue;
+        State s_t = s;
+        s_t.used[t] = true;
+        s_t.arrangements.emplace_back().tensor = t;
+        s_t.arrangements.back().swap = swap;
+        const auto &bra = swap ? tensors_[t].ket : tensors_[t].bra;
+        if (!emit(s_t, tensors_[t].cls) || !emit(s_t, bra.size())) continue;
+        place_slots(s_t, t, 0);
+      }
+    }
+  }
+
+  /// places the slot group @p group of tensor @p t, then recurses
+  void place_slots(State &s, std::size_t t, int group) {
+    const auto &info = tensors_[t];
+    const auto swap = s.arrangements.back().swap;
+    const auto &bra = swap ? info.ket : info.bra;
+    const auto &ket = swap ? info.bra : info.ket;
+
+    switch (info.groups) {
+      case SlotGroups::Fixed:
+        if (emit_indices(s, bra) && emit_indices(s, ket) &&
+            emit_indices(s, info.aux))
+          place_next_tensor(s);
+        return;
+      case SlotGroups::BraKet:
+        if (group == 2) {
+          if (emit_indices(s, info.aux)) place_next_tensor(s);
+          return;
+        }
+        place_group(s, t, group, group == 0 ? bra : ket, {});
+        return;
+      case SlotGroups::Columns:
+        if (group == 1) {
+          if (emit_indices(s, info.aux)) place_next_tensor(s);
+          return;
+        }
+        place_group(s, t, group, bra, ket);
+        return;
+    }
+  }
+
+  /// places interchangeable items (slots of @p row0 , or columns {@p row0[i],
+  /// @p row1[i]} if @p row1 is nonempty) of group @p group of tensor @p t
+  void place_group(State &s, std::size_t t, int group,
+                   const container::svector<std::size_t> &row0,
+                   const container::svector<std::size_t> &row1) {
+    const auto n = row0.size();
+    const bool columns = !row1.empty();
+    SEQUANT_ASSERT(!columns || row1.size() == n);
+
+    // sort key of an item; indices not seen yet sort after the seen indices
+    // of the same kind and value
+    auto item_key = [&](std::size_t i) {
+      std::array<Code, 2> k{key(s, row0[i]), columns ? key(s, row1[i]) : 0};
+      return k;
+    };
+    auto item_has_unassigned = [&](std::size_t i) {
+      return (indices_[row0[i]].kind != 0 &&
+              s.ordinals[row0[i]] == unassigned) ||
+             (columns && indices_[row1[i]].kind != 0 &&
+              s.ordinals[row1[i]] == unassigned);
+    };
+
+    container::svector<std::size_t> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::ranges::stable_sort(order, [&](auto i, auto j) {
+      return item_key(i) < item_key(j);
+    });
+
+    // runs of tied items that contain yet unseen indices
+    container::svector<std::pair<std::size_t, std::size_t>> ties;
+    for (std::size_t b = 0; b != n;) {
+      auto e = b + 1;
+      while (e != n && item_key(order[e]) == item_key(order[b])) ++e;
+      if (e - b > 1 && item_has_unassigned(order[b])) {
+        // guaranteed by max_search_nodes()
+        SEQUANT_ASSERT(e - b <= max_tabulated_tie_size);
+        ties.emplace_back(b, e);
+      }
+      b = e;
+    }
+
+    // enumerates the orderings of each tie, then places the items
+    auto recurse = [&](auto &&self, std::size_t tie,
+                       const container::svector<std::size_t> &perm) -> void {
+      if (tie == ties.size()) {
+        State s_g = s;
+        auto &arr = s_g.arrangements.back();
+        for (auto i : perm) {
+          if (!emit_indices(s_g, {row0[i]})) return;
+          if (columns && !emit_indices(s_g, {row1[i]})) return;
+        }
+        if (columns)
+          arr.column_perm = perm;
+        else
+          (group == 0 ? arr.bra_perm : arr.ket_perm) = perm;
+        place_slots(s_g, t, group + 1);
+        return;
+      }
+      const auto [b, e] = ties[tie];
+      for (const auto &p : permutation_table(e - b)) {
+        auto perm_p = perm;
+        for (std::size_t k = 0; k != e - b; ++k) perm_p[b + k] = perm[b + p[k]];
+        self(self, tie + 1, perm_p);
+      }
+    };
+    recurse(recurse, 0, order);
+  }
+};
+
+}  // namespace
+
+std::optional<ExprPtr> TensorNetworkV3::canonicalize_enumerated(
+    const NamedIndexSet &named_indices, bool ignore_named_index_labels) {
+  using Canonicalizer = EnumeratedCanonicalizer;
+
+  // only simple networks are handled, leave the rest to canonicalize_graph
+  if (tensors_.empty()) return std::nullopt;
+  for (std::size_t i = 0; i != tensors_.size(); ++i) {
+    const AbstractTensor &t = *tensors_[i];
+    for (std::size_t j = 0; j != i; ++j)
+      if (!tensors_commute(t, *tensors_[j])) return std::nullopt;
+    for (const Index &idx : slots(t)) {
+      if (!idx.nonnull() || idx.has_proto_indices()) return std::nullopt;
+    }
+    if (column_symmetry(t) == ColumnSymmetry::Symm &&
+        symmetry(t) == Symmetry::Nonsymm && bra_rank(t) != ket_rank(t))
+      return std::nullopt;
+  }
+
+  const auto is_anonymous_index = [&named_indices](const Index &idx) {
+    return named_indices.find(idx) == named_indices.end();
+  };
+
+  // enumerate distinct indices, ranking spaces to use them in codes
+  container::svector<Index> indices;
+  container::svector<IndexSpace> spaces;
+  for (const auto &t : tensors_) {
+    for (const Index &idx : slots(*t)) {
+      if (ranges::find(indices, idx) == indices.end()) indices.push_back(idx);
+      if (ranges::find(spaces, idx.space()) == spaces.end())
+        spaces.push_back(idx.space());
+    }
+  }
+  std::sort(spaces.begin(), spaces.end());
+  const auto index_id = [&indices](const Index &idx) -> std::size_t {
+    return ranges::find(indices, idx) - indices.begin();
+  };
+
+  std::vector<Canonicalizer::IndexInfo> index_infos;
+  index_infos.reserve(indices.size());
+  for (const Index &idx : indices) {
+    auto it = named_indices.find(idx);
+    const bool named = it != named_indices.end();
+    if (named && !ignore_named_index_labels) {
+      index_infos.push_back(
+          {.kind = 0,
+           .value = static_cast<Canonicalizer::Code>(
+               std::distance(named_indices.begin(), it))});
+    } else {
+      index_infos.push_back(
+          {.kind = named ? Canonicalizer::Code{1} : Canonicalizer::Code{2},
+           .value = static_cast<Canonicalizer::Code>(
+               ranges::find(spaces, idx.space()) - spaces.begin()),
+           .label = named ? static_cast<Canonicalizer::Code>(
+                                std::distance(named_indices.begin(), it))
+                          : Canonicalizer::Code{0}});
+    }
+  }
+
+  // tensors are classified by the same attributes that determine the color of
+  // their graph vertices, see VertexPainter
+  using TensorKey = std::tuple<std::wstring_view, std::size_t, std::size_t,
+                               std::size_t, Symmetry, ColumnSymmetry,
+                               BraKetSymmetry>;
+  auto tensor_key = [](const AbstractTensor &t) {
+    auto b = bra_rank(t);
+    auto k = ket_rank(t);
+    if (braket_symmetry(t) == BraKetSymmetry::Symm && b > k) std::swap(b, k);
+    return TensorKey{label(t),
+                     b,
+                     k,
+                     aux_rank(t),
+                     symmetry(t),
+                     column_symmetry(t),
+                     braket_symmetry(t)};
+  };
+  container::svector<TensorKey> tensor_keys;
+  for (const auto &t : tensors_) tensor_keys.push_back(tensor_key(*t));
+  auto sorted_keys = tensor_keys;
+  std::sort(sorted_keys.begin(), sorted_keys.end());
+
+  std::vector<Canonicalizer::TensorInfo> tensor_infos;
+  tensor_infos.reserve(tensors_.size());
+  for (std::size_t i = 0; i != tensors_.size(); ++i) {
+    const AbstractTensor &t = *tensors_[i];
+    Canonicalizer::TensorInfo info;
+    info.cls = ranges::lower_bound(sorted_keys, tensor_keys[i]) -
+               sorted_keys.begin();
+    // N.B. mirrors canonicalize_graph, which only rearranges slots of
+    // column-symmetric tensors
+    const bool col_symm = column_symmetry(t) == ColumnSymmetry::Symm;
+    info.groups = !col_symm ? Canonicalizer::SlotGroups::Fixed
+                  : symmetry(t) == Symmetry::Nonsymm
+                      ? Canonicalizer::SlotGroups::Columns
+                      : Canonicalizer::SlotGroups::BraKet;
+    info.swappable = col_symm && braket_symmetry(t) == BraKetSymmetry::Symm;
+    for (const Index &idx : t._bra()) info.bra.push_back(index_id(idx));
+    for (const Index &idx : t._ket()) info.ket.push_back(index_id(idx));
+    for (const Index &idx : t._aux()) info.aux.push_back(index_id(idx));
+    tensor_infos.push_back(std::move(info));
+  }
+
+  Canonicalizer canonicalizer(std::move(tensor_infos), std::move(index_infos));
+  const auto max_search_nodes = canonicalizer.max_search_nodes();
+  if (!max_search_nodes || *max_search_nodes > Canonicalizer::max_nodes)
+    return std::nullopt;
+  canonicalizer.run();
+
+  if (Logger::instance().canonicalize) {
+    sequant::wprintf(
+        "TensorNetworkV3::canonicalize_enumerated: bypassing graph "
+        "canonicalization for ",
+        tensors_.size(), " tensors\n");
+  }
+
+  // relabel anonymous indices in the order of their first occurrence
+  const auto &ordinals = canonicalizer.ordinals();
+  container::svector<std::size_t> anonymous_ids;
+  for (std::size_t id = 0; id != indices.size(); ++id) {
+    if (is_anonymous_index(indices[id])) anonymous_ids.push_back(id);
+  }
+  std::ranges::sort(anonymous_ids, [&ordinals](auto id1, auto id2) {
+    return ordinals[id1] < ordinals[id2];
+  });
+  IndexFactory idxfac(is_anonymous_index, 1);
+  container::map<Index, Index> idxrepl;
+  for (auto id : anonymous_ids) {
+    auto replacement = idxfac.make(indices[id]);
+    if (replacement != indices[id])
+      idxrepl.emplace(indices[id], std::move(replacement));
+  }
+
+  edges_.clear();
+  have_edges_ = false;
+
+  apply_index_replacements(tensors_, idxrepl, true);
+
+  // reorder tensors and rearrange their slots
+  int parity = 1;
+  container::svector<AbstractTensorPtr> tensors;
+  tensors.reserve(tensors_.size());
+  tensor_input_ordinals_.clear();
+  for (const auto &arr : canonicalizer.arrangements()) {
+    AbstractTensor &tensor = *tensors_[arr.tensor];
+    if (arr.swap) tensor._swap_bra_ket();
+    if (!arr.column_perm.empty()) {
+      auto perm = arr.column_perm;
+      tensor._permute_columns(std::span(perm.data(), perm.size()));
+    }
+    if (!arr.bra_perm.empty())
+      tensor._permute_bra(std::span(arr.bra_perm.data(), arr.bra_perm.size()));
+    if (!arr.ket_perm.empty())
+      tensor._permute_ket(std::span(arr.ket_perm.data(), arr.ket_perm.size()));
+    if (symmetry(tensor) == Symmetry::Antisymm) {
+      for (auto perm : {arr.bra_perm, arr.ket_perm}) {
+        if (!perm.empty())
+          parity *= permutation_parity(std::span(perm.data(), perm.size()));
+      }
+    }
+    tensors.push_back(tensors_[arr.tensor]);
+    tensor_input_ordinals_.push_back(arr.tensor);
+  }
+  tensors_ = std::move(tensors);
+
+  if (parity < 0)
+    return ex<Constant>(-1);
+  else
+    return ExprPtr{};
+}
+
 TensorNetworkV3::TensorNetworkV3(TensorNetworkV3 &&) noexcept = default;
 TensorNetworkV3 &TensorNetworkV3::operator=(TensorNetworkV3 &&) noexcept =
     default;
@@ -536,8 +1049,18 @@ ExprPtr TensorNetworkV3::canonicalize(
     // The graph-based canonization is required in all cases in which there are
     // indistinguishable tensors present in the expression. Their order and
     // indexing can only be determined via this rigorous canonization.
-    byproduct = canonicalize_graph(
-        named_indices, static_cast<bool>(options.ignore_named_index_labels));
+    // small networks can be canonicalized by direct enumeration instead
+    std::optional<ExprPtr> enumerated_byproduct;
+    if (!tensors_.empty() &&
+        tensors_.size() <= options.enumeration_max_tensors) {
+      enumerated_byproduct = canonicalize_enumerated(
+          named_indices, static_cast<bool>(options.ignore_named_index_labels));
+    }
+    byproduct = enumerated_byproduct
+                    ? std::move(*enumerated_byproduct)
+                    : canonicalize_graph(
+                          named_indices,
+                          static_cast<bool>(options.ignore_named_index_labels));
   }
 
   if ((options.method & CanonicalizationMethod::Lexicographic) ==
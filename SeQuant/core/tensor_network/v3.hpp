@@ -20,6 +20,7 @@
 #include <cstdlib>
 #include <iosfwd>
 #include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <tuple>
@@ -451,6 +452,26 @@ class TensorNetworkV3 {
       const NamedIndexSet &named_indices,
       bool ignore_named_index_labels = true);
 
+  /// Canonicalizes the network by enumerating tensor orders and
+  /// symmetry-allowed slot rearrangements directly, bypassing the graph
+  /// canonicalization; only meant for small networks
+  /// @param named_indices named indices
+  /// @param ignore_named_index_labels whether to ignore labels of named
+  /// indices, see CanonicalizeOptions for more info
+  /// @return The byproduct of canonicalization, or std::nullopt (with this
+  /// object unchanged) if the network is not supported (e.g., it is empty or
+  /// contains noncommuting tensors, protoindices, or empty slots) or the
+  /// search may be too expensive, in which case canonicalize_graph() should be
+  /// used
+  /// @note whether the network is supported is determined from its invariants
+  /// (tensor classes and the spaces of the indices in interchangeable slots)
+  /// before searching, hence equivalent networks are either all supported or
+  /// all unsupported, and the supported ones produce identical results; the
+  /// result is not necessarily the one produced by canonicalize_graph()
+  [[nodiscard]] std::optional<ExprPtr> canonicalize_enumerated(
+      const NamedIndexSet &named_indices,
+      bool ignore_named_index_labels = true);
+
   /// Canonicalizes every individual tensor for itself, taking into account only
   /// tensor blocks
   /// @returns The byproduct of the canonicalizations
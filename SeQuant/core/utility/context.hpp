@@ -1,6 +1,8 @@
 #ifndef SEQUANT_CORE_UTILITY_CONTEXT_HPP
 #define SEQUANT_CORE_UTILITY_CONTEXT_HPP
 
+#include <SeQuant/core/utility/snapshot.hpp>
+
 #include <optional>
 
 /// \name reusable components for manipulation of global contexts
@@ -9,25 +11,31 @@
 
 namespace sequant::detail {
 
+/// @return the cell holding the implicit context of type @p Ctx
+/// @note implicit contexts are read on hot paths from many threads, but are
+/// rarely changed, hence they are stored as immutable snapshots; the cell
+/// also serializes the writers
 template <typename Ctx>
-inline Ctx& implicit_context_instance() {
-  static Ctx instance_;
-  return instance_;
+inline SnapshotCell<Ctx>& implicit_context_cell() {
+  static SnapshotCell<Ctx> cell_;
+  return cell_;
 }
 
+/// @note the returned reference is valid until a change of the context is
+/// observed by this thread (see SnapshotCell)
 template <typename Ctx>
 const Ctx& get_implicit_context() {
-  return implicit_context_instance<Ctx>();
+  return implicit_context_cell<Ctx>().get();
 }
 
 template <typename Ctx>
 void set_implicit_context(const Ctx& ctx) {
-  implicit_context_instance<Ctx>() = ctx;
+  implicit_context_cell<Ctx>().publish(ctx);
 }
 
 template <typename Ctx>
 void reset_implicit_context() {
-  implicit_context_instance<Ctx>() = Ctx{};
+  implicit_context_cell<Ctx>().publish(Ctx{});
 }
 
 /// used to auto-reset implicit context after leaving scope
@@ -50,11 +58,21 @@ struct ImplicitContextResetter {
 
 template <typename Ctx>
 ImplicitContextResetter<Ctx> set_scoped_implicit_context(const Ctx& ctx) {
-  if (get_implicit_context<Ctx>() != ctx) {
-    auto previous_ctx = get_implicit_context<Ctx>();
-    set_implicit_context(ctx);
-    return previous_ctx;
-  } else
+  if (get_implicit_context<Ctx>() == ctx) return {};
+  // N.B. the comparison and the replacement are atomic with respect to other
+  // writers
+  auto previous_ctx =
+      implicit_context_cell<Ctx>().update([&ctx](Ctx& current) {
+        std::optional<Ctx> previous;
+        if (current != ctx) {
+          previous = current;
+          current = ctx;
+        }
+        return previous;
+      });
+  if (previous_ctx)
+    return *previous_ctx;
+  else
     return {};
 }
 
@@ -0,0 +1,119 @@
+#ifndef SEQUANT_CORE_UTILITY_SNAPSHOT_HPP
+#define SEQUANT_CORE_UTILITY_SNAPSHOT_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+
+namespace sequant::detail {
+
+/// @return a new, process-wide unique snapshot version
+inline std::uint64_t next_snapshot_version() {
+  static std::atomic<std::uint64_t> counter{0};
+  return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+// clang-format off
+/// @brief RCU-style holder of an immutable value of type @p T
+
+/// Writers never modify the value in place; instead they publish a new
+/// immutable snapshot (copy-on-write). Readers obtain the current snapshot
+/// via a thread-local cache that is revalidated by a single atomic load of
+/// the version counter, hence the read path does not take any lock unless
+/// a new snapshot was published since the last read by this thread.
+///
+/// Versions are unique across all SnapshotCell objects, hence the
+/// per-type thread-local cache is correct even if several cells of the same
+/// type exist (alternating reads from distinct cells merely go through the
+/// slow path).
+///
+/// Snapshots are owned by shared pointers held by the cell and by the
+/// per-thread caches, hence a superseded snapshot is reclaimed as soon as
+/// every thread that read it has refreshed its cache (or exited) and no
+/// pointer returned by snapshot() refers to it.
+///
+/// @tparam T the value type; must be copy-constructible
+/// @note a reference returned by get() is valid until a newer snapshot is
+/// observed by a call to get() or snapshot() on the same thread; use
+/// snapshot() to keep a snapshot alive for longer
+// clang-format on
+template <typename T>
+class SnapshotCell {
+ public:
+  using snapshot_ptr = std::shared_ptr<const T>;
+
+  explicit SnapshotCell(T value = T{})
+      : current_(std::make_shared<const T>(std::move(value))),
+        version_(next_snapshot_version()) {}
+
+  SnapshotCell(const SnapshotCell&) = delete;
+  SnapshotCell& operator=(const SnapshotCell&) = delete;
+
+  /// @return reference to the current snapshot
+  /// @sa SnapshotCell for the validity of the returned reference
+  const T& get() const { return *cached().ptr; }
+
+  /// @return shared pointer to the current snapshot
+  snapshot_ptr snapshot() const { return cached().ptr; }
+
+  /// @return the version of the current snapshot
+  std::uint64_t version() const {
+    return version_.load(std::memory_order_acquire);
+  }
+
+  /// publishes @p value as the new snapshot
+  void publish(T value) {
+    std::scoped_lock lock(mtx_);
+    publish_locked(std::make_shared<const T>(std::move(value)));
+  }
+
+  /// atomically (with respect to other writers) updates the value by
+  /// applying @p f to a copy of the current snapshot, then publishes the copy
+  /// @param f a callable taking `T&`
+  /// @return the value returned by @p f , if any
+  template <typename F>
+  auto update(F&& f) {
+    std::scoped_lock lock(mtx_);
+    auto value = std::make_shared<T>(*current_);
+    if constexpr (std::is_void_v<std::invoke_result_t<F, T&>>) {
+      std::forward<F>(f)(*value);
+      publish_locked(std::move(value));
+    } else {
+      auto result = std::forward<F>(f)(*value);
+      publish_locked(std::move(value));
+      return result;
+    }
+  }
+
+ private:
+  struct Cache {
+    std::uint64_t version = 0;
+    snapshot_ptr ptr;
+  };
+
+  mutable std::mutex mtx_;  // serializes writers and cache refills
+  snapshot_ptr current_;
+  std::atomic<std::uint64_t> version_;
+
+  void publish_locked(snapshot_ptr value) {
+    current_ = std::move(value);
+    version_.store(next_snapshot_version(), std::memory_order_release);
+  }
+
+  const Cache& cached() const {
+    thread_local Cache cache;
+    if (cache.version != version_.load(std::memory_order_acquire)) {
+      std::scoped_lock lock(mtx_);
+      cache.ptr = current_;
+      cache.version = version_.load(std::memory_order_relaxed);
+    }
+    return cache;
+  }
+};
+
+}  // namespace sequant::detail
+
+#endif  // SEQUANT_CORE_UTILITY_SNAPSHOT_HPP
@@ -31,6 +31,7 @@
 #include <range/v3/view/transform.hpp>
 #include <range/v3/view/zip.hpp>
 
+#include <algorithm>
 #include <bitset>
 #include <mutex>
 #include <span>
@@ -514,33 +515,95 @@ class WickTheorem {
   ExprPtr compute(bool count_only = false,
                   bool skip_input_canonicalization = false);
 
+  /// Estimated size of the result of compute(); the counts saturate at
+  /// `std::numeric_limits<std::size_t>::max()`
+  struct Estimate {
+    /// the number of nonzero contractions (full or partial, as controlled by
+    /// full_contractions()), topologically equivalent contractions counted
+    /// separately
+    std::size_t ncontractions = 0;
+    /// the number of topologically distinct contractions, i.e. the expected
+    /// number of terms in the result before reduction and canonicalization
+    std::size_t nterms = 0;
+
+    Estimate &operator+=(const Estimate &other) {
+      ncontractions = saturating_add(ncontractions, other.ncontractions);
+      nterms = saturating_add(nterms, other.nterms);
+      return *this;
+    }
+  };
+
+  /// Estimates the size of the result of compute() without applying Wick's
+  /// theorem. The Op objects of each NormalOperator are grouped by their
+  /// quasiparticle character and spaces; contractions are then counted by a
+  /// dynamic program over the NormalOperator objects whose state is the
+  /// number of uncontracted quasiparticle annihilators in each group and the
+  /// set of satisfied target connections (see set_nop_connections()).
+  /// Hence the cost is polynomial in the number of Op objects, for a fixed
+  /// number of groups.
+  /// @note Estimate::ncontractions is exact for a NormalOperatorSequence
+  /// input, Estimate::nterms counts contractions that differ in the number of
+  /// contractions between groups, hence approximates the topological
+  /// equivalence of Op objects deduced by compute()
+  /// @note if the input is an expression it is expanded and the estimates of
+  /// its terms are summed
+  /// @return the estimate
+  Estimate estimate() const;
+
+  /// Estimates the size of the result of applying Wick's theorem to
+  /// @p nopseq
+  /// @param nopseq a NormalOperatorSequence
+  /// @param full_contractions if true, count full contractions only
+  /// @param nop_connections pairs of NormalOperator ordinals that must be
+  /// connected
+  /// @param nop_avoided_connections pairs of NormalOperator ordinals that
+  /// must not be directly connected
+  /// @return the estimate
+  /// @sa estimate()
+  static Estimate estimate(
+      const NormalOperatorSequence<S> &nopseq, bool full_contractions,
+      const container::svector<std::pair<std::size_t, std::size_t>>
+          &nop_connections = {},
+      const container::svector<std::pair<std::size_t, std::size_t>>
+          &nop_avoided_connections = {});
+
   /// Collects compute statistics
   class Stats {
    public:
-    Stats() : num_attempted_contractions(0), num_useful_contractions(0) {}
+    Stats()
+        : num_attempted_contractions(0),
+          num_useful_contractions(0),
+          num_pruned_contractions(0) {}
     Stats(const Stats &other) noexcept {
       num_attempted_contractions.store(other.num_attempted_contractions.load());
       num_useful_contractions.store(other.num_useful_contractions.load());
+      num_pruned_contractions.store(other.num_pruned_contractions.load());
     }
     Stats &operator=(const Stats &other) noexcept {
       num_attempted_contractions.store(other.num_attempted_contractions.load());
       num_useful_contractions.store(other.num_useful_contractions.load());
+      num_pruned_contractions.store(other.num_pruned_contractions.load());
       return *this;
     }
 
     void reset() {
       num_attempted_contractions = 0;
       num_useful_contractions = 0;
+      num_pruned_contractions = 0;
     }
 
     Stats &operator+=(const Stats &other) {
       num_attempted_contractions += other.num_attempted_contractions;
       num_useful_contractions += other.num_useful_contractions;
+      num_pruned_contractions += other.num_pruned_contractions;
       return *this;
     }
 
     std::atomic<size_t> num_attempted_contractions;
     std::atomic<size_t> num_useful_contractions;
+    /// the number of partial contractions that were not extended further
+    /// because they provably cannot be completed to a full contraction
+    std::atomic<size_t> num_pruned_contractions;
   };
 
   /// Statistics accessor
@@ -559,6 +622,12 @@ class WickTheorem {
  private:
   static constexpr size_t max_input_size =
       32;  // max # of operators in the input sequence
+  static constexpr size_t max_input_opsize =
+      64;  // max # of Op<S> objects for which contractibility is tracked
+  static constexpr size_t max_reserved_terms =
+      1 << 12;  // cap on the result storage preallocated using estimate()
+  static constexpr size_t max_reserved_terms_per_summand =
+      16;  // cap on the result storage preallocated per summand of a Sum
 
   // if nonnull, apply wick to the whole expression recursively, else input_ is
   // set this is mutated by compute
@@ -601,6 +670,29 @@ class WickTheorem {
       nop_avoided_connections_input_;  // only used to cache input to
                                        // set_nop_avoided_connections_
 
+  /// @param reverse_masks reverse bitmasks of connections, in the format of
+  /// nop_connections_ or nop_avoided_connections_
+  /// @return the list of connections `{i,j}` (`i<j`) specified by @p
+  /// reverse_masks
+  static container::svector<std::pair<std::size_t, std::size_t>>
+  connection_list(
+      const container::svector<std::bitset<max_input_size>> &reverse_masks) {
+    container::svector<std::pair<std::size_t, std::size_t>> result;
+    const auto n = reverse_masks.size();
+    for (std::size_t i = 0; i != n; ++i)
+      for (std::size_t j = i + 1; j < n; ++j)
+        if (!reverse_masks[i].test(j)) result.emplace_back(i, j);
+    return result;
+  }
+
+  /// estimate() for a single term of an expanded expression
+  static Estimate estimate_term(
+      const ExprPtr &term, bool full_contractions,
+      const container::svector<std::pair<std::size_t, std::size_t>>
+          &nop_connections,
+      const container::svector<std::pair<std::size_t, std::size_t>>
+          &nop_avoided_connections);
+
   enum class TopologicalPartitionType { NormalOperator, Index };
 
   /// the number of partitions of the topologically equivalent NormalOperator's
@@ -799,6 +891,7 @@ class WickTheorem {
           nop_adjacency_matrix(ntri(nopseq.size()), 0),
           nop_nconnections(nopseq.size(), 0) {
       init_topological_partitions();
+      init_contractibility();
     }
 
     NontensorWickState(const NontensorWickState &) = delete;
@@ -853,6 +946,134 @@ class WickTheorem {
     /// @note exists to avoid the need to traverse op_partition_cdeg_matrix
     container::svector<size_t> op_partition_ncontractions;
 
+    using op_bitset = std::bitset<max_input_opsize>;
+    /// if false, the input has too many Op<S> objects to track contractibility
+    /// and can_complete() always succeeds
+    bool track_contractibility = false;
+    /// bitmask of uncontracted Op<S> objects, by their ordinals in the input
+    op_bitset free_ops;
+    /// for each Op<S> (by its ordinal in the input) the bitmask of Op<S>
+    /// objects it can be contracted with, regardless of their order
+    container::svector<op_bitset> op_contractible;
+    /// for each NormalOperator the bitmask of its Op<S> objects
+    container::svector<op_bitset> nop_ops;
+    /// bitmasks of quasiparticle annihilators and creators
+    op_bitset qpannihilators;
+    op_bitset qpcreators;
+
+    /// initializes free_ops, op_contractible, nop_ops, qpannihilators, and
+    /// qpcreators from the input
+    void init_contractibility() {
+      const auto &isr = ctx.index_space_registry();
+      const auto vacuum = ctx.vacuum();
+      container::svector<std::pair<const Op<S> *, std::size_t>>
+          ops;  // {op, nop ordinal}
+      for (std::size_t n = 0; n != nopseq.size(); ++n)
+        for (const auto &op : nopseq[n]) ops.emplace_back(&op, n);
+      track_contractibility = ops.size() <= max_input_opsize;
+      if (!track_contractibility) return;
+
+      nop_ops.resize(nopseq.size());
+      op_contractible.resize(ops.size());
+      const auto &avoided = wick.nop_avoided_connections_;
+      for (std::size_t i = 0; i != ops.size(); ++i) {
+        const auto [op_i, nop_i] = ops[i];
+        nop_ops[nop_i].set(i);
+        free_ops.set(i);
+        if (is_qpannihilator<S>(*op_i, vacuum, isr)) qpannihilators.set(i);
+        if (is_qpcreator<S>(*op_i, vacuum, isr)) qpcreators.set(i);
+        for (std::size_t j = i + 1; j < ops.size(); ++j) {
+          const auto [op_j, nop_j] = ops[j];
+          if (nop_i == nop_j) continue;
+          if (!avoided.empty() && !avoided[nop_i].test(nop_j)) continue;
+          if (can_contract(*op_i, *op_j, vacuum, isr)) {
+            op_contractible[i].set(j);
+            op_contractible[j].set(i);
+          }
+        }
+      }
+    }
+
+    /// marks Op<S> with input ordinal @p ord as contracted
+    void remove_free_op(std::size_t ord) {
+      if (track_contractibility) free_ops.reset(ord);
+    }
+    /// marks Op<S> with input ordinal @p ord as uncontracted
+    void restore_free_op(std::size_t ord) {
+      if (track_contractibility) free_ops.set(ord);
+    }
+
+    /// Checks necessary conditions for completing the current contraction
+    /// to a full contraction:
+    /// - uncontracted Op<S> objects fall into connected components of the
+    ///   graph of possible contractions; every component must be perfectly
+    ///   matchable, i.e. its qp annihilators can be paired with its qp
+    ///   creators;
+    /// - each target connection that is not yet realized must be realizable
+    ///   by contracting the remaining Op<S> objects.
+    /// @return false if the current contraction provably cannot be completed
+    bool can_complete(const container::svector<std::bitset<max_input_size>>
+                          &target_nop_connections) const {
+      if (!track_contractibility) return true;
+
+      auto for_each_bit = [](const op_bitset &bits, auto &&f) {
+        for (std::size_t b = 0; b != max_input_opsize; ++b)
+          if (bits.test(b)) f(b);
+      };
+
+      auto unvisited = free_ops;
+      while (unvisited.any()) {
+        // flood-fill the component of the first unvisited op
+        op_bitset component;
+        op_bitset frontier;
+        for (std::size_t b = 0; b != max_input_opsize; ++b) {
+          if (unvisited.test(b)) {
+            frontier.set(b);
+            break;
+          }
+        }
+        while (frontier.any()) {
+          component |= frontier;
+          op_bitset reachable;
+          for_each_bit(frontier,
+                       [&](std::size_t b) { reachable |= op_contractible[b]; });
+          frontier = reachable & free_ops & ~component;
+        }
+        unvisited &= ~component;
+
+        // each contraction pairs a qp annihilator with a qp creator
+        const auto nqpann_only =
+            (component & qpannihilators & ~qpcreators).count();
+        const auto nqpcre_only =
+            (component & qpcreators & ~qpannihilators).count();
+        const auto nboth = (component & qpannihilators & qpcreators).count();
+        if ((nqpann_only + nqpcre_only + nboth) % 2 != 0 ||
+            nqpann_only > nqpcre_only + nboth ||
+            nqpcre_only > nqpann_only + nboth)
+          return false;
+      }
+
+      if (!target_nop_connections.empty()) {
+        const auto nnops = nop_ops.size();
+        for (std::size_t i = 0; i != nnops; ++i) {
+          const auto missing =
+              ~(target_nop_connections[i] | nop_connections[i]);
+          for (std::size_t j = i + 1; j < nnops; ++j) {
+            if (!missing.test(j)) continue;
+            bool realizable = false;
+            const auto free_ops_j = free_ops & nop_ops[j];
+            for_each_bit(free_ops & nop_ops[i], [&](std::size_t b) {
+              realizable =
+                  realizable || (op_contractible[b] & free_ops_j).any();
+            });
+            if (!realizable) return false;
+          }
+        }
+      }
+
+      return true;
+    }
+
     /// "applies" this->contractions to the partner index pairs from
     /// this->wick.input_partner_indices_ to produce the current target list of
     /// partner indices
@@ -1179,7 +1400,14 @@ class WickTheorem {
   /// @return the result
   ExprPtr compute_nontensor_wick(const bool count_only) const {
     HashingAccumulator result;  //!< current value of the result
-    std::mutex mtx;             // used in critical sections updating the result
+    if (!count_only)
+      result.reserve(std::min(
+          estimate(*input_, full_contractions_,
+                   connection_list(nop_connections_),
+                   connection_list(nop_avoided_connections_))
+              .nterms,
+          max_reserved_terms));
+    std::mutex mtx;  // used in critical sections updating the result
     auto result_plus_mutex = std::make_pair(&result, &mtx);
     NontensorWickState state(*this, *input_);
     state.count_only = count_only;
@@ -1202,7 +1430,10 @@ class WickTheorem {
       std::wcout << "}" << std::endl;
     }
 
-    recursive_nontensor_wick(result_plus_mutex, state);
+    if (!full_contractions_ || state.can_complete(nop_connections_))
+      recursive_nontensor_wick(result_plus_mutex, state);
+    else
+      ++stats_.num_pruned_contractions;
 
     // if computing everything, and the user does not insist on some
     // target contractions, include the contraction-free term
@@ -1516,6 +1747,8 @@ class WickTheorem {
                 Op<S> left = *op_left_iter;
                 ranges::get_cursor(op_left_iter).erase();
                 --state.nopseq_size;
+                state.remove_free_op(op_right_input_ordinal);
+                state.remove_free_op(op_left_input_ordinal);
 
                 // std::wcout << "  nopseq after contraction = " <<
                 // io::latex::to_string(state.nopseq) << std::endl;
@@ -1608,7 +1841,13 @@ class WickTheorem {
                   }
                 }
 
-                if (state.nopseq_size != 0) {
+                // prune contractions that cannot be completed
+                const bool prune =
+                    state.nopseq_size != 0 && full_contractions_ &&
+                    !state.can_complete(nop_connections_);
+                if (prune) ++stats_.num_pruned_contractions;
+
+                if (state.nopseq_size != 0 && !prune) {
                   const auto current_num_useful_contractions =
                       stats_.num_useful_contractions.load();
                   ++state.level;
@@ -1630,6 +1869,8 @@ class WickTheorem {
                 ++state.nopseq_size;
                 ranges::get_cursor(op_right_iter).insert(std::move(right));
                 ++state.nopseq_size;
+                state.restore_free_op(op_left_input_ordinal);
+                state.restore_free_op(op_right_input_ordinal);
                 state.disconnect(nop_connections_,
                                  ranges::get_cursor(op_left_iter),
                                  ranges::get_cursor(op_right_iter));
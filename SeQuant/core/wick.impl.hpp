@@ -25,6 +25,11 @@
 #include <range/v3/view/filter.hpp>
 #include <range/v3/view/transform.hpp>
 
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <optional>
+
 #ifdef SEQUANT_HAS_EXECUTION_HEADER
 #include <execution>
 #endif
@@ -781,6 +786,47 @@ ExprPtr WickTheorem<S>::compute(const bool count_only,
                    << summands.size()
                    << " terms = " << to_latex_align(expr_input_) << std::endl;
 
+      // unless only counting, estimate the cost of each summand to presize
+      // the result and to schedule the most expensive summands first; since
+      // tasks are started in order this keeps a few large summands from
+      // becoming stragglers
+      container::svector<ExprPtr> scheduled_summands;
+      scheduled_summands.reserve(summands.size());
+      if (count_only) {
+        for (const auto &summand : summands)
+          scheduled_summands.emplace_back(summand);
+      } else {
+        container::svector<std::pair<std::size_t, ExprPtr>> costed_summands;
+        costed_summands.reserve(summands.size());
+        const auto nop_connections = nop_connections_input_.empty()
+                                         ? connection_list(nop_connections_)
+                                         : nop_connections_input_;
+        const auto nop_avoided_connections =
+            nop_avoided_connections_input_.empty()
+                ? connection_list(nop_avoided_connections_)
+                : nop_avoided_connections_input_;
+        Estimate estimate_total;
+        for (const auto &summand : summands) {
+          const auto summand_estimate =
+              estimate_term(summand, full_contractions_, nop_connections,
+                            nop_avoided_connections);
+          estimate_total += summand_estimate;
+          costed_summands.emplace_back(summand_estimate.ncontractions,
+                                       summand);
+        }
+        // N.B. the estimate can exceed the size of the result by far, hence
+        // presize in proportion to the number of summands
+        result_acc.reserve(
+            std::min(estimate_total.nterms,
+                     saturating_mul(max_reserved_terms_per_summand,
+                                    summands.size())));
+        std::stable_sort(
+            costed_summands.begin(), costed_summands.end(),
+            [](const auto &a, const auto &b) { return a.first > b.first; });
+        for (auto &&[cost, summand] : costed_summands)
+          scheduled_summands.emplace_back(std::move(summand));
+      }
+
       auto wick_task = [&result_acc, &result_mtx, this,
                         &count_only](const ExprPtr &input) {
         WickTheorem wt(input->clone(), *this);
@@ -792,7 +838,7 @@ ExprPtr WickTheorem<S>::compute(const bool count_only,
           result_acc.append(task_result);
         }
       };
-      sequant::for_each(summands, wick_task);
+      sequant::for_each(scheduled_summands, wick_task);
 
       // if the sum is empty return zero
       // if the sum has 1 summand, return it directly
@@ -1286,6 +1332,231 @@ ExprPtr WickTheorem<S>::compute(const bool count_only,
   SEQUANT_UNREACHABLE;
 }
 
+template <Statistics S>
+typename WickTheorem<S>::Estimate WickTheorem<S>::estimate() const {
+  // connections are cached as lists until the input is known
+  const auto nop_connections = nop_connections_input_.empty()
+                                   ? connection_list(nop_connections_)
+                                   : nop_connections_input_;
+  const auto nop_avoided_connections =
+      nop_avoided_connections_input_.empty()
+          ? connection_list(nop_avoided_connections_)
+          : nop_avoided_connections_input_;
+
+  if (!expr_input_) {
+    return input_ ? estimate(*input_, full_contractions_, nop_connections,
+                             nop_avoided_connections)
+                  : Estimate{};
+  }
+
+  auto expr = expr_input_->clone();
+  expand(expr);
+  if (!expr->is<Sum>())
+    return estimate_term(expr, full_contractions_, nop_connections,
+                         nop_avoided_connections);
+  Estimate result;
+  for (const auto &summand : expr->as<Sum>().summands())
+    result += estimate_term(summand, full_contractions_, nop_connections,
+                            nop_avoided_connections);
+  return result;
+}
+
+template <Statistics S>
+typename WickTheorem<S>::Estimate WickTheorem<S>::estimate_term(
+    const ExprPtr &term, const bool full_contractions,
+    const container::svector<std::pair<std::size_t, std::size_t>>
+        &nop_connections,
+    const container::svector<std::pair<std::size_t, std::size_t>>
+        &nop_avoided_connections) {
+  NormalOperatorSequence<S> nopseq;
+  auto append_nop = [&nopseq](const ExprPtr &factor) {
+    if (factor->template is<NormalOperator<S>>())
+      nopseq.push_back(factor->template as<NormalOperator<S>>());
+  };
+  if (term->is<Product>()) {
+    for (const auto &factor : term->as<Product>().factors())
+      append_nop(factor);
+  } else
+    append_nop(term);
+
+  // terms without normal operators are returned by compute() as is
+  if (nopseq.empty()) return Estimate{.ncontractions = 1, .nterms = 1};
+  return estimate(nopseq, full_contractions, nop_connections,
+                  nop_avoided_connections);
+}
+
+template <Statistics S>
+typename WickTheorem<S>::Estimate WickTheorem<S>::estimate(
+    const NormalOperatorSequence<S> &nopseq, const bool full_contractions,
+    const container::svector<std::pair<std::size_t, std::size_t>>
+        &nop_connections,
+    const container::svector<std::pair<std::size_t, std::size_t>>
+        &nop_avoided_connections) {
+  const auto vacuum = nopseq.vacuum();
+  const auto &isr = get_default_context(S).index_space_registry();
+
+  // Op objects of a NormalOperator with identical quasiparticle character
+  // and spaces are interchangeable as far as contractions are concerned
+  struct Group {
+    std::size_t nop;         // ordinal of the NormalOperator
+    std::size_t size;        // # of Op objects
+    IndexSpace qpann_space;  // null if not a qp annihilator
+    IndexSpace qpcre_space;  // null if not a qp creator
+  };
+  container::svector<Group> groups;
+  for (std::size_t nop_idx = 0; nop_idx != nopseq.size(); ++nop_idx) {
+    const auto nop_groups_begin = groups.size();
+    for (const auto &op : nopseq[nop_idx]) {
+      const auto qpann_space = is_qpannihilator<S>(op, vacuum, isr)
+                                   ? qpannihilator_space<S>(op, vacuum, isr)
+                                   : IndexSpace::null;
+      const auto qpcre_space = is_qpcreator<S>(op, vacuum, isr)
+                                   ? qpcreator_space<S>(op, vacuum, isr)
+                                   : IndexSpace::null;
+      auto it = std::find_if(groups.begin() + nop_groups_begin, groups.end(),
+                             [&](const Group &g) {
+                               return g.qpann_space == qpann_space &&
+                                      g.qpcre_space == qpcre_space;
+                             });
+      if (it != groups.end())
+        ++it->size;
+      else
+        groups.push_back(Group{.nop = nop_idx,
+                               .size = 1,
+                               .qpann_space = qpann_space,
+                               .qpcre_space = qpcre_space});
+    }
+  }
+  const auto ngroups = groups.size();
+
+  auto ordered = [](std::pair<std::size_t, std::size_t> p) {
+    if (p.first > p.second) std::swap(p.first, p.second);
+    return p;
+  };
+  container::svector<std::pair<std::size_t, std::size_t>> required;
+  for (const auto &p : nop_connections) required.push_back(ordered(p));
+  container::svector<std::pair<std::size_t, std::size_t>> avoided;
+  for (const auto &p : nop_avoided_connections) avoided.push_back(ordered(p));
+
+  // the state of the dynamic program: # of uncontracted qp annihilators in
+  // each group, followed by the bitset of satisfied required connections
+  using Key = container::svector<std::size_t>;
+  constexpr std::size_t word_nbits = std::numeric_limits<std::size_t>::digits;
+  const auto nwords = (required.size() + word_nbits - 1) / word_nbits;
+  container::map<Key, Estimate> states;
+  states.emplace(Key(ngroups + nwords, 0),
+                 Estimate{.ncontractions = 1, .nterms = 1});
+
+  // N.B. the counts saturate rather than overflow
+  constexpr auto max_count = std::numeric_limits<std::size_t>::max();
+  auto binomial = [](std::size_t n, std::size_t k) {
+    // after step i result = binomial(n - k + i, i), which grows with i, and
+    // result * (n - k + i) / i is evaluated without overflowing intermediates
+    std::size_t result = 1;
+    for (std::size_t i = 1; i <= k; ++i) {
+      const auto g = std::gcd(result, i);
+      result = saturating_mul(result / g, (n - k + i) / (i / g));
+      if (result == max_count) break;
+    }
+    return result;
+  };
+  auto falling_factorial = [](std::size_t n, std::size_t k) {
+    std::size_t result = 1;
+    for (std::size_t i = 0; i != k; ++i) result = saturating_mul(result, n - i);
+    return result;
+  };
+
+  for (std::size_t g = 0; g != ngroups; ++g) {
+    const auto &group = groups[g];
+
+    // uncontracted qp annihilators of the preceding NormalOperator objects
+    // that Op objects in this group can contract with
+    container::svector<std::size_t> partners;
+    container::svector<std::optional<std::size_t>> partner_required_bit;
+    if (group.qpcre_space) {
+      for (std::size_t h = 0; groups[h].nop != group.nop; ++h) {
+        const auto &partner = groups[h];
+        const auto nop_pair = std::make_pair(partner.nop, group.nop);
+        if (partner.qpann_space &&
+            isr->intersection(partner.qpann_space, group.qpcre_space) &&
+            !ranges::contains(avoided, nop_pair)) {
+          partners.push_back(h);
+          const auto it = ranges::find(required, nop_pair);
+          partner_required_bit.push_back(
+              it != required.end()
+                  ? std::optional<std::size_t>{static_cast<std::size_t>(
+                        it - required.begin())}
+                  : std::nullopt);
+        }
+      }
+    }
+
+    decltype(states) next_states;
+    for (const auto &[key, weight] : states) {
+      auto next_key = key;
+
+      // distributes nleft Op objects of this group among partners[p...]
+      auto distribute = [&](auto &self, std::size_t p, std::size_t nleft,
+                            std::size_t ncontractions) -> void {
+        if (p == partners.size()) {
+          // the rest stay uncontracted, unless qp annihilators are
+          // contracted by the subsequent NormalOperator objects
+          if (nleft > 0 && !group.qpann_space && full_contractions) return;
+          if (group.qpann_space) next_key[g] += nleft;
+          auto &w = next_states[next_key];
+          w += Estimate{
+              .ncontractions = saturating_mul(weight.ncontractions,
+                                              ncontractions),
+              .nterms = weight.nterms};
+          if (group.qpann_space) next_key[g] -= nleft;
+          return;
+        }
+        self(self, p + 1, nleft, ncontractions);
+        const auto h = partners[p];
+        const auto nmax = std::min(key[h], nleft);
+        if (nmax == 0) return;
+        std::size_t saved_word = 0;
+        if (partner_required_bit[p]) {
+          const auto bit = *partner_required_bit[p];
+          auto &word = next_key[ngroups + bit / word_nbits];
+          saved_word = word;
+          word |= std::size_t{1} << (bit % word_nbits);
+        }
+        for (std::size_t c = 1; c <= nmax; ++c) {
+          // choose c Op objects of this group and contract them with c of the
+          // key[h] uncontracted Op objects of group h
+          next_key[h] = key[h] - c;
+          self(self, p + 1, nleft - c,
+               saturating_mul(saturating_mul(ncontractions, binomial(nleft, c)),
+                              falling_factorial(key[h], c)));
+        }
+        next_key[h] = key[h];
+        if (partner_required_bit[p]) {
+          const auto bit = *partner_required_bit[p];
+          next_key[ngroups + bit / word_nbits] = saved_word;
+        }
+      };
+      distribute(distribute, 0, group.size, 1);
+    }
+    states = std::move(next_states);
+  }
+
+  Estimate result;
+  for (const auto &[key, weight] : states) {
+    if (full_contractions &&
+        std::any_of(key.begin(), key.begin() + ngroups,
+                    [](std::size_t n) { return n != 0; }))
+      continue;
+    bool all_required_connected = true;
+    for (std::size_t bit = 0; bit != required.size(); ++bit)
+      all_required_connected =
+          all_required_connected &&
+          ((key[ngroups + bit / word_nbits] >> (bit % word_nbits)) & 1);
+    if (all_required_connected) result += weight;
+  }
+  return result;
+}
+
 template <Statistics S>
 void WickTheorem<S>::reduce(ExprPtr &expr) const {
   if (Logger::instance().wick_reduce) {
@@ -25,6 +25,7 @@
 #include <range/v3/view/transform.hpp>
 
 #include <algorithm>
+#include <functional>
 
 namespace sequant::mbpt {
 
@@ -265,6 +266,172 @@ Eigen::MatrixXd compute_biorthogonalizer_matrix(std::size_t n_particles,
   return pinv;
 }
 
+/// A non-increasing sequence of positive integers; labels both the irreps of
+/// S_n (Young diagrams) and its conjugacy classes (cycle types)
+using Partition = container::svector<std::size_t>;
+
+/// \return all partitions of \p n whose parts do not exceed \p max_part
+container::svector<Partition> partitions(std::size_t n, std::size_t max_part) {
+  container::svector<Partition> result;
+  Partition current;
+  auto recurse = [&](auto&& self, std::size_t remainder,
+                     std::size_t max) -> void {
+    if (remainder == 0) {
+      result.push_back(current);
+      return;
+    }
+    for (std::size_t part = std::min(remainder, max); part > 0; --part) {
+      current.push_back(part);
+      self(self, remainder - part, part);
+      current.pop_back();
+    }
+  };
+  recurse(recurse, n, max_part);
+  return result;
+}
+
+/// \return the cycle type of \p perm acting on \p n_particles elements
+Partition cycle_type(const perm::Permutation& perm, std::size_t n_particles) {
+  Partition result;
+  container::svector<bool> visited(n_particles, false);
+  for (std::size_t i = 0; i < n_particles; ++i) {
+    std::size_t length = 0;
+    for (std::size_t j = i; !visited[j];
+         j = static_cast<std::size_t>(perm->image(j))) {
+      visited[j] = true;
+      ++length;
+    }
+    if (length > 0) result.push_back(length);
+  }
+  std::sort(result.begin(), result.end(), std::greater<>{});
+  return result;
+}
+
+/// \brief Evaluates the irreducible character of S_n via the
+/// Murnaghan-Nakayama rule
+///
+/// The irrep is given by the beta-set (strictly decreasing first-column hook
+/// lengths) of its Young diagram. Removing a rim hook of length r moves a bead
+/// from position b to the vacant position b-r, with the sign given by the
+/// parity of the number of beads in between.
+///
+/// \param beta The beta-set of the irrep
+/// \param mu The cycle type of the conjugacy class
+/// \param first The first part of \p mu that has not been removed yet
+///
+/// \return The character of the irrep on the conjugacy class
+sequant::intmax_t character(const Partition& beta, const Partition& mu,
+                            std::size_t first = 0) {
+  if (first == mu.size()) return 1;
+
+  const std::size_t r = mu[first];
+  sequant::intmax_t result = 0;
+  for (std::size_t i = 0; i < beta.size() && beta[i] >= r; ++i) {
+    const std::size_t target = beta[i] - r;
+    if (std::find(beta.begin(), beta.end(), target) != beta.end()) continue;
+
+    Partition next = beta;
+    next.erase(next.begin() + i);
+    auto pos =
+        std::upper_bound(next.begin(), next.end(), target, std::greater<>{});
+    const auto n_between = static_cast<std::size_t>(pos - next.begin()) - i;
+    next.insert(pos, target);
+
+    const auto chi = character(next, mu, first + 1);
+    result += (n_between % 2 == 0) ? chi : -chi;
+  }
+  return result;
+}
+
+/// \brief Values of the NNS projector and of the (normalized) biorthogonalizer
+/// matrices as class functions of the relative permutation
+///
+/// The permutational overlap matrix is M(σ,τ) = f(σ⁻¹τ) with the class
+/// function f(g) = (-1)^n (-2)^{c(g)}, i.e. it represents a central element
+/// of the group algebra of S_n. On the irrep λ this element acts as the scalar
+/// ω_λ = ∏ (2 - content) over the boxes of λ (Jucys-Murphy), hence the null
+/// space of M consists of the irreps with more than two columns. Expanding the
+/// remaining isotypic projectors in characters yields, with r = Σ d_λ²:
+///   NNS projector:     (1/r) Σ_λ d_λ χ_λ(g)
+///   biorthogonalizer:  (1/r) Σ_λ d_λ χ_λ(g) / ω_λ
+/// Only the partitions of n need to be visited instead of the n!×n! matrix.
+struct ClassWeights {
+  container::map<Partition, sequant::rational> nns_projector;
+  container::map<Partition, sequant::rational> biorthogonalizer;
+};
+
+ClassWeights compute_class_weights(std::size_t n_particles) {
+  const Partition identity_class(n_particles, 1);
+
+  container::svector<Partition> betas;
+  container::svector<sequant::intmax_t> dims;
+  container::svector<sequant::intmax_t> omegas;
+  sequant::intmax_t rank = 0;
+  for (const Partition& lambda : partitions(n_particles, 2)) {
+    Partition beta(lambda.size());
+    for (std::size_t row = 0; row < lambda.size(); ++row) {
+      beta[row] = lambda[row] + lambda.size() - 1 - row;
+    }
+
+    sequant::intmax_t omega = 1;
+    for (std::size_t row = 0; row < lambda.size(); ++row) {
+      for (std::size_t col = 0; col < lambda[row]; ++col) {
+        omega *= 2 + row - col;
+      }
+    }
+
+    dims.push_back(character(beta, identity_class));
+    omegas.push_back(omega);
+    rank += dims.back() * dims.back();
+    betas.push_back(std::move(beta));
+  }
+
+  ClassWeights result;
+  for (const Partition& mu : partitions(n_particles, n_particles)) {
+    sequant::intmax_t nns = 0;
+    sequant::rational biorth = 0;
+    for (std::size_t i = 0; i < betas.size(); ++i) {
+      const sequant::intmax_t weight = dims[i] * character(betas[i], mu);
+      nns += weight;
+      biorth += sequant::rational(weight, omegas[i]);
+    }
+    result.nns_projector.emplace(mu, sequant::rational(nns, rank));
+    result.biorthogonalizer.emplace(mu, biorth / rank);
+  }
+  return result;
+}
+
+/// \return (memoized) class weights for the given rank
+const ClassWeights& class_weights(std::size_t n_particles) {
+  static std::mutex cache_mutex;
+  static std::condition_variable cache_cv;
+  static container::map<std::size_t, std::optional<ClassWeights>> cache;
+
+  return sequant::detail::memoize(
+      cache, cache_mutex, cache_cv, n_particles,
+      [&] { return compute_class_weights(n_particles); });
+}
+
+/// \return row \p row of the matrix whose elements are the class function
+/// \p weights of the relative permutation
+std::vector<sequant::rational> class_function_row(
+    const container::map<Partition, sequant::rational>& weights,
+    std::size_t n_particles, std::size_t row) {
+  const auto num_perms = static_cast<std::size_t>(factorial(n_particles));
+
+  perm::Permutation ref = perm::unrank(row, n_particles);
+  ref->invert();
+
+  std::vector<sequant::rational> result;
+  result.reserve(num_perms);
+  for (std::size_t rank = 0; rank < num_perms; ++rank) {
+    perm::Permutation current = perm::unrank(rank, n_particles);
+    current->postMultiply(ref);
+    result.push_back(weights.at(cycle_type(current, n_particles)));
+  }
+  return result;
+}
+
 void sort_pairings(ParticlePairings& pairing) {
   std::stable_sort(pairing.begin(), pairing.end(),
                    compare_first_less<IndexPair>{});
@@ -483,32 +650,28 @@ void biorthogonal_transform(container::svector<ResultExpr>& result_exprs,
 
   using HardcodedMatrix =
       Eigen::Matrix<sequant::rational, Eigen::Dynamic, Eigen::Dynamic>;
-  using ComputedMatrix = Eigen::MatrixXd;
   using CacheKey = std::pair<std::size_t, double>;
 
   static std::mutex cache_mutex;
   static std::condition_variable cache_cv;
   static container::map<CacheKey, std::optional<HardcodedMatrix>>
       hardcoded_cache;
-  static container::map<CacheKey, std::optional<ComputedMatrix>> computed_cache;
 
   constexpr std::size_t max_rank_hardcoded_biorthogonalizer_matrix = 5;
   CacheKey key{n_particles, threshold};
 
   const HardcodedMatrix* hardcoded_coefficients = nullptr;
-  const ComputedMatrix* computed_coefficients = nullptr;
+  // beyond the hardcoded ranks the coefficients are exact class functions of
+  // the relative permutation, see ClassWeights
+  const container::map<Partition, sequant::rational>* computed_coefficients =
+      nullptr;
 
   if (n_particles <= max_rank_hardcoded_biorthogonalizer_matrix) {
     hardcoded_coefficients = &sequant::detail::memoize(
         hardcoded_cache, cache_mutex, cache_cv, key,
         [&] { return hardcoded_biorthogonalizer_matrix(n_particles); });
   } else {
-    computed_coefficients = &sequant::detail::memoize(
-        computed_cache, cache_mutex, cache_cv, key, [&] {
-          return compute_biorthogonalizer_matrix(n_particles, threshold);
-        });
-    SEQUANT_ASSERT(num_perms == computed_coefficients->rows());
-    SEQUANT_ASSERT(num_perms == computed_coefficients->cols());
+    computed_coefficients = &class_weights(n_particles).biorthogonalizer;
   }
 
   for (std::size_t i = 0; i < result_exprs.size(); ++i) {
@@ -523,8 +686,7 @@ void biorthogonal_transform(container::svector<ResultExpr>& result_exprs,
       sequant::rational coeff =
           (n_particles <= max_rank_hardcoded_biorthogonalizer_matrix)
               ? (*hardcoded_coefficients)(ranks.at(i), rank)
-              : to_rational((*computed_coefficients)(ranks.at(i), rank),
-                            threshold);
+              : computed_coefficients->at(cycle_type(perm, n_particles));
 
       result_exprs.at(i).expression() +=
           ex<Constant>(coeff) *
@@ -705,6 +867,31 @@ std::vector<double> compute_nns_p_coeffs(std::size_t n_particles,
   return coeffs;
 }
 
+std::vector<double> compute_biorthogonalizer_row(std::size_t n_particles,
+                                                 double threshold) {
+  auto normalized_pinv =
+      compute_biorthogonalizer_matrix(n_particles, threshold);
+
+  std::vector<double> coeffs;
+  coeffs.reserve(normalized_pinv.cols());
+  for (Eigen::Index i = 0; i < normalized_pinv.cols(); ++i) {
+    coeffs.push_back(normalized_pinv(0, i));
+  }
+  return coeffs;
+}
+
+std::vector<sequant::rational> nns_projector_row(std::size_t n_particles) {
+  // same row as the one extracted by compute_nns_p_coeffs
+  return class_function_row(
+      class_weights(n_particles).nns_projector, n_particles,
+      static_cast<std::size_t>(factorial(n_particles)) - 1);
+}
+
+std::vector<sequant::rational> biorthogonalizer_row(std::size_t n_particles) {
+  return class_function_row(class_weights(n_particles).biorthogonalizer,
+                            n_particles, 0);
+}
+
 container::svector<size_t> compute_permuted_indices(
     const container::svector<size_t>& indices, size_t perm_rank,
     size_t n_particles) {
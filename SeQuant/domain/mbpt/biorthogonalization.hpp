@@ -2,8 +2,10 @@
 #define SEQUANT_DOMAIN_MBPT_BIORTHOGONALIZE_HPP
 
 #include <SeQuant/core/container.hpp>
+#include <SeQuant/core/eval/permuted_sum.hpp>
 #include <SeQuant/core/expr.hpp>
 #include <SeQuant/core/index.hpp>
+#include <SeQuant/core/math.hpp>
 #include <SeQuant/core/slotted_index.hpp>
 #include <SeQuant/core/utility/indices.hpp>
 #include <SeQuant/core/utility/memoize.hpp>
@@ -27,6 +29,7 @@
 #include <condition_variable>
 #include <cstddef>
 #include <mutex>
+#include <numeric>
 #include <optional>
 #include <vector>
 
@@ -123,6 +126,47 @@ namespace detail {
     double pseudoinverse_threshold =
         default_biorthogonalizer_pseudoinverse_threshold);
 
+/// \brief Computes one row of the NNS projector matrix exactly
+///
+/// Both the permutational overlap matrix and its NNS projector are class
+/// functions of the relative permutation, so the coefficients are obtained from
+/// the irreducible characters of the symmetric group (Murnaghan-Nakayama rule)
+/// at a cost that scales with the number of partitions of \p n_particles rather
+/// than with the n!×n! overlap matrix; no pseudoinverse is involved.
+///
+/// \param n_particles The rank of external index pairs
+///
+/// \return Vector of exact NNS projector weights representing the same row as
+///         compute_nns_p_coeffs
+[[nodiscard]] std::vector<sequant::rational> nns_projector_row(
+    std::size_t n_particles);
+
+/// \brief Computes the first row of the biorthogonalizer matrix, i.e. of the
+///        normalized pseudoinverse of the permutational overlap matrix
+///
+/// \param n_particles The rank of external index pairs
+/// \param pseudoinverse_threshold The threshold to compute the pseudoinverse
+///        matrix
+///
+/// \return Vector of computed biorthogonal coefficients
+[[nodiscard]] std::vector<double> compute_biorthogonalizer_row(
+    std::size_t n_particles,
+    double pseudoinverse_threshold =
+        default_biorthogonalizer_pseudoinverse_threshold);
+
+/// \brief Computes the first row of the biorthogonalizer matrix exactly
+///
+/// Like nns_projector_row, this is obtained from the irreducible characters of
+/// the symmetric group; these are the coefficients biorthogonal_transform uses
+/// beyond the hardcoded ranks.
+///
+/// \param n_particles The rank of external index pairs
+///
+/// \return Vector of exact biorthogonal coefficients representing the same
+///         row as compute_biorthogonalizer_row
+[[nodiscard]] std::vector<sequant::rational> biorthogonalizer_row(
+    std::size_t n_particles);
+
 /// \brief Provides permuted indices using libperm unrank function
 ///
 /// \param indices The indices to permute
@@ -212,7 +256,8 @@ std::optional<std::vector<T>> hardcoded_nns_projector(std::size_t n_particles) {
 /// \tparam T The numeric type (must be floating point or complex)
 /// \param n_particles The rank of external index pairs
 /// \param threshold The threshold to compute the pseudoinverse matrix
-///        (set to default_biorthogonalizer_pseudoinverse_threshold)
+///        (set to default_biorthogonalizer_pseudoinverse_threshold); only
+///        part of the cache key since the weights are computed exactly
 ///
 /// \return (memoized) Vector of hrdcoded/computed NNS projection weights
 template <typename T>
@@ -243,17 +288,55 @@ template <typename T>
             return std::move(hardcoded_coeffs.value());
           }
         }
-        auto coeffs =
-            detail::compute_nns_p_coeffs(n_particles, pseudoinverse_threshold);
+        auto coeffs = detail::nns_projector_row(n_particles);
         std::vector<T> nns_p_coeffs;
         nns_p_coeffs.reserve(coeffs.size());
         for (const auto& c : coeffs) {
-          nns_p_coeffs.push_back(static_cast<T>(c));
+          nns_p_coeffs.push_back(static_cast<T>(static_cast<double>(c)));
         }
         return nns_p_coeffs;
       });
 }
 
+/// \brief Single-pass NNS projection of a dense row-major tensor
+///
+/// Computes out(b,k) = Σ_p w_p in(b,σ_p(k)), where b runs over the bra modes
+/// and σ_p over the permutations of the ket modes in libperm rank order, i.e.
+/// the sum of the n! permuted copies without materializing any of them, see
+/// sequant::detail::permuted_sum_dense.
+///
+/// \param in The input data
+/// \param out The output data, must not alias \p in
+/// \param extents The extents of all modes; the ket extents must be equal
+/// \param bra_rank The number of leading (bra) modes
+/// \param weights The NNS projection weights, see nns_projection_weights
+template <typename T>
+void nns_project_dense(const T* in, T* out,
+                       const container::svector<std::size_t>& extents,
+                       std::size_t bra_rank, const std::vector<T>& weights) {
+  const std::size_t rank = extents.size();
+  SEQUANT_ASSERT(bra_rank < rank);
+  const std::size_t ket_rank = rank - bra_rank;
+  SEQUANT_ASSERT(weights.size() ==
+                 static_cast<std::size_t>(factorial(ket_rank)));
+
+  container::svector<std::size_t> ket_ords(ket_rank);
+  std::iota(ket_ords.begin(), ket_ords.end(), std::size_t{0});
+
+  std::vector<container::svector<std::size_t>> annots;
+  annots.reserve(weights.size());
+  for (std::size_t p = 0; p < weights.size(); ++p) {
+    container::svector<std::size_t> annot(bra_rank);
+    std::iota(annot.begin(), annot.end(), std::size_t{0});
+    for (auto i : compute_permuted_indices(ket_ords, p, ket_rank)) {
+      annot.push_back(bra_rank + i);
+    }
+    annots.push_back(std::move(annot));
+  }
+
+  sequant::detail::permuted_sum_dense(in, out, extents, annots, weights);
+}
+
 }  // namespace detail
 
 #if defined(SEQUANT_HAS_TILEDARRAY)
@@ -335,6 +418,9 @@ auto biorthogonal_nns_project(TA::DistArray<Args...> const& arr,
 /// \brief This function is used to implement
 /// ResultPtr::biorthogonal_nns_project for btas::Tensor
 ///
+/// \note The projection is applied in a single pass over the (row-major,
+///       contiguous) storage of \p arr, see detail::nns_project_dense
+///
 /// \param arr The array to be "cleaned up"
 /// \param bra_rank The rank of the bra indices
 ///
@@ -342,7 +428,6 @@ auto biorthogonal_nns_project(TA::DistArray<Args...> const& arr,
 template <typename... Args>
 auto biorthogonal_nns_project_btas(btas::Tensor<Args...> const& arr,
                                    size_t bra_rank) {
-  using ranges::views::iota;
   size_t const rank = arr.rank();
   SEQUANT_ASSERT(bra_rank <= rank);
   size_t const ket_rank = rank - bra_rank;
@@ -356,45 +441,17 @@ auto biorthogonal_nns_project_btas(btas::Tensor<Args...> const& arr,
   const auto& nns_p_coeffs =
       detail::nns_projection_weights<numeric_type>(ket_rank);
 
-  btas::Tensor<Args...> result;
-
-  sequant::detail::perm_t perm =
-      iota(size_t{0}, rank) | ranges::to<sequant::detail::perm_t>;
-  sequant::detail::perm_t bra_perm =
-      iota(size_t{0}, bra_rank) | ranges::to<sequant::detail::perm_t>;
-  sequant::detail::perm_t ket_perm =
-      iota(bra_rank, rank) | ranges::to<sequant::detail::perm_t>;
-
   if (ket_rank > 2 && !nns_p_coeffs.empty()) {
-    bool result_initialized = false;
+    container::svector<std::size_t> extents(rank);
+    for (size_t i = 0; i < rank; ++i) extents[i] = arr.extent(i);
 
-    size_t num_perms = nns_p_coeffs.size();
-    for (size_t perm_rank = 0; perm_rank < num_perms; ++perm_rank) {
-      sequant::detail::perm_t permuted_ket =
-          detail::compute_permuted_indices(ket_perm, perm_rank, ket_rank);
-
-      numeric_type coeff = nns_p_coeffs[perm_rank];
-
-      sequant::detail::perm_t annot = bra_perm;
-      annot.insert(annot.end(), permuted_ket.begin(), permuted_ket.end());
-
-      btas::Tensor<Args...> temp;
-      btas::permute(arr, annot, temp, perm);
-      btas::scal(coeff, temp);
-
-      if (result_initialized) {
-        result += temp;
-      } else {
-        result = temp;
-        result_initialized = true;
-      }
-    }
-
-  } else {
-    result = arr;
+    btas::Tensor<Args...> result{arr.range()};
+    detail::nns_project_dense(arr.data(), result.data(), extents, bra_rank,
+                              nns_p_coeffs);
+    return result;
   }
 
-  return result;
+  return arr;
 }
 
 template <typename... Args>
@@ -410,6 +467,9 @@ auto biorthogonal_nns_project(btas::Tensor<Args...> const& arr,
 /// \brief This function is used to implement
 /// ResultPtr::biorthogonal_nns_project for TAPPTensor
 ///
+/// \note The projection is applied in a single pass, see
+///       detail::nns_project_dense
+///
 /// \param arr The tensor to be "cleaned up"
 /// \param bra_rank The rank of the bra indices
 ///
@@ -417,7 +477,6 @@ auto biorthogonal_nns_project(btas::Tensor<Args...> const& arr,
 template <typename T, typename Alloc>
 auto biorthogonal_nns_project_tapp(TAPPTensor<T, Alloc> const& arr,
                                    size_t bra_rank) {
-  using ranges::views::iota;
   size_t const rank = arr.rank();
   SEQUANT_ASSERT(bra_rank <= rank);
   size_t const ket_rank = rank - bra_rank;
@@ -431,47 +490,17 @@ auto biorthogonal_nns_project_tapp(TAPPTensor<T, Alloc> const& arr,
   const auto& nns_p_coeffs =
       detail::nns_projection_weights<numeric_type>(ket_rank);
 
-  using perm_type = container::svector<size_t>;
-
-  TAPPTensor<T, Alloc> result;
-
-  perm_type perm = iota(size_t{0}, rank) | ranges::to<perm_type>;
-  perm_type bra_perm = iota(size_t{0}, bra_rank) | ranges::to<perm_type>;
-  perm_type ket_perm = iota(bra_rank, rank) | ranges::to<perm_type>;
-
   if (ket_rank > 2 && !nns_p_coeffs.empty()) {
-    bool result_initialized = false;
-
-    size_t num_perms = nns_p_coeffs.size();
-    for (size_t perm_rank = 0; perm_rank < num_perms; ++perm_rank) {
-      perm_type permuted_ket =
-          detail::compute_permuted_indices(ket_perm, perm_rank, ket_rank);
-
-      numeric_type coeff = nns_p_coeffs[perm_rank];
-
-      perm_type annot = bra_perm;
-      annot.insert(annot.end(), permuted_ket.begin(), permuted_ket.end());
+    container::svector<std::size_t> extents(arr.extents().begin(),
+                                            arr.extents().end());
 
-      container::svector<int64_t> annot_i64(annot.begin(), annot.end());
-      container::svector<int64_t> perm_i64(perm.begin(), perm.end());
-
-      TAPPTensor<T, Alloc> temp;
-      tapp_ops::permute(arr, annot_i64, temp, perm_i64);
-      tapp_ops::scal(coeff, temp);
-
-      if (result_initialized) {
-        result += temp;
-      } else {
-        result = temp;
-        result_initialized = true;
-      }
-    }
-
-  } else {
-    result = arr;
+    TAPPTensor<T, Alloc> result(arr.extents());
+    detail::nns_project_dense(arr.data(), result.data(), extents, bra_rank,
+                              nns_p_coeffs);
+    return result;
   }
 
-  return result;
+  return arr;
 }
 
 template <typename T, typename Alloc>
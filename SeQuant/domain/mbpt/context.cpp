@@ -3,16 +3,8 @@
 
 #include <range/v3/algorithm/contains.hpp>
 
-#ifdef SEQUANT_CONTEXT_MANIPULATION_THREADSAFE
-#include <mutex>
-#endif
-
 namespace sequant::mbpt {
 
-#ifdef SEQUANT_CONTEXT_MANIPULATION_THREADSAFE
-static std::recursive_mutex mbpt_ctx_mtx;  // used to protect the MBPT context
-#endif
-
 Context::Context(Options options)
     : csv_(options.csv),
       op_registry_(options.op_registry_ptr
@@ -72,16 +64,11 @@ bool operator!=(Context const& left, Context const& right) {
 }
 
 const Context& get_default_mbpt_context() {
-#ifdef SEQUANT_CONTEXT_MANIPULATION_THREADSAFE
-  std::scoped_lock lock(mbpt_ctx_mtx);
-#endif
+  // N.B. lock-free, reads the current snapshot
   return sequant::detail::get_implicit_context<Context>();
 }
 
 void set_default_mbpt_context(const Context& ctx) {
-#ifdef SEQUANT_CONTEXT_MANIPULATION_THREADSAFE
-  std::scoped_lock lock(mbpt_ctx_mtx);
-#endif
   sequant::detail::set_implicit_context(ctx);
 }
 
@@ -90,17 +77,11 @@ void set_default_mbpt_context(const Context::Options& options) {
 }
 
 void reset_default_mbpt_context() {
-#ifdef SEQUANT_CONTEXT_MANIPULATION_THREADSAFE
-  std::scoped_lock lock(mbpt_ctx_mtx);
-#endif
   sequant::detail::reset_implicit_context<Context>();
 }
 
 [[nodiscard]] sequant::detail::ImplicitContextResetter<Context>
 set_scoped_default_mbpt_context(const Context& f) {
-#ifdef SEQUANT_CONTEXT_MANIPULATION_THREADSAFE
-  std::scoped_lock lock(mbpt_ctx_mtx);
-#endif
   return sequant::detail::set_scoped_implicit_context(f);
 }
 
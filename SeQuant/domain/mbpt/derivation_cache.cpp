@@ -0,0 +1,258 @@
+#include <SeQuant/core/context.hpp>
+#include <SeQuant/core/expr.hpp>
+#include <SeQuant/core/io/shorthands.hpp>
+#include <SeQuant/core/options.hpp>
+#include <SeQuant/core/utility/exception.hpp>
+#include <SeQuant/core/utility/macros.hpp>
+#include <SeQuant/core/utility/string.hpp>
+#include <SeQuant/domain/mbpt/context.hpp>
+#include <SeQuant/domain/mbpt/derivation_cache.hpp>
+#include <SeQuant/version.hpp>
+
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+namespace sequant::mbpt {
+
+namespace {
+
+constexpr std::string_view entry_header = "SeQuant derivation cache v1";
+
+/// 64-bit FNV-1a hash; unlike std::hash it is stable across builds and
+/// platforms, which is required for content addressing
+std::uint64_t fnv1a(std::string_view str) {
+  std::uint64_t h = 0xcbf29ce484222325ULL;
+  for (unsigned char c : str) {
+    h ^= c;
+    h *= 0x100000001b3ULL;
+  }
+  return h;
+}
+
+/// @return name of the cache entry for @p full_key
+std::string entry_name(std::string_view full_key) {
+  std::ostringstream oss;
+  oss << std::hex << std::setw(16) << std::setfill('0') << fnv1a(full_key)
+      << ".sqd";
+  return oss.str();
+}
+
+std::string full_key(const std::string& key) {
+  return key + ";" + DerivationCache::fingerprint();
+}
+
+std::string to_line(const ExprPtr& expr) {
+  return expr ? toUtf8(serialize(expr)) : std::string{};
+}
+
+/// @return true if @p derived and @p cached are the same expression up to
+/// the order of summands and the labels of dummy indices
+bool equivalent(const ExprPtr& derived, const ExprPtr& cached) {
+  if (!derived || !cached) return !derived && !cached;
+  const auto opts = SimplifyOptions::default_options().copy_and_set(
+      CanonicalizeOptions::IgnoreNamedIndexLabel::No);
+  auto x = derived->clone();
+  auto y = cached->clone();
+  simplify(x, opts);
+  simplify(y, opts);
+  return x == y;
+}
+
+std::mutex default_cache_mtx;
+std::optional<std::shared_ptr<const DerivationCache>> default_cache;
+
+}  // namespace
+
+DerivationCache::DerivationCache(Options options)
+    : options_(std::move(options)) {}
+
+std::shared_ptr<const DerivationCache> DerivationCache::from_environment() {
+  const char* dir = std::getenv("SEQUANT_DERIVATION_CACHE");
+  if (!dir || std::string_view(dir).empty()) return nullptr;
+
+  Mode mode = Mode::ReadWrite;
+  if (const char* m = std::getenv("SEQUANT_DERIVATION_CACHE_MODE")) {
+    const std::string_view mode_str(m);
+    if (mode_str == "off")
+      mode = Mode::Off;
+    else if (mode_str == "validate")
+      mode = Mode::Validate;
+    else if (!mode_str.empty() && mode_str != "readwrite")
+      throw Exception("SEQUANT_DERIVATION_CACHE_MODE must be one of off, "
+                      "readwrite, or validate; got " +
+                      std::string(mode_str));
+  }
+  return std::make_shared<const DerivationCache>(
+      Options{.directory = dir, .mode = mode});
+}
+
+const std::filesystem::path& DerivationCache::directory() const {
+  return options_.directory;
+}
+
+DerivationCache::Mode DerivationCache::mode() const { return options_.mode; }
+
+std::filesystem::path DerivationCache::path(const std::string& key) const {
+  return options_.directory / entry_name(full_key(key));
+}
+
+std::string DerivationCache::fingerprint() {
+  std::ostringstream oss;
+  oss << "version=" << SEQUANT_VERSION << '@' << git_revision() << ';'
+      << get_default_context().fingerprint();
+
+  const auto& mbpt_ctx = get_default_mbpt_context();
+  const auto registry = mbpt_ctx.op_registry();
+  oss << ";csv=" << static_cast<int>(mbpt_ctx.csv()) << ";ops=";
+  for (const auto& [op, op_class] : *registry)
+    oss << toUtf8(op) << ':' << static_cast<int>(op_class) << ':'
+        << static_cast<int>(registry->hermiticity(op)) << ',';
+
+  return oss.str();
+}
+
+std::optional<std::vector<std::string>> DerivationCache::read(
+    const std::string& full_key) const {
+  std::ifstream ifs(options_.directory / entry_name(full_key),
+                    std::ios::binary);
+  if (!ifs) return std::nullopt;
+
+  std::string line;
+  if (!std::getline(ifs, line) || line != entry_header) return std::nullopt;
+  // guard against hash collisions
+  if (!std::getline(ifs, line) || line != full_key) return std::nullopt;
+  if (!std::getline(ifs, line)) return std::nullopt;
+  std::size_t n = 0;
+  try {
+    n = std::stoul(line);
+  } catch (const std::exception&) {
+    return std::nullopt;
+  }
+
+  std::vector<std::string> lines;
+  lines.reserve(n);
+  for (std::size_t i = 0; i != n; ++i) {
+    if (!std::getline(ifs, line)) return std::nullopt;  // truncated entry
+    lines.emplace_back(std::move(line));
+  }
+  return lines;
+}
+
+std::optional<std::vector<ExprPtr>> DerivationCache::load(
+    const std::string& key) const {
+  const auto lines = read(full_key(key));
+  if (!lines) return std::nullopt;
+
+  std::vector<ExprPtr> result;
+  result.reserve(lines->size());
+  try {
+    for (const auto& line : *lines)
+      result.emplace_back(line.empty() ? ExprPtr{}
+                                       : deserialize<ExprPtr>(line));
+  } catch (const std::exception&) {
+    // unreadable entries are treated as misses and get overwritten
+    return std::nullopt;
+  }
+  return result;
+}
+
+void DerivationCache::store(const std::string& key,
+                            const std::vector<ExprPtr>& exprs) const {
+  std::vector<std::string> lines;
+  lines.reserve(exprs.size());
+  for (const auto& expr : exprs) {
+    lines.emplace_back(to_line(expr));
+    // the entry format is line-based
+    if (lines.back().find('\n') != std::string::npos) return;
+  }
+
+  std::error_code ec;
+  std::filesystem::create_directories(options_.directory, ec);
+  if (ec) return;
+
+  // write to a unique temporary then rename, so that concurrent readers and
+  // writers only ever see complete entries
+  const auto fkey = full_key(key);
+  const auto entry = options_.directory / entry_name(fkey);
+  auto tmp = entry;
+  tmp += ".tmp" +
+         std::to_string(std::hash<std::thread::id>{}(
+             std::this_thread::get_id())) +
+         "." + std::to_string(std::random_device{}());
+  {
+    std::ofstream ofs(tmp, std::ios::binary | std::ios::trunc);
+    if (!ofs) return;
+    ofs << entry_header << '\n' << fkey << '\n' << lines.size() << '\n';
+    for (const auto& line : lines) ofs << line << '\n';
+    if (!ofs) {
+      ofs.close();
+      std::filesystem::remove(tmp, ec);
+      return;
+    }
+  }
+  std::filesystem::rename(tmp, entry, ec);
+  if (ec) std::filesystem::remove(tmp, ec);
+}
+
+std::vector<ExprPtr> DerivationCache::get_or_derive(
+    const std::string& key,
+    const std::function<std::vector<ExprPtr>()>& derive) const {
+  switch (options_.mode) {
+    case Mode::Off:
+      return derive();
+
+    case Mode::ReadWrite: {
+      if (auto cached = load(key)) return std::move(*cached);
+      auto result = derive();
+      store(key, result);
+      return result;
+    }
+
+    case Mode::Validate: {
+      auto result = derive();
+      const auto cached = load(key);
+      if (!cached) {
+        store(key, result);
+        return result;
+      }
+      if (cached->size() != result.size())
+        throw Exception("DerivationCache: cached result of " + key + " has " +
+                        std::to_string(cached->size()) +
+                        " elements, derived result has " +
+                        std::to_string(result.size()));
+      for (std::size_t i = 0; i != result.size(); ++i) {
+        if (!equivalent(result[i], (*cached)[i]))
+          throw Exception("DerivationCache: cached result of " + key +
+                          " differs from the derived result in element " +
+                          std::to_string(i));
+      }
+      return result;
+    }
+  }
+
+  SEQUANT_UNREACHABLE;
+}
+
+std::shared_ptr<const DerivationCache> default_derivation_cache() {
+  std::scoped_lock lock(default_cache_mtx);
+  if (!default_cache) default_cache = DerivationCache::from_environment();
+  return *default_cache;
+}
+
+void set_default_derivation_cache(
+    std::shared_ptr<const DerivationCache> cache) {
+  std::scoped_lock lock(default_cache_mtx);
+  default_cache = std::move(cache);
+}
+
+}  // namespace sequant::mbpt
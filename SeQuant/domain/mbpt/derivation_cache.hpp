@@ -0,0 +1,111 @@
+#ifndef SEQUANT_DOMAIN_MBPT_DERIVATION_CACHE_HPP
+#define SEQUANT_DOMAIN_MBPT_DERIVATION_CACHE_HPP
+
+#include <SeQuant/core/expr_fwd.hpp>
+
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace sequant::mbpt {
+
+// clang-format off
+/// @brief content-addressed on-disk cache of derived equations
+///
+/// A cache entry is addressed by a key that describes the derivation
+/// (generator, its arguments and options), extended by a fingerprint of
+/// the default sequant::Context (vacuum, metric, SP basis, IndexSpaceRegistry),
+/// the default mbpt::Context (CSV, OpRegistry) and the SeQuant version.
+/// Each entry is a UTF-8 text file named after a 64-bit hash of the full key;
+/// it holds the full key (to detect hash collisions) followed by the serialized
+/// expressions, one per line, with null expressions stored as empty lines.
+///
+/// Entries are written to a temporary file first and then renamed, hence
+/// concurrent jobs sharing the cache directory never observe partial entries.
+///
+/// The default cache can be configured via the environment:
+/// - `SEQUANT_DERIVATION_CACHE` specifies the cache directory; if not set, caching is disabled
+/// - `SEQUANT_DERIVATION_CACHE_MODE` is one of `off`, `readwrite` (default), or `validate`
+// clang-format on
+class DerivationCache {
+ public:
+  enum class Mode {
+    /// always derive, never access the cache
+    Off,
+    /// return cached result on hit, derive and store on miss
+    ReadWrite,
+    /// always derive and compare against the cached result, store on miss
+    /// @throw Exception if the derived and cached results differ
+    Validate
+  };
+
+  struct Options {
+    /// directory holding the cache entries, created if does not exist
+    std::filesystem::path directory;
+    /// see DerivationCache::Mode
+    Mode mode = Mode::ReadWrite;
+  };
+
+  /// @brief constructs a cache
+  /// @param options configuration options @see DerivationCache::Options
+  explicit DerivationCache(Options options);
+
+  /// @return cache configured from the environment, or null if
+  /// `SEQUANT_DERIVATION_CACHE` is not set
+  static std::shared_ptr<const DerivationCache> from_environment();
+
+  /// @return the cache directory
+  [[nodiscard]] const std::filesystem::path& directory() const;
+
+  /// @return the cache mode
+  [[nodiscard]] Mode mode() const;
+
+  /// @brief looks up the result of a derivation, deriving it if necessary
+  /// @param key description of the derivation, must not contain newlines
+  /// @param derive callable producing the result of the derivation
+  /// @return the cached result on a hit, the result of @p derive otherwise
+  /// @throw Exception in Mode::Validate if the cached and derived results
+  /// differ
+  [[nodiscard]] std::vector<ExprPtr> get_or_derive(
+      const std::string& key,
+      const std::function<std::vector<ExprPtr>()>& derive) const;
+
+  /// @param key description of the derivation
+  /// @return the cached result, or std::nullopt if absent or unreadable
+  [[nodiscard]] std::optional<std::vector<ExprPtr>> load(
+      const std::string& key) const;
+
+  /// @brief stores @p exprs as the result of derivation @p key
+  /// @note failure to write the entry is not an error, the entry is skipped
+  void store(const std::string& key, const std::vector<ExprPtr>& exprs) const;
+
+  /// @param key description of the derivation
+  /// @return the path to the cache entry for @p key
+  [[nodiscard]] std::filesystem::path path(const std::string& key) const;
+
+  /// @return fingerprint of the default contexts and of the SeQuant version
+  /// that is appended to every key
+  [[nodiscard]] static std::string fingerprint();
+
+ private:
+  Options options_;
+
+  [[nodiscard]] std::optional<std::vector<std::string>> read(
+      const std::string& full_key) const;
+};
+
+/// @return the default derivation cache, initialized via
+/// DerivationCache::from_environment() on first use; may be null
+std::shared_ptr<const DerivationCache> default_derivation_cache();
+
+/// @brief sets the default derivation cache
+/// @param cache the new default cache; null disables caching
+void set_default_derivation_cache(
+    std::shared_ptr<const DerivationCache> cache);
+
+}  // namespace sequant::mbpt
+
+#endif  // SEQUANT_DOMAIN_MBPT_DERIVATION_CACHE_HPP
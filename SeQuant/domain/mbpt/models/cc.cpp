@@ -10,11 +10,16 @@
 #include <SeQuant/domain/mbpt/spin.hpp>
 #include <SeQuant/domain/mbpt/utils.hpp>
 
+#include <cstddef>
 #include <cstdint>
+#include <functional>
+#include <limits>
 #include <memory>
 #include <new>
 #include <stdexcept>
+#include <string>
 #include <utility>
+#include <vector>
 
 namespace {
 // alias reserved labels for readability
@@ -27,6 +32,49 @@ inline auto commutator(const sequant::ExprPtr& A, const sequant::ExprPtr& B) {
   sequant::non_canon_simplify(result);
   return result;
 }
+
+/// partitions the terms of operator sum @p expr among the projection
+/// manifolds @c p=pmax..pmin in a single pass; the quantum number change of
+/// each term is computed once, then @p up_to_rank(qnc,p) decides whether the
+/// term can contribute to manifolds of rank @c p or lower (if not, it is
+/// dropped from manifold @c p and all lower ranks) and @p to_rank(qnc,p)
+/// whether it contributes to manifold @c p
+/// @return vector of Sums indexed by @c p (null for manifolds that receive no
+/// terms); each manifold holds its own clones of the terms, hence the
+/// manifolds can be processed concurrently (see for_each_manifold)
+template <typename UpToRank, typename ToRank>
+std::vector<std::shared_ptr<sequant::Sum>> partition_by_rank(
+    const sequant::ExprPtr& expr, std::size_t pmax, std::size_t pmin,
+    const UpToRank& up_to_rank, const ToRank& to_rank) {
+  using namespace sequant;
+  std::vector<std::shared_ptr<Sum>> result(pmax + 1);
+  for (auto& term : *expr) {
+    SEQUANT_ASSERT(term->is<Product>() || term->is<mbpt::op_t>());
+    const auto qnc = mbpt::apply_to_vac(term);
+    for (auto p = static_cast<std::int64_t>(pmax);
+         p >= static_cast<std::int64_t>(pmin); --p) {
+      if (!up_to_rank(qnc, p)) break;
+      if (to_rank(qnc, p)) {
+        if (!result[p])
+          result[p] = std::make_shared<Sum>(ExprPtrList{term->clone()});
+        else
+          result[p]->append(term->clone());
+      }
+    }
+  }
+  return result;
+}
+
+/// computes @c f(p) for @c p=pmin..pmax concurrently, splitting the thread
+/// budget evenly between the manifolds
+template <typename F>
+void for_each_manifold(std::size_t pmax, std::size_t pmin, const F& f) {
+  std::vector<std::size_t> ranks;
+  for (auto p = static_cast<std::int64_t>(pmax);
+       p >= static_cast<std::int64_t>(pmin); --p)
+    ranks.push_back(p);
+  sequant::for_each(ranks, f);
+}
 }  // namespace
 
 namespace sequant::mbpt {
@@ -41,7 +89,8 @@ CC::CC(size_t n, const Options& opts)
       screen_(opts.screen),
       use_topology_(opts.use_topology),
       hbar_comm_rank_(opts.hbar_comm_rank),
-      pertbar_comm_rank_(opts.pertbar_comm_rank) {
+      pertbar_comm_rank_(opts.pertbar_comm_rank),
+      cache_(opts.cache) {
   if (unitary())
     SEQUANT_ASSERT(hbar_comm_rank_ &&
                    "CC: hbar_comm_rank is required for unitary ansatz");
@@ -80,7 +129,65 @@ ExprPtr CC::energy(std::optional<size_t> comm_rank) const {
                          : this->ref_av(this->hbar(comm_rank));
 }
 
+std::vector<ExprPtr> CC::cached(
+    const std::string& generator, const std::string& args,
+    const std::function<std::vector<ExprPtr>()>& derive) const {
+  const auto cache = cache_ ? cache_ : default_derivation_cache();
+  if (!cache) return derive();
+
+  auto opt_to_string = [](const std::optional<size_t>& v) {
+    return v ? std::to_string(*v) : std::string("-");
+  };
+  const auto key = "CC::" + generator + "(" + args + ");N=" +
+                   std::to_string(N) +
+                   ";ansatz=" + std::to_string(static_cast<int>(ansatz_)) +
+                   ";skip_singles=" + std::to_string(skip_singles_) +
+                   ";screen=" + std::to_string(screen_) +
+                   ";use_topology=" + std::to_string(use_topology_) +
+                   ";hbar_comm_rank=" + opt_to_string(hbar_comm_rank_) +
+                   ";pertbar_comm_rank=" + opt_to_string(pertbar_comm_rank_);
+  return cache->get_or_derive(key, derive);
+}
+
 std::vector<ExprPtr> CC::t(size_t pmax, size_t pmin) const {
+  pmax = (pmax == std::numeric_limits<size_t>::max() ? N : pmax);
+  return cached("t", std::to_string(pmax) + "," + std::to_string(pmin),
+                [&] { return derive_t(pmax, pmin); });
+}
+
+std::vector<ExprPtr> CC::λ() const {
+  return cached("λ", "", [&] { return derive_λ(); });
+}
+
+std::vector<ExprPtr> CC::tʼ(size_t rank, size_t order,
+                            std::optional<size_t> nbatch) const {
+  return cached("tʼ",
+                std::to_string(rank) + "," + std::to_string(order) + "," +
+                    (nbatch ? std::to_string(*nbatch) : std::string("-")),
+                [&] { return derive_tʼ(rank, order, nbatch); });
+}
+
+std::vector<ExprPtr> CC::λʼ(size_t rank, size_t order,
+                            std::optional<size_t> nbatch) const {
+  return cached("λʼ",
+                std::to_string(rank) + "," + std::to_string(order) + "," +
+                    (nbatch ? std::to_string(*nbatch) : std::string("-")),
+                [&] { return derive_λʼ(rank, order, nbatch); });
+}
+
+std::vector<ExprPtr> CC::eom_r(nₚ np, nₕ nh) const {
+  return cached("eom_r",
+                std::to_string(np.value()) + "," + std::to_string(nh.value()),
+                [&] { return derive_eom_r(np, nh); });
+}
+
+std::vector<ExprPtr> CC::eom_l(nₚ np, nₕ nh) const {
+  return cached("eom_l",
+                std::to_string(np.value()) + "," + std::to_string(nh.value()),
+                [&] { return derive_eom_l(np, nh); });
+}
+
+std::vector<ExprPtr> CC::derive_t(size_t pmax, size_t pmin) const {
   pmax = (pmax == std::numeric_limits<size_t>::max() ? N : pmax);
   SEQUANT_ASSERT(pmax >= pmin && "pmax should be >= pmin");
 
@@ -92,47 +199,43 @@ std::vector<ExprPtr> CC::t(size_t pmax, size_t pmin) const {
                                 ? mbpt::OpConnections<std::wstring>{}
                                 : default_op_connections();
 
-  // 2. project onto each manifold, screen, lower to tensor form and wick it
-  std::vector<ExprPtr> result(pmax + 1);
-  for (std::int64_t p = pmax; p >= static_cast<std::int64_t>(pmin); --p) {
-    // 2.a. screen out terms that cannot give nonzero after projection onto
-    // <p|
-    std::shared_ptr<Sum>
-        hbar_for_vev;  // keeps products that can produce non-zero VEV
-    std::shared_ptr<Sum>
-        hbar_le_p;  // keeps products that can produce excitations rank <=p
-
-    if (screen_) {  // if operator level screening is on
-      for (auto& term : *hbar) {
-        SEQUANT_ASSERT(term->is<Product>() || term->is<op_t>());
-        if (raises_vacuum_up_to_rank(term, p)) {
-          if (!hbar_le_p)
-            hbar_le_p = std::make_shared<Sum>(ExprPtrList{term});
-          else
-            hbar_le_p->append(term);
-          if (raises_vacuum_to_rank(term, p)) {
-            if (!hbar_for_vev)
-              hbar_for_vev = std::make_shared<Sum>(ExprPtrList{term});
-            else
-              hbar_for_vev->append(term);
-          }
-        }
-      }
-      hbar = hbar_le_p;
-    } else {  // no screening, use full hbar
-      hbar_for_vev = hbar.is<Sum>() ? hbar.as_shared_ptr<Sum>()
-                                    : std::make_shared<Sum>(hbar);
-    }
-
-    // 2.b project onto <p| (i.e., multiply by P(p) if p>0) and compute VEV
-    result.at(p) = this->ref_av(p != 0 ? P(nₚ(p)) * hbar_for_vev : hbar_for_vev,
-                                connectivity);
+  // 2. screen out terms that cannot give nonzero after projection onto <p|,
+  // partitioning hbar by projection manifold in a single pass
+  std::vector<std::shared_ptr<Sum>> hbar_for_vev;
+  if (screen_) {  // if operator level screening is on
+    hbar_for_vev = partition_by_rank(
+        hbar, pmax, pmin,
+        [](const qns_t& qnc, std::size_t p) {
+          // can produce excitations rank <=p
+          return combine(qnc, qns_t{}).overlaps_with(
+              interval_excitation_type_qns(p));
+        },
+        [](const qns_t& qnc, std::size_t p) {
+          // can produce non-zero VEV
+          return combine(qnc, qns_t{}).overlaps_with(excitation_type_qns(p));
+        });
+  } else {  // no screening, use full hbar
+    hbar_for_vev.resize(pmax + 1);
+    for (auto p = pmin; p <= pmax; ++p)
+      hbar_for_vev[p] = hbar.is<Sum>()
+                            ? std::make_shared<Sum>(hbar->clone().as<Sum>())
+                            : std::make_shared<Sum>(ExprPtrList{hbar});
   }
 
+  // 3. project onto each manifold (i.e., multiply by P(p) if p>0) and compute
+  // VEV, manifolds are independent hence processed concurrently
+  std::vector<ExprPtr> result(pmax + 1);
+  for_each_manifold(pmax, pmin, [&](std::size_t p) {
+    const auto& hbar_p = hbar_for_vev[p];
+    result.at(p) =
+        hbar_p ? this->ref_av(p != 0 ? P(nₚ(p)) * hbar_p : hbar_p, connectivity)
+               : ex<Constant>(0);
+  });
+
   return result;
 }
 
-std::vector<ExprPtr> CC::λ() const {
+std::vector<ExprPtr> CC::derive_λ() const {
   SEQUANT_ASSERT(!unitary() && "there is no need for CC::λ for unitary ansatz");
 
   // construct hbar
@@ -160,46 +263,41 @@ std::vector<ExprPtr> CC::λ() const {
         hbar_λ, {{L"h", L"λ⁺"}, {L"f", L"λ⁺"}, {L"f̃", L"λ⁺"}, {L"g", L"λ⁺"}});
   }
 
-  // 2. project onto each manifold, screen, lower to tensor form and wick it
-  for (auto p = N; p >= 1; --p) {
-    // 2.a. screen out terms that cannot give nonzero after projection onto
-    // <P|
-    std::shared_ptr<Sum>
-        lhbar_for_vev;  // keeps products that can produce non-zero VEV
-    std::shared_ptr<Sum>
-        lhbar_le_p;  // keeps products that can produce excitations rank <=p
-    if (screen_) {   // if operator level screening is enabled
-      for (auto& term : *lhbar) {  // pick terms from lhbar
-        SEQUANT_ASSERT(term->is<Product>() || term->is<op_t>());
-
-        if (lowers_rank_or_lower_to_vacuum(term, p)) {
-          if (!lhbar_le_p)
-            lhbar_le_p = std::make_shared<Sum>(ExprPtrList{term});
-          else
-            lhbar_le_p->append(term);
-          if (lowers_rank_to_vacuum(term, p)) {
-            if (!lhbar_for_vev)
-              lhbar_for_vev = std::make_shared<Sum>(ExprPtrList{term});
-            else
-              lhbar_for_vev->append(term);
-          }
-        }
-      }
-      lhbar = lhbar_le_p;
-    } else {  // no screening
-      lhbar_for_vev = lhbar.is<Sum>() ? lhbar.as_shared_ptr<Sum>()
-                                      : std::make_shared<Sum>(lhbar);
-    }
-
-    // 2.b multiply by adjoint of P(p) (i.e., P(-p)) on the right side and
-    // compute VEV
-    result.at(p) = this->ref_av(lhbar_for_vev * P(nₚ(-p)), op_connect);
+  // 2. screen out terms that cannot give nonzero after projection onto <P|,
+  // partitioning lhbar by projection manifold in a single pass
+  std::vector<std::shared_ptr<Sum>> lhbar_for_vev;
+  if (screen_) {  // if operator level screening is enabled
+    lhbar_for_vev = partition_by_rank(
+        lhbar, N, 1,
+        [](const qns_t& qnc, std::size_t p) {
+          // can lower rank <=p to vacuum
+          return combine(qnc, interval_excitation_type_qns(p))
+              .overlaps_with(qns_t{});
+        },
+        [](const qns_t& qnc, std::size_t p) {
+          // can produce non-zero VEV
+          return combine(qnc, excitation_type_qns(p)).overlaps_with(qns_t{});
+        });
+  } else {  // no screening
+    lhbar_for_vev.resize(N + 1);
+    for (std::size_t p = 1; p <= N; ++p)
+      lhbar_for_vev[p] = lhbar.is<Sum>()
+                             ? std::make_shared<Sum>(lhbar->clone().as<Sum>())
+                             : std::make_shared<Sum>(ExprPtrList{lhbar});
   }
+
+  // 3. multiply by adjoint of P(p) (i.e., P(-p)) on the right side and
+  // compute VEV, manifolds are independent hence processed concurrently
+  for_each_manifold(N, 1, [&](std::size_t p) {
+    const auto& lhbar_p = lhbar_for_vev[p];
+    result.at(p) = lhbar_p ? this->ref_av(lhbar_p * P(nₚ(-p)), op_connect)
+                           : ex<Constant>(0);
+  });
   return result;
 }
 
-std::vector<ExprPtr> CC::tʼ(size_t rank, size_t order,
-                            std::optional<size_t> nbatch) const {
+std::vector<ExprPtr> CC::derive_tʼ(size_t rank, size_t order,
+                                   std::optional<size_t> nbatch) const {
   SEQUANT_ASSERT(order == 1 &&
                  "sequant::mbpt::CC::tʼ(): only first-order perturbation is "
                  "supported now");
@@ -262,8 +360,8 @@ std::vector<ExprPtr> CC::tʼ(size_t rank, size_t order,
   return result;
 }
 
-std::vector<ExprPtr> CC::λʼ(size_t rank, size_t order,
-                            std::optional<size_t> nbatch) const {
+std::vector<ExprPtr> CC::derive_λʼ(size_t rank, size_t order,
+                                   std::optional<size_t> nbatch) const {
   SEQUANT_ASSERT(order == 1 &&
                  "sequant::mbpt::CC::λʼ(): only first-order perturbation is "
                  "supported now");
@@ -322,7 +420,7 @@ std::vector<ExprPtr> CC::λʼ(size_t rank, size_t order,
   return result;
 }
 
-std::vector<ExprPtr> CC::eom_r(nₚ np, nₕ nh) const {
+std::vector<ExprPtr> CC::derive_eom_r(nₚ np, nₕ nh) const {
   SEQUANT_ASSERT((np > 0 || nh > 0) && "Unsupported excitation order");
   if (np != nh)
     SEQUANT_ASSERT(
@@ -372,7 +470,7 @@ std::vector<ExprPtr> CC::eom_r(nₚ np, nₕ nh) const {
   return result;
 }
 
-std::vector<ExprPtr> CC::eom_l(nₚ np, nₕ nh) const {
+std::vector<ExprPtr> CC::derive_eom_l(nₚ np, nₕ nh) const {
   SEQUANT_ASSERT(!unitary() &&
                  "there is no need for CC::eom_l for unitary ansatz");
   SEQUANT_ASSERT((np > 0 || nh > 0) && "Unsupported excitation order");
@@ -2,12 +2,16 @@
 #define SEQUANT_DOMAIN_MBPT_MODELS_CC_HPP
 
 #include <SeQuant/core/op.hpp>
+#include <SeQuant/domain/mbpt/derivation_cache.hpp>
 #include <SeQuant/domain/mbpt/op.hpp>
 #include <SeQuant/domain/mbpt/vac_av.hpp>
 
 #include <cstddef>
+#include <functional>
 #include <limits>
+#include <memory>
 #include <optional>
+#include <string>
 #include <vector>
 
 namespace sequant {
@@ -17,6 +21,8 @@ class ExprPtr;
 namespace sequant::mbpt {
 
 /// CC is a derivation engine for the coupled-cluster method
+/// @note the amplitude and EOM equations are looked up in (and stored to) the
+/// derivation cache, see DerivationCache
 class CC {
  public:
   enum class Ansatz {
@@ -51,6 +57,9 @@ class CC {
     /// perturbation operator; must be specified if unitary ansatz is used in
     /// perturbed amplitude derivation
     std::optional<size_t> pertbar_comm_rank = std::nullopt;
+    /// cache of derived equations used by t(), λ(), tʼ(), λʼ(), eom_r(), and
+    /// eom_l(); if null, default_derivation_cache() is used
+    std::shared_ptr<const DerivationCache> cache = nullptr;
   };
 
   /// @brief constructs CC engine with default options (traditional ansatz,
@@ -114,6 +123,7 @@ class CC {
   /// equation
   ///   \f$ \langle k |\bar{H}|0 \rangle = 0 \f$ for `k` in the [\p pmin,\p
   ///   pmax] range, and null value otherwise
+  /// @note the projection manifolds are derived concurrently
   [[nodiscard]] std::vector<ExprPtr> t(
       size_t pmax = std::numeric_limits<size_t>::max(), size_t pmin = 0) const;
 
@@ -126,6 +136,7 @@ class CC {
   ///   \rangle = 0 \f$ for `k` in
   /// the [1,N] range; element 0 contains the λ pseudoenergy, computed as the
   /// CC energy with \f$ \hat{T} \f$ replaced by \f$ \hat{\Lambda}^{\dagger} \f$
+  /// @note the projection manifolds are derived concurrently
   [[nodiscard]] std::vector<ExprPtr> λ() const;
 
   // clang-format off
@@ -172,6 +183,26 @@ class CC {
   bool use_topology_ = true;
   std::optional<size_t> hbar_comm_rank_ = std::nullopt;
   std::optional<size_t> pertbar_comm_rank_ = std::nullopt;
+  std::shared_ptr<const DerivationCache> cache_ = nullptr;
+
+  /// @brief looks up the result of a derivation in the derivation cache
+  /// @param[in] generator name of the generator, e.g. `"t"`
+  /// @param[in] args textual description of the generator arguments
+  /// @param[in] derive callable that performs the derivation on a cache miss
+  /// @return the result of the derivation
+  /// @note the cache key includes the rank and the options of this engine
+  std::vector<ExprPtr> cached(
+      const std::string& generator, const std::string& args,
+      const std::function<std::vector<ExprPtr>()>& derive) const;
+
+  std::vector<ExprPtr> derive_t(size_t pmax, size_t pmin) const;
+  std::vector<ExprPtr> derive_λ() const;
+  std::vector<ExprPtr> derive_tʼ(size_t rank, size_t order,
+                                 std::optional<size_t> nbatch) const;
+  std::vector<ExprPtr> derive_λʼ(size_t rank, size_t order,
+                                 std::optional<size_t> nbatch) const;
+  std::vector<ExprPtr> derive_eom_r(nₚ np, nₕ nh) const;
+  std::vector<ExprPtr> derive_eom_l(nₚ np, nₕ nh) const;
 
   /// @brief computes reference expectation value of an expression. Dispatches
   /// to `mbpt::op::ref_av()`
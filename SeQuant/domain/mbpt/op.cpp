@@ -1309,7 +1309,9 @@ ExprPtr expectation_value_impl(ExprPtr expr, OpConnections<int> connect,
     std::wcout << "WickTheorem stats: # of contractions attempted = "
                << wick.stats().num_attempted_contractions
                << " # of useful contractions = "
-               << wick.stats().num_useful_contractions << std::endl;
+               << wick.stats().num_useful_contractions
+               << " # of pruned contractions = "
+               << wick.stats().num_pruned_contractions << std::endl;
   }
   // only need to handle the special case where the dense(at least partially
   // occupied) states, contain additional functions to the vacuum_occupied.
@@ -1493,7 +1495,9 @@ ExprPtr expectation_value_impl(ExprPtr expr, OpConnections<int> connect,
       std::wcout << "WickTheorem stats: # of contractions attempted = "
                  << wick.stats().num_attempted_contractions
                  << " # of useful contractions = "
-                 << wick.stats().num_useful_contractions << std::endl;
+                 << wick.stats().num_useful_contractions
+                 << " # of pruned contractions = "
+                 << wick.stats().num_pruned_contractions << std::endl;
     }
     restore_scalars(result);
     return result;
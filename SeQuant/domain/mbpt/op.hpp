@@ -540,6 +540,11 @@ struct EVOptions {
   /// If true, will not clone the input expression. Only valid in Operator level
   /// calls
   bool skip_clone = false;
+  /// If true, expectation values of operator products are memoized
+  /// process-wide and reused for recurring products (up to index labels).
+  /// Only valid in Operator level calls.
+  /// @sa clear_vac_av_memo(), set_vac_av_memo_capacity()
+  bool memoize = false;
 };
 namespace tensor {
 /// @brief computes the reference expectation value of a tensor-level expression
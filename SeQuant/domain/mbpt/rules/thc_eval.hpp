@@ -0,0 +1,65 @@
+#ifndef SEQUANT_DOMAIN_MBPT_RULES_THC_EVAL_HPP
+#define SEQUANT_DOMAIN_MBPT_RULES_THC_EVAL_HPP
+
+#include <SeQuant/domain/mbpt/space_qns.hpp>
+
+#include <SeQuant/core/eval/eval.hpp>
+#include <SeQuant/core/index.hpp>
+#include <SeQuant/core/space.hpp>
+
+#include <cstddef>
+#include <optional>
+#include <utility>
+
+namespace sequant::mbpt {
+
+/// Index predicate selecting the grid indices introduced by
+/// tensor_hypercontract(). By default these are the indices of any space
+/// carrying TensorFactorizationQNS::thc (see add_thc_spaces()); if
+/// \c grid_space is set, exactly the indices of that space.
+struct thc_grid_index {
+  std::optional<IndexSpace> grid_space = std::nullopt;
+
+  [[nodiscard]] bool operator()(Index const& ix) const {
+    if (grid_space) return ix.space() == *grid_space;
+    return bitset_t(ix.space().qns()) &
+           bitset_t(TensorFactorizationQNS::thc);
+  }
+};
+
+///
+/// \brief Builds a custom evaluator (see CacheManager::custom_evaluator_type)
+///        that streams the THC grid dimension through every subtree
+///        contracting a grid index.
+///
+/// The THC factorization replaces an integral by a network whose grid extent
+/// is typically several times the number of orbitals; evaluated as is, the
+/// intermediates carrying a grid index are the largest ones of the tree. This
+/// is make_batched_custom_evaluator restricted to grid indices
+/// (thc_grid_index), with the batch size chosen per intercepted subtree so
+/// that its largest grid-carrying intermediate stays within
+/// \p memory_budget_bytes (memory_budget_batch_size). The outermost node
+/// contracting a grid index is intercepted, so the whole subtree below it is
+/// evaluated one grid batch at a time.
+///
+/// \param le the leaf evaluator (captured).
+/// \param memory_budget_bytes the memory budget of the largest batched
+///        intermediate, in bytes.
+/// \param grid selects the grid indices; defaults to the THC spaces.
+/// \param make_scope_guard see make_batched_custom_evaluator.
+/// \param is_volatile see make_batched_custom_evaluator.
+///
+template <typename F, typename ScopeGuardFactory = make_no_scope_guard,
+          typename IsVolatile = never_volatile>
+[[nodiscard]] auto make_thc_custom_evaluator(
+    F le, std::size_t memory_budget_bytes, thc_grid_index grid = {},
+    ScopeGuardFactory make_scope_guard = {}, IsVolatile is_volatile = {}) {
+  return make_batched_custom_evaluator(
+      std::move(le),
+      memory_budget_batch_size{.budget_bytes = memory_budget_bytes},
+      std::move(grid), std::move(make_scope_guard), std::move(is_volatile));
+}
+
+}  // namespace sequant::mbpt
+
+#endif  // SEQUANT_DOMAIN_MBPT_RULES_THC_EVAL_HPP
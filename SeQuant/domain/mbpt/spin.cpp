@@ -41,6 +41,7 @@
 #include <cstdint>
 #include <cstdlib>
 #include <functional>
+#include <future>
 #include <iterator>
 #include <memory>
 #include <numeric>
@@ -929,7 +930,7 @@ ExprPtr S_maps(const ExprPtr& expr) {
 template <detail::index_group_range IdxGroups>
 ExprPtr closed_shell_spintrace_impl(const ExprPtr& expression,
                                     IdxGroups&& ext_index_groups,
-                                    bool full_expansion) {
+                                    bool full_expansion, SpintraceMode mode) {
   // Symmetrize and expression
   // Partially expand the antisymmetrizer and write it in terms of S operator.
   // See symmetrize_expr(expr) function for implementation details. We want an
@@ -951,12 +952,15 @@ ExprPtr closed_shell_spintrace_impl(const ExprPtr& expression,
     rapid_simplify(temp);
     return temp;
   };
-  ExprPtr expr = partially_or_fully_expand(expression);
+  auto expand_and_simplify = [&partially_or_fully_expand](const ExprPtr& expr) {
+    ExprPtr result = partially_or_fully_expand(expr);
 
-  // Index tags are cleaned prior to calling the fast canonicalizer
-  detail::reset_idx_tags(expr);  // This call is REQUIRED
-  expand(expr);                  // This call is REQUIRED
-  simplify(expr);  // full simplify to combine terms before count_cycles
+    // Index tags are cleaned prior to calling the fast canonicalizer
+    detail::reset_idx_tags(result);  // This call is REQUIRED
+    expand(result);                  // This call is REQUIRED
+    simplify(result);  // full simplify to combine terms before count_cycles
+    return result;
+  };
 
   // Lambda for spin-tracing a product term
   // For closed-shell case, a spin-traced result is a product term scaled by
@@ -1038,66 +1042,85 @@ ExprPtr closed_shell_spintrace_impl(const ExprPtr& expression,
     return result;
   };
 
-  if (expr->is<Constant>() || expr->is<Variable>())
-    return expr;
-  else if (expr->is<Tensor>())
-    return trace_product(
-        (ex<Constant>(1) * expr)->as<Product>());  // expand_all(expr);
-  else if (expr->is<Product>())
-    return trace_product(expr->as<Product>());
-  else if (expr->is<Sum>()) {
-    auto result = std::make_shared<Sum>();
-    for (auto&& summand : *expr) {
-      if (summand->is<Product>()) {
-        result->append(trace_product(summand->as<Product>()));
-      } else if (summand->is<Tensor>()) {
-        result->append(
-            trace_product((ex<Constant>(1) * summand)->as<Product>()));
-      } else {
-        SEQUANT_ASSERT(summand->is<Constant>() || summand->is<Variable>());
-        result->append(summand);
+  auto trace = [&trace_product](const ExprPtr& expr) -> ExprPtr {
+    if (expr->is<Constant>() || expr->is<Variable>())
+      return expr;
+    else if (expr->is<Tensor>())
+      return trace_product(
+          (ex<Constant>(1) * expr)->as<Product>());  // expand_all(expr);
+    else if (expr->is<Product>())
+      return trace_product(expr->as<Product>());
+    else if (expr->is<Sum>()) {
+      auto result = std::make_shared<Sum>();
+      for (auto&& summand : *expr) {
+        if (summand->is<Product>()) {
+          result->append(trace_product(summand->as<Product>()));
+        } else if (summand->is<Tensor>()) {
+          result->append(
+              trace_product((ex<Constant>(1) * summand)->as<Product>()));
+        } else {
+          SEQUANT_ASSERT(summand->is<Constant>() || summand->is<Variable>());
+          result->append(summand);
+        }
       }
+      return result;
+    } else {
+      throw Exception("Invalid Expr type in closed_shell_spintrace: " +
+                      expr->type_name());
     }
-    return result;
-  } else {
-    throw Exception("Invalid Expr type in closed_shell_spintrace: " +
-                    expr->type_name());
+  };
+
+  // streaming mode: each input term is expanded and traced independently,
+  // the (canonicalized) traced terms are folded into the result as soon as
+  // they are produced
+  if (mode == SpintraceMode::Streaming && expression->is<Sum>()) {
+    return transform_sum_expr(
+        expression->as<Sum>().summands(),
+        [&expand_and_simplify, &trace](const ExprPtr& term) {
+          // N.B. clone since expansion may modify the input in place
+          return trace(expand_and_simplify(term->clone()));
+        });
   }
+
+  return trace(expand_and_simplify(expression));
 }
 
 ExprPtr closed_shell_spintrace(
     const ExprPtr& expression,
     const container::svector<container::svector<SlottedIndex>>&
         ext_index_groups,
-    bool full_expansion) {
+    bool full_expansion, SpintraceMode mode) {
   return closed_shell_spintrace_impl(
-      expression, as_view_of_index_groups(ext_index_groups), full_expansion);
+      expression, as_view_of_index_groups(ext_index_groups), full_expansion,
+      mode);
 }
 
 ExprPtr closed_shell_spintrace(const ExprPtr& expression, EmptyInitializerList,
-                               bool full_expansion) {
+                               bool full_expansion, SpintraceMode mode) {
   return closed_shell_spintrace_impl(
       expression, container::svector<container::svector<Index>>{},
-      full_expansion);
+      full_expansion, mode);
 }
 
 ExprPtr closed_shell_spintrace(
     const ExprPtr& expression,
     const container::svector<container::svector<Index>>& ext_index_groups,
-    bool full_expansion) {
+    bool full_expansion, SpintraceMode mode) {
   return closed_shell_spintrace_impl(expression, ext_index_groups,
-                                     full_expansion);
+                                     full_expansion, mode);
 }
 
 container::svector<ResultExpr> closed_shell_spintrace(const ResultExpr& expr,
-                                                      bool full_expansion) {
+                                                      bool full_expansion,
+                                                      SpintraceMode mode) {
   using TraceFunction = ExprPtr (*)(
       const ExprPtr&,
-      const container::svector<container::svector<SlottedIndex>>&, bool);
+      const container::svector<container::svector<SlottedIndex>>&, bool,
+      SpintraceMode);
 
   return detail::wrap_trace<container::svector<ResultExpr>>(
       expr, static_cast<TraceFunction>(&closed_shell_spintrace),
-      full_expansion);
+      full_expansion, mode);
 }
 
 ExprPtr closed_shell_CC_spintrace_v1(ExprPtr const& expr,
@@ -1108,7 +1131,9 @@ ExprPtr closed_shell_CC_spintrace_v1(ExprPtr const& expr,
   auto const ext_idxs = external_indices(expr);
   auto st_expr = options.naive_spintrace
                      ? spintrace(expr, ext_idxs)
-                     : closed_shell_spintrace(expr, ext_idxs);
+                     : closed_shell_spintrace(expr, ext_idxs,
+                                              /* full_expansion = */ false,
+                                              options.mode);
   canonicalize(st_expr);
 
   if (!ext_idxs.empty()) {
@@ -1127,7 +1152,9 @@ ExprPtr closed_shell_CC_spintrace_v2(ExprPtr const& expr,
   auto const ext_idxs = external_indices(expr);
   auto st_expr = options.naive_spintrace
                      ? spintrace(expr, ext_idxs)
-                     : closed_shell_spintrace(expr, ext_idxs);
+                     : closed_shell_spintrace(expr, ext_idxs,
+                                              /* full_expansion = */ false,
+                                              options.mode);
   canonicalize(st_expr);
 
   if (!ext_idxs.empty()) {
@@ -1366,12 +1393,30 @@ std::vector<ExprPtr> open_shell_P_op_vector(const Tensor& A) {
   return result_vector;
 }
 
-template <detail::index_group_range IdxGroups>
-std::vector<ExprPtr> open_shell_spintrace_impl(
+namespace detail {
+
+/// data shared by all spin blocks of open_shell_spintrace
+struct OpenShellSpintraceState {
+  /// if non-null, the input was a Constant or a Variable and is the only block
+  ExprPtr trivial;
+  /// input with fully expanded antisymmetrizer
+  ExprPtr expanded_expr;
+  /// replacement maps for the external indices, one per spin block
+  container::svector<container::map<Index, Index>> ext_replacements;
+  /// replacement maps for the internal indices, one per internal spin case
+  container::svector<container::map<Index, Index>> int_replacements;
+};
+
+namespace {
+
+template <index_group_range IdxGroups>
+std::shared_ptr<const OpenShellSpintraceState> make_open_shell_spintrace_state(
     const ExprPtr& expr, IdxGroups&& ext_index_groups,
     const std::optional<int>& target_spin_case) {
+  auto state = std::make_shared<OpenShellSpintraceState>();
   if (expr->is<Constant>() || expr->is<Variable>()) {
-    return std::vector<ExprPtr>{expr};
+    state->trivial = expr;
+    return state;
   }
 
   // Grand index list contains both internal and external indices
@@ -1452,103 +1497,174 @@ std::vector<ExprPtr> open_shell_spintrace_impl(
   };
 
   // Internal and external index replacements are independent
-  auto i_rep = spin_cases(int_index_groups);
-  auto e_rep = ext_spin_cases(ext_index_groups);
+  state->int_replacements = spin_cases(int_index_groups);
+  state->ext_replacements = ext_spin_cases(ext_index_groups);
 
   // For a single spin case, keep only the relevant spin case
   // PS: all alpha indexing start at 0
   if (target_spin_case) {
-    auto external_replacement_map = e_rep.at(*target_spin_case);
-    e_rep.clear();
-    e_rep.push_back(external_replacement_map);
+    auto external_replacement_map =
+        state->ext_replacements.at(*target_spin_case);
+    state->ext_replacements.clear();
+    state->ext_replacements.push_back(external_replacement_map);
   }
 
   // Expand 'A' operator and 'antisymm' tensors
-  auto expanded_expr = expand_A_op(expr);
-  detail::reset_idx_tags(expanded_expr);
-  expand(expanded_expr);
-  simplify(expanded_expr);
+  state->expanded_expr = expand_A_op(expr);
+  reset_idx_tags(state->expanded_expr);
+  expand(state->expanded_expr);
+  simplify(state->expanded_expr);
 
-  std::vector<ExprPtr> result{};
+  return state;
+}
 
-  // return true if a product is spin-symmetric
-  auto spin_symm_product = [](const Product& product) {
-    container::svector<Index> cBra, cKet;  // concat Bra and concat Ket
-    for (auto& term : product) {
-      if (term->is<Tensor>()) {
-        auto tnsr = term->as<Tensor>();
-        cBra.insert(cBra.end(), tnsr.bra().begin(), tnsr.bra().end());
-        cKet.insert(cKet.end(), tnsr.ket().begin(), tnsr.ket().end());
-      } else if (term->is<Product>() || term->is<Sum>()) {
-        throw Exception(
-            "Nested Product and Sum not supported in spin_symm_product");
-      }
+// return true if a product is spin-symmetric
+bool spin_symm_product(const Product& product) {
+  container::svector<Index> cBra, cKet;  // concat Bra and concat Ket
+  for (auto& term : product) {
+    if (term->is<Tensor>()) {
+      auto tnsr = term->as<Tensor>();
+      cBra.insert(cBra.end(), tnsr.bra().begin(), tnsr.bra().end());
+      cKet.insert(cKet.end(), tnsr.ket().begin(), tnsr.ket().end());
+    } else if (term->is<Product>() || term->is<Sum>()) {
+      throw Exception(
+          "Nested Product and Sum not supported in spin_symm_product");
     }
-    SEQUANT_ASSERT(cKet.size() == cBra.size());
+  }
+  SEQUANT_ASSERT(cKet.size() == cBra.size());
+
+  auto i_ket = cKet.begin();
+  for (auto& b : cBra) {
+    if (b.space().qns() != i_ket->space().qns()) return false;
+    ++i_ket;
+  }
+  return true;
+}
 
-    auto i_ket = cKet.begin();
-    for (auto& b : cBra) {
-      if (b.space().qns() != i_ket->space().qns()) return false;
-      ++i_ket;
+/// @return the external spin block @p spin_expr with spin labels appended to
+/// the internal indices according to @p int_replacement , with
+/// non-spin-conserving terms dropped; null if nothing survives
+ExprPtr trace_internal_spin_case(
+    const ExprPtr& spin_expr,
+    const container::map<Index, Index>& int_replacement) {
+  // Add spin labels to internal indices, expand antisymmetric tensors
+  ExprPtr spin_expr_i = append_spin(spin_expr, int_replacement);
+  spin_expr_i = expand_antisymm(spin_expr_i, true);
+  expand(spin_expr_i);
+  reset_idx_tags(spin_expr_i);
+
+  if (spin_expr_i->is<Tensor>() || spin_expr_i->is<Constant>() ||
+      spin_expr_i->is<Variable>()) {
+    return spin_expr_i;
+  } else if (spin_expr_i->is<Product>()) {
+    if (spin_symm_product(spin_expr_i->as<Product>())) return spin_expr_i;
+  } else if (spin_expr_i->is<Sum>()) {
+    Sum i_result{};
+    for (auto& pr : *spin_expr_i) {
+      if (pr->is<Product>()) {
+        if (spin_symm_product(pr->as<Product>())) i_result.append(pr);
+      } else if (pr->is<Tensor>()) {
+        if (ms_conserving_columns(pr->as<Tensor>())) i_result.append(pr);
+      } else if (pr->is<Constant>() || pr->is<Variable>()) {
+        i_result.append(pr);
+      } else
+        throw("Unknown ExprPtr type.");
     }
-    return true;
-  };
+    return std::make_shared<Sum>(i_result);
+  }
+  return {};
+}
+
+/// sums up the internal spin cases of a spin block, then canonicalizes and
+/// simplifies the result
+ExprPtr assemble_spin_block(const std::vector<ExprPtr>& internal_spin_cases) {
+  Sum e_result{};
+  for (auto& i_result : internal_spin_cases) {
+    if (i_result) e_result.append(i_result);
+  }
+  ExprPtr result = std::make_shared<Sum>(e_result);
+  reset_idx_tags(result);
+  canonicalize(result);
+  rapid_simplify(result);
+  return result;
+}
+
+/// @return spin block @p e of the open-shell spintrace described by @p state
+/// @note internal spin cases are traced concurrently
+ExprPtr open_shell_spin_block(const OpenShellSpintraceState& state,
+                              std::size_t e) {
+  if (state.trivial) return state.trivial;
+
+  // Add spin labels to external indices
+  auto spin_expr = append_spin(state.expanded_expr, state.ext_replacements[e]);
+  reset_idx_tags(spin_expr);
+
+  std::vector<ExprPtr> i_results(state.int_replacements.size());
+  std::vector<std::size_t> i_cases(i_results.size());
+  std::iota(i_cases.begin(), i_cases.end(), 0);
+  sequant::for_each(i_cases, [&](std::size_t i) {
+    i_results[i] =
+        trace_internal_spin_case(spin_expr, state.int_replacements[i]);
+  });
+
+  return assemble_spin_block(i_results);
+}
+
+}  // namespace
+
+}  // namespace detail
+
+template <detail::index_group_range IdxGroups>
+std::vector<ExprPtr> open_shell_spintrace_impl(
+    const ExprPtr& expr, IdxGroups&& ext_index_groups,
+    const std::optional<int>& target_spin_case) {
+  if (expr->is<Constant>() || expr->is<Variable>()) {
+    return std::vector<ExprPtr>{expr};
+  }
+
+  const auto state = detail::make_open_shell_spintrace_state(
+      expr, std::forward<IdxGroups>(ext_index_groups), target_spin_case);
+  const auto& e_rep = state->ext_replacements;
+  const auto& i_rep = state->int_replacements;
 
   //
   // SPIN-TRACING algorithm begins here
   //
 
-  // Loop over external index replacement maps
+  // Add spin labels to external indices
+  std::vector<ExprPtr> spin_exprs;
+  spin_exprs.reserve(e_rep.size());
   for (auto& e : e_rep) {
-    // Add spin labels to external indices
-    auto spin_expr = append_spin(expanded_expr, e);
-    detail::reset_idx_tags(spin_expr);
-    Sum e_result{};
-
-    // Loop over internal index replacement maps
-    for (auto& i : i_rep) {
-      // Add spin labels to internal indices, expand antisymmetric tensors
-      ExprPtr spin_expr_i = append_spin(spin_expr, i);
-      spin_expr_i = expand_antisymm(spin_expr_i, true);
-      expand(spin_expr_i);
-      detail::reset_idx_tags(spin_expr_i);
-      Sum i_result{};
-
-      if (spin_expr_i->is<Tensor>() || spin_expr_i->is<Constant>() ||
-          spin_expr_i->is<Variable>()) {
-        e_result.append(spin_expr_i);
-      } else if (spin_expr_i->is<Product>()) {
-        if (spin_symm_product(spin_expr_i->as<Product>()))
-          e_result.append(spin_expr_i);
-      } else if (spin_expr_i->is<Sum>()) {
-        for (auto& pr : *spin_expr_i) {
-          if (pr->is<Product>()) {
-            if (spin_symm_product(pr->as<Product>())) i_result.append(pr);
-          } else if (pr->is<Tensor>()) {
-            if (ms_conserving_columns(pr->as<Tensor>())) i_result.append(pr);
-          } else if (pr->is<Constant>() || pr->is<Variable>()) {
-            i_result.append(pr);
-          } else
-            throw("Unknown ExprPtr type.");
-        }
-        e_result.append(std::make_shared<Sum>(i_result));
-      }
+    spin_exprs.push_back(append_spin(state->expanded_expr, e));
+    detail::reset_idx_tags(spin_exprs.back());
+  }
 
-    }  // loop over internal indices
-    result.push_back(std::make_shared<Sum>(e_result));
-  }  // loop over external indices
+  // all (external, internal) spin cases are independent, trace them
+  // concurrently
+  std::vector<std::vector<ExprPtr>> ei_results(
+      e_rep.size(), std::vector<ExprPtr>(i_rep.size()));
+  std::vector<std::size_t> ei_cases(e_rep.size() * i_rep.size());
+  std::iota(ei_cases.begin(), ei_cases.end(), 0);
+  sequant::for_each(ei_cases, [&](std::size_t ei) {
+    const auto e = ei / i_rep.size();
+    const auto i = ei % i_rep.size();
+    ei_results[e][i] =
+        detail::trace_internal_spin_case(spin_exprs[e], i_rep[i]);
+  });
+
+  // Canonicalize and simplify all spin blocks
+  std::vector<ExprPtr> result(e_rep.size());
+  std::vector<std::size_t> e_cases(e_rep.size());
+  std::iota(e_cases.begin(), e_cases.end(), 0);
+  sequant::for_each(e_cases, [&](std::size_t e) {
+    result[e] = detail::assemble_spin_block(ei_results[e]);
+  });
 
   if (target_spin_case) {
     SEQUANT_ASSERT(result.size() == 1 &&
                    "Spin-specific case must return one expression.");
   }
 
-  // Canonicalize and simplify all expressions
-  for (auto& expression : result) {
-    detail::reset_idx_tags(expression);
-    canonicalize(expression);
-    rapid_simplify(expression);
-  }
   return result;
 }
 
@@ -1575,6 +1691,53 @@ std::vector<ExprPtr> open_shell_spintrace(
   return open_shell_spintrace_impl(expr, ext_index_groups, target_spin_case);
 }
 
+OpenShellSpintraceGenerator::OpenShellSpintraceGenerator(
+    const ExprPtr& expr,
+    const container::svector<container::svector<SlottedIndex>>&
+        ext_index_groups,
+    const std::optional<int>& target_spin_case)
+    : state_(detail::make_open_shell_spintrace_state(
+          expr, as_view_of_index_groups(ext_index_groups), target_spin_case)) {}
+
+OpenShellSpintraceGenerator::OpenShellSpintraceGenerator(
+    const ExprPtr& expr, EmptyInitializerList,
+    const std::optional<int>& target_spin_case)
+    : state_(detail::make_open_shell_spintrace_state(
+          expr, container::svector<container::svector<Index>>{},
+          target_spin_case)) {}
+
+OpenShellSpintraceGenerator::OpenShellSpintraceGenerator(
+    const ExprPtr& expr,
+    const container::svector<container::svector<Index>>& ext_index_groups,
+    const std::optional<int>& target_spin_case)
+    : state_(detail::make_open_shell_spintrace_state(expr, ext_index_groups,
+                                                     target_spin_case)) {}
+
+OpenShellSpintraceGenerator::~OpenShellSpintraceGenerator() {
+  if (prefetched_.valid()) prefetched_.wait();
+}
+
+std::size_t OpenShellSpintraceGenerator::size() const {
+  return state_->trivial ? 1 : state_->ext_replacements.size();
+}
+
+std::optional<ExprPtr> OpenShellSpintraceGenerator::next() {
+  if (next_ == size()) return std::nullopt;
+
+  auto produce = [state = state_](std::size_t e) {
+    return detail::open_shell_spin_block(*state, e);
+  };
+
+  ExprPtr block = prefetched_.valid() ? prefetched_.get() : produce(next_);
+  ++next_;
+
+  // start producing the next block while the caller consumes this one
+  if (next_ != size())
+    prefetched_ = std::async(std::launch::async, produce, next_);
+
+  return block;
+}
+
 std::vector<ExprPtr> open_shell_CC_spintrace(const ExprPtr& expr) {
   SEQUANT_ASSERT(expr->is<Sum>() || expr->is<Product>());
   // Pop the antisymmetrizer A off a copy of the leading term to detect and
@@ -19,6 +19,10 @@
 
 #include <range/v3/algorithm/contains.hpp>
 
+#include <cstddef>
+#include <future>
+#include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -213,6 +217,16 @@ container::svector<container::map<Index, Index>> S_replacement_maps(
 /// @brief Expand S operator
 ExprPtr S_maps(const ExprPtr& expr);
 
+/// evaluation strategies of spin-tracing
+enum class SpintraceMode {
+  /// expand (and simplify) the entire expression, then trace the result
+  Batch,
+  /// trace each term of the input independently (and concurrently), fold the
+  /// canonicalized results into the result as they are produced; the fully
+  /// expanded intermediate is never materialized
+  Streaming
+};
+
 // clang-format off
 /// @brief Traces out spin degrees of freedom from fermionic operator moments
 /// @details This function is designed for integrating spin out of
@@ -226,6 +240,9 @@ ExprPtr S_maps(const ExprPtr& expr);
 /// antisymmetrizer, which makes spintracing expensive because of the large
 /// number of terms. If false, we expand it in terms of the symmetrizer,
 /// which results in a partial expansion.
+/// @param mode the evaluation strategy; SpintraceMode::Streaming greatly
+/// reduces the peak memory for large expressions and produces a canonicalized
+/// result
 /// @return the spin-free form of expr
 /// @warning the "antisymmetrizer" tensor A is assumed to be at the front of each tensor
 /// network, hence must use "complete" canonicalization to produce the input expression.
@@ -234,16 +251,18 @@ ExprPtr closed_shell_spintrace(
     const ExprPtr& expr,
     const container::svector<container::svector<SlottedIndex>>&
         ext_index_groups = {},
-    bool full_expansion = false);
+    bool full_expansion = false, SpintraceMode mode = SpintraceMode::Batch);
 ExprPtr closed_shell_spintrace(const ExprPtr& expr, EmptyInitializerList,
-                               bool full_expansion = false);
+                               bool full_expansion = false,
+                               SpintraceMode mode = SpintraceMode::Batch);
 ExprPtr closed_shell_spintrace(
     const ExprPtr& expr,
     const container::svector<container::svector<Index>>& ext_index_groups,
-    bool full_expansion = false);
+    bool full_expansion = false, SpintraceMode mode = SpintraceMode::Batch);
 
 container::svector<ResultExpr> closed_shell_spintrace(
-    const ResultExpr& expr, bool full_expansion = false);
+    const ResultExpr& expr, bool full_expansion = false,
+    SpintraceMode mode = SpintraceMode::Batch);
 
 // clang-format off
 /// biorthogonalization variants
@@ -262,6 +281,9 @@ struct ClosedShellCCSpintraceOptions {
   /// (spin-free) basis and thus has an exponential cost;
   /// the default is to use closed_shell_spintrace, which is more efficient
   bool naive_spintrace = false;
+  /// evaluation strategy of closed_shell_spintrace (ignored if
+  /// naive_spintrace is true)
+  SpintraceMode mode = SpintraceMode::Batch;
 };
 
 // clang-format off
@@ -342,7 +364,8 @@ std::vector<ExprPtr> open_shell_P_op_vector(const Tensor& A);
 /// @warning the "antisymmetrizer" tensor A is assumed to be at the front of each tensor
 /// network, hence must use "complete" canonicalization to produce the input expression.
 /// @note this performs full expansion of the antisymmetrizer
-/// @sa open_shell_CC_spintrace
+/// @note all spin cases are traced concurrently
+/// @sa open_shell_CC_spintrace, OpenShellSpintraceGenerator
 // clang-format on
 std::vector<ExprPtr> open_shell_spintrace(
     const ExprPtr& expr,
@@ -357,6 +380,56 @@ std::vector<ExprPtr> open_shell_spintrace(
     const container::svector<container::svector<Index>>& ext_index_groups,
     const std::optional<int>& target_spin_case = std::nullopt);
 
+namespace detail {
+struct OpenShellSpintraceState;
+}  // namespace detail
+
+/// @brief Lazily produces the spin blocks of open_shell_spintrace
+/// @details The antisymmetrizer is expanded upon construction, but each spin
+/// block is only traced when it is requested via next(). While the caller
+/// consumes a block (e.g. generates code for it) the following block is
+/// produced in the background.
+/// @sa open_shell_spintrace
+class OpenShellSpintraceGenerator {
+ public:
+  /// @param expr an input expression
+  /// @param ext_index_groups groups of external indices
+  /// @param target_spin_case if non-null specifies the target spin case of
+  /// the external indices, else produces all spin cases
+  OpenShellSpintraceGenerator(
+      const ExprPtr& expr,
+      const container::svector<container::svector<SlottedIndex>>&
+          ext_index_groups,
+      const std::optional<int>& target_spin_case = std::nullopt);
+  OpenShellSpintraceGenerator(
+      const ExprPtr& expr, EmptyInitializerList,
+      const std::optional<int>& target_spin_case = std::nullopt);
+  OpenShellSpintraceGenerator(
+      const ExprPtr& expr,
+      const container::svector<container::svector<Index>>& ext_index_groups,
+      const std::optional<int>& target_spin_case = std::nullopt);
+
+  OpenShellSpintraceGenerator(OpenShellSpintraceGenerator&&) = default;
+  OpenShellSpintraceGenerator& operator=(OpenShellSpintraceGenerator&&) =
+      default;
+
+  /// waits for the block that is being produced in the background, if any
+  ~OpenShellSpintraceGenerator();
+
+  /// @return the total number of spin blocks
+  std::size_t size() const;
+
+  /// @return the next spin block (blocks are produced in the same order as
+  /// returned by open_shell_spintrace), or std::nullopt if all blocks have
+  /// been produced
+  std::optional<ExprPtr> next();
+
+ private:
+  std::shared_ptr<const detail::OpenShellSpintraceState> state_;
+  std::size_t next_ = 0;
+  std::future<ExprPtr> prefetched_;
+};
+
 // clang-format off
 /// @brief Like open_shell_spintrace but uses minimal expansion of the antisymmetrizer
 /// @details This function is designed for integrating spin out of
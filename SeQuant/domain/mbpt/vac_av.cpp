@@ -4,16 +4,29 @@
 
 #include <SeQuant/domain/mbpt/vac_av.hpp>
 
+#include <SeQuant/domain/mbpt/derivation_cache.hpp>
+
 #include <SeQuant/core/context.hpp>
 #include <SeQuant/core/expr.hpp>
 #include <SeQuant/core/op.hpp>
+#include <SeQuant/core/utility/expr.hpp>
 #include <SeQuant/core/utility/macros.hpp>
+#include <SeQuant/core/utility/string.hpp>
 
+#include <range/v3/algorithm/all_of.hpp>
 #include <range/v3/algorithm/any_of.hpp>
 #include <range/v3/algorithm/for_each.hpp>
 #include <range/v3/range/conversion.hpp>
 #include <range/v3/view/filter.hpp>
 
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <sstream>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace sequant {
@@ -49,6 +62,214 @@ std::vector<std::pair<int, int>> lower_label_pairs(
   }
   return result;
 }
+
+/// process-wide memo of expectation values of operator products; once it
+/// holds `capacity()` entries, the oldest ones are evicted
+class VacAvMemo {
+ public:
+  struct Entry {
+    /// indices of the lowered product (incl. proto indices), in the order of
+    /// their appearance
+    container::svector<Index> indices;
+    /// expectation value of the lowered product with unit scalar
+    ExprPtr value;
+  };
+
+  static VacAvMemo& instance() {
+    static VacAvMemo memo;
+    return memo;
+  }
+
+  std::shared_ptr<const Entry> find(const std::wstring& key) const {
+    std::shared_lock lock(mtx_);
+    auto it = entries_.find(key);
+    return it == entries_.end() ? nullptr : it->second;
+  }
+
+  void insert(std::wstring key, std::shared_ptr<const Entry> entry) {
+    std::unique_lock lock(mtx_);
+    if (capacity_ == 0) return;
+    const auto [it, inserted] = entries_.emplace(key, std::move(entry));
+    if (inserted) order_.push_back(std::move(key));
+    evict();
+  }
+
+  void clear() {
+    std::unique_lock lock(mtx_);
+    entries_.clear();
+    order_.clear();
+  }
+
+  std::size_t capacity() const {
+    std::shared_lock lock(mtx_);
+    return capacity_;
+  }
+
+  void set_capacity(std::size_t capacity) {
+    std::unique_lock lock(mtx_);
+    capacity_ = capacity;
+    evict();
+  }
+
+  std::size_t size() const {
+    std::shared_lock lock(mtx_);
+    return entries_.size();
+  }
+
+ private:
+  mutable std::shared_mutex mtx_;
+  std::unordered_map<std::wstring, std::shared_ptr<const Entry>> entries_;
+  /// keys of entries_, oldest first
+  std::deque<std::wstring> order_;
+  std::size_t capacity_ = 1024;
+
+  /// @pre mtx_ is locked exclusively
+  void evict() {
+    while (entries_.size() > capacity_) {
+      entries_.erase(order_.front());
+      order_.pop_front();
+    }
+  }
+};
+
+/// @param fingerprint fingerprint of the default contexts (see
+/// DerivationCache::fingerprint())
+/// @return the memo key of a product of operators: the operators (label,
+/// quantum numbers, batching, order), the (lowered) connectivity, the Wick
+/// flags, and @p fingerprint ; the scalar of the product is not part of the
+/// key
+std::wstring vac_av_memo_key(const Product& product,
+                             const OpConnections<int>& connect,
+                             const OpConnections<int>& avoid,
+                             bool use_topology, bool full_contractions,
+                             const std::wstring& fingerprint) {
+  std::wostringstream oss;
+  for (const auto& factor : product) {
+    const auto& op = factor.as<op_t>();
+    oss << op.label() << L'|' << static_cast<const Expr&>(op).to_latex()
+        << L'|';
+    for (const auto& interval : op()) {
+      oss << interval.lower() << L',' << interval.upper() << L',';
+    }
+    oss << L'|' << op.order();
+    if (const auto ordinals = op.batch_ordinals()) {
+      for (const auto ordinal : *ordinals) oss << L',' << ordinal;
+    }
+    oss << L';';
+  }
+  oss << L"connect=";
+  for (const auto& [from, to] : connect) oss << from << L'-' << to << L',';
+  oss << L";avoid=";
+  for (const auto& [from, to] : avoid) oss << from << L'-' << to << L',';
+  oss << L";topology=" << use_topology << L";full=" << full_contractions
+      << L';' << fingerprint;
+  return oss.str();
+}
+
+/// @return indices (incl. proto indices) of the tensors in @p expr , in the
+/// order of their appearance
+container::svector<Index> memo_indices(ExprPtr& expr) {
+  container::svector<Index> result;
+  auto collect = [&result](const AbstractTensor& tensor) {
+    for (const auto& idx : tensor._slots()) {
+      result.push_back(idx);
+      for (const auto& proto : idx.proto_indices()) result.push_back(proto);
+    }
+  };
+  if (expr.is<AbstractTensor>()) {
+    collect(expr.as<AbstractTensor>());
+  } else {
+    expr->visit(
+        [&collect](ExprPtr& leaf) {
+          if (leaf.is<AbstractTensor>()) collect(leaf.as<AbstractTensor>());
+        },
+        /* atoms only = */ true);
+  }
+  return result;
+}
+
+/// @return true if @p expr can be remapped by transform_expr
+bool memoizable(const ExprPtr& expr) {
+  auto is_flat_term = [](const ExprPtr& term) {
+    if (term.is<Product>()) {
+      return ranges::all_of(term.as<Product>().factors(),
+                            [](const ExprPtr& factor) {
+                              return factor.is<AbstractTensor>() ||
+                                     factor.is<Constant>() ||
+                                     factor.is<Variable>();
+                            });
+    }
+    return term.is<AbstractTensor>() || term.is<Constant>();
+  };
+  if (expr.is<Sum>())
+    return ranges::all_of(expr.as<Sum>().summands(), is_flat_term);
+  return is_flat_term(expr);
+}
+
+/// @return copy of @p value with indices replaced by @p replacements and
+/// scaled by @p scalar
+/// @pre `memoizable(value)`
+ExprPtr transform_memo_value(const ExprPtr& value,
+                             const container::map<Index, Index>& replacements,
+                             const Constant::scalar_type& scalar) {
+  if (value.is<Constant>())
+    return ex<Constant>(value.as<Constant>().value() * scalar);
+  return transform_expr(value, replacements, scalar);
+}
+
+/// @return the memoized value with its indices replaced by @p indices and
+/// scaled by @p scalar , or null if the memoized product does not match
+/// @p indices , i.e. if they are not a 1-to-1 relabeling of the memoized
+/// indices that preserves their spaces
+ExprPtr recall(const VacAvMemo::Entry& entry,
+               const container::svector<Index>& indices,
+               const Constant::scalar_type& scalar) {
+  if (entry.indices.size() != indices.size()) return nullptr;
+  container::map<Index, Index> replacements;
+  container::set<Index> targets;
+  for (std::size_t i = 0; i != indices.size(); ++i) {
+    if (entry.indices[i].space() != indices[i].space()) return nullptr;
+    const auto [it, inserted] =
+        replacements.emplace(entry.indices[i], indices[i]);
+    if (inserted) {
+      if (!targets.insert(indices[i]).second) return nullptr;  // not 1-to-1
+    } else if (it->second != indices[i]) {
+      return nullptr;
+    }
+  }
+  return transform_memo_value(entry.value, replacements, scalar);
+}
+
+/// @return copy of @p product with scalar @p scalar in which Operators
+/// (including those nested in other factors) are replaced by their tensor
+/// forms and other factors are cloned, hence @p product is not affected by
+/// manipulations of the result
+/// @note unlike `lower_to_tensor_form(product->clone())` this does not clone
+/// the top-level Operators that are discarded by lowering
+ExprPtr lowered_copy(const Product& product,
+                     const Constant::scalar_type& scalar) {
+  auto result = std::make_shared<Product>(scalar, ExprPtrList{});
+  for (const auto& factor : product) {
+    ExprPtr lowered;
+    if (factor.is<op_t>()) {
+      lowered = factor.as<op_t>().tensor_form();
+    } else {
+      lowered = factor->clone();
+      lower_to_tensor_form(lowered);
+    }
+    result->append(1, std::move(lowered), Product::Flatten::No);
+  }
+  return result;
+}
+
+/// @return fingerprint of the default contexts to key the memo with if
+/// @p opts request memoization, else std::nullopt
+std::optional<std::wstring> memo_fingerprint(
+    const EVOptions<std::wstring>& opts) {
+  if (!opts.memoize) return std::nullopt;
+  return toUtf16(DerivationCache::fingerprint());
+}
+
 }  // namespace
 
 // fwd declare the tensor level impl function
@@ -58,30 +279,38 @@ ExprPtr expectation_value_impl(ExprPtr expr, OpConnections<int> connect,
                                bool full_contractions);
 }  // namespace tensor
 
-ExprPtr expectation_value_impl(ExprPtr expr,
-                               const OpConnections<std::wstring>& connect,
-                               const OpConnections<std::wstring>& avoid,
-                               bool use_topology, bool screen, bool skip_clone,
-                               bool full_contractions) {
-  // use cloned expr to avoid side effects
-  if (!skip_clone) expr = expr->clone();
+/// @param memo_fingerprint if nonnull, expectation values of operator products
+/// are memoized under keys that include this fingerprint of the default
+/// contexts (see DerivationCache::fingerprint()), computed once per top-level
+/// call
+ExprPtr expectation_value_impl(
+    ExprPtr expr, const OpConnections<std::wstring>& connect,
+    const OpConnections<std::wstring>& avoid, bool use_topology, bool screen,
+    bool skip_clone, bool full_contractions,
+    const std::optional<std::wstring>& memo_fingerprint) {
+  // products are lowered into copies (see lowered_copy), hence the input is
+  // only cloned, one product at a time, if it needs to be expanded; this
+  // avoids cloning the whole expression up front and keeps the pipeline
+  // screen -> lower -> WickTheorem -> accumulate parallel over the summands
 
   auto vac_av_product = [&connect, &avoid, use_topology, screen,
-                         full_contractions](ExprPtr expr) {
-    SEQUANT_ASSERT(expr.is<Product>());
+                         full_contractions,
+                         &memo_fingerprint](const ExprPtr& input) {
+    SEQUANT_ASSERT(input.is<Product>());
+    const auto& product = input.as<Product>();
     // Note: Non-tensor factors are filtered out at the tensor level (see
     // tensor::expectation_value_impl) before reaching WickTheorem
 
     // compute connections (both required and avoided)
     OpConnections<int> t_connect;
     OpConnections<int> t_avoid;
+    bool ops_only = true;
     {
       container::map<std::wstring, std::vector<int>>
           oplbl2pos;  // maps operator labels to the operator positions in the
                       // product
       int pos = 0;
-      bool ops_only = true;
-      for (const auto& factor : expr.as<Product>()) {
+      for (const auto& factor : product) {
         if (factor.is<op_t>()) {
           const auto& op = factor.as<op_t>();
           const std::wstring op_lbl = std::wstring(op.label());
@@ -103,7 +332,7 @@ ExprPtr expectation_value_impl(ExprPtr expr,
 
       // if composed of ops only, screen out products with zero VEV
       if (ops_only && screen) {
-        if (!can_change_qns(expr, qns_t{})) {
+        if (!can_change_qns(input, qns_t{})) {
           return ex<Constant>(0);
         }
       }
@@ -113,15 +342,48 @@ ExprPtr expectation_value_impl(ExprPtr expr,
       t_avoid = lower_label_pairs(oplbl2pos, avoid);
     }
 
+    // products of operators recur (up to index labels) within and across
+    // derivations, hence their expectation values are memoized; the scalar
+    // of the product is factored out to increase the reuse
+    std::optional<std::wstring> memo_key;
+    Constant::scalar_type scalar = 1;
+    container::svector<Index> indices;
+    if (memo_fingerprint && ops_only) {
+      memo_key = vac_av_memo_key(product, t_connect, t_avoid, use_topology,
+                                 full_contractions, *memo_fingerprint);
+      scalar = product.scalar();
+    }
+
     // lower to tensor form
-    lower_to_tensor_form(expr);
+    auto expr = lowered_copy(product, memo_key ? Constant::scalar_type{1}
+                                               : product.scalar());
+    if (memo_key) {
+      indices = memo_indices(expr);
+      if (const auto entry = VacAvMemo::instance().find(*memo_key)) {
+        if (auto vev = recall(*entry, indices, scalar)) return vev;
+      }
+    }
     simplify(expr);
 
     // compute expectation value
     // call the tensor-level impl function directly
     auto vev = tensor::expectation_value_impl(expr, t_connect, t_avoid,
                                               use_topology, full_contractions);
-    return simplify(vev);
+    simplify(vev);
+
+    if (memo_key) {
+      if (memoizable(vev)) {
+        VacAvMemo::instance().insert(
+            std::move(*memo_key),
+            std::make_shared<const VacAvMemo::Entry>(VacAvMemo::Entry{
+                .indices = std::move(indices), .value = vev->clone()}));
+        if (scalar != 1) vev = transform_memo_value(vev, {}, scalar);
+      } else if (scalar != 1) {
+        vev = ex<Constant>(scalar) * vev;
+        simplify(vev);
+      }
+    }
+    return vev;
   };
 
   ExprPtr result;
@@ -130,19 +392,22 @@ ExprPtr expectation_value_impl(ExprPtr expr,
     if (ranges::any_of(expr.as<Product>().factors(), [](const auto& factor) {
           return factor.template is<Sum>();
         })) {
+      // use cloned expr to avoid side effects
+      if (!skip_clone) expr = expr->clone();
       expr = expand(expr);
       simplify(expr);  // condense equivalent terms after expansion
       return expectation_value_impl(expr, connect, avoid, use_topology, screen,
-                                    /* skip_clone = */ true, full_contractions);
+                                    /* skip_clone = */ true, full_contractions,
+                                    memo_fingerprint);
     } else
       return vac_av_product(expr);
   } else if (expr.is<Sum>()) {
     result = sequant::transform_sum_expr(
-        *expr, [&connect, &avoid, use_topology, screen,
-                full_contractions](const auto& op_product) {
-          return expectation_value_impl(
-              op_product, connect, avoid, use_topology, screen,
-              /* skip_clone = */ true, full_contractions);
+        *expr, [&connect, &avoid, use_topology, screen, skip_clone,
+                full_contractions, &memo_fingerprint](const auto& op_product) {
+          return expectation_value_impl(op_product, connect, avoid,
+                                        use_topology, screen, skip_clone,
+                                        full_contractions, memo_fingerprint);
         });
     simplify(result);  // combine possible equivalent summands
     return result;
@@ -163,13 +428,24 @@ ExprPtr ref_av(ExprPtr expr, EVOptions<std::wstring> opts) {
       isr->reference_occupied_space() == isr->vacuum_occupied_space();
   return expectation_value_impl(expr, opts.connect, opts.do_not_connect,
                                 opts.use_topology, opts.screen, opts.skip_clone,
-                                full_contractions);
+                                full_contractions, memo_fingerprint(opts));
 }
 
 ExprPtr vac_av(ExprPtr expr, EVOptions<std::wstring> opts) {
   return expectation_value_impl(expr, opts.connect, opts.do_not_connect,
                                 opts.use_topology, opts.screen, opts.skip_clone,
-                                /* full_contractions */ true);
+                                /* full_contractions */ true,
+                                memo_fingerprint(opts));
+}
+
+void clear_vac_av_memo() { VacAvMemo::instance().clear(); }
+
+std::size_t vac_av_memo_size() { return VacAvMemo::instance().size(); }
+
+std::size_t vac_av_memo_capacity() { return VacAvMemo::instance().capacity(); }
+
+void set_vac_av_memo_capacity(std::size_t capacity) {
+  VacAvMemo::instance().set_capacity(capacity);
 }
 
 }  // namespace op
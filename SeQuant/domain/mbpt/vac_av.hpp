@@ -9,6 +9,8 @@
 
 #include <range/v3/view/concat.hpp>
 
+#include <cstddef>
+
 namespace sequant::mbpt {
 inline namespace op {
 
@@ -82,6 +84,25 @@ ExprPtr ref_av(ExprPtr expr, EVOptions<std::wstring> opts = {
 ExprPtr vac_av(ExprPtr expr, EVOptions<std::wstring> opts = {
                                  .connect = default_op_connections()});
 
+/// @brief clears the process-wide memo of expectation values of operator
+/// products used by ref_av() and vac_av()
+/// @sa EVOptions::memoize
+void clear_vac_av_memo();
+
+/// @return the number of operator products in the process-wide memo of
+/// expectation values
+std::size_t vac_av_memo_size();
+
+/// @return the maximum number of operator products in the process-wide memo
+/// of expectation values; the default is 1024
+std::size_t vac_av_memo_capacity();
+
+/// @brief sets the maximum number of operator products in the process-wide
+/// memo of expectation values; once the memo is full, the oldest entries are
+/// evicted. A capacity of 0 disables memoization.
+/// @param capacity the new capacity
+void set_vac_av_memo_capacity(std::size_t capacity);
+
 }  // namespace op
 }  // namespace sequant::mbpt
 #endif  // SEQUANT_DOMAIN_MBPT_VAC_AV_HPP
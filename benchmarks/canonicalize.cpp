@@ -1,7 +1,9 @@
 #include <benchmark/benchmark.h>
 
+#include <SeQuant/core/context.hpp>
 #include <SeQuant/core/expr.hpp>
 #include <SeQuant/core/io/shorthands.hpp>
+#include <SeQuant/core/options.hpp>
 
 using namespace sequant;
 
@@ -45,3 +47,25 @@ static void bench_canonicalize(benchmark::State &state) {
 }
 
 BENCHMARK(bench_canonicalize)->Name("canonicalize")->DenseRange(1, nInputs);
+
+static void bench_canonicalize_enumerated(benchmark::State &state) {
+  ExprPtr input = get_expression(state.range(0));
+
+  auto opts = CanonicalizeOptions::default_options();
+  opts.enumeration_max_tensors = state.range(1);
+  auto ctx_resetter =
+      set_scoped_default_context(Context(get_default_context()).set(opts));
+
+  for (auto _ : state) {
+    ExprPtr canonicalized = canonicalize(input->clone());
+
+    // Prevent canonicalization from being optimized away by the compiler
+    benchmark::DoNotOptimize(canonicalized);
+  }
+}
+
+// second argument is CanonicalizeOptions::enumeration_max_tensors, 0 uses the
+// graph canonicalization only
+BENCHMARK(bench_canonicalize_enumerated)
+    ->Name("canonicalize_enumerated")
+    ->ArgsProduct({benchmark::CreateDenseRange(1, nInputs, 1), {0, 4}});
@@ -13,6 +13,7 @@ int main(int argc, char *argv[]) {
   set_num_threads(1);
   set_locale();
   auto idxreg = mbpt::make_sr_spaces();
+  mbpt::add_thc_spaces(idxreg);
   Context fermi_ctx = Context({.index_space_registry_shared_ptr = idxreg,
                                .vacuum = Vacuum::SingleProduct});
   set_default_context(fermi_ctx);
@@ -0,0 +1,96 @@
+#include <benchmark/benchmark.h>
+
+#include <SeQuant/domain/mbpt/biorthogonalization.hpp>
+
+#if defined(SEQUANT_HAS_BTAS)
+
+#include <cstddef>
+#include <random>
+#include <vector>
+
+using namespace sequant;
+
+using BTensor = btas::Tensor<double>;
+
+/// @return random residual with @p n_particles virtual (bra) and occupied (ket)
+/// modes each
+BTensor make_residual(std::size_t n_particles, std::size_t nocc,
+                      std::size_t nvirt) {
+  std::vector<std::size_t> extents(n_particles, nvirt);
+  extents.resize(2 * n_particles, nocc);
+
+  BTensor result{btas::Range{extents}};
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> dist(-1, 1);
+  result.generate([&]() { return dist(gen); });
+  return result;
+}
+
+/// Materializes every permuted copy of the residual, i.e. the way the
+/// projection was applied before it was fused into a single pass
+BTensor nns_project_per_permutation(const BTensor& arr, std::size_t bra_rank) {
+  const std::size_t rank = arr.rank();
+  const std::size_t ket_rank = rank - bra_rank;
+  const auto& weights = mbpt::detail::nns_projection_weights<double>(ket_rank);
+
+  container::svector<std::size_t> perm(rank);
+  for (std::size_t i = 0; i < rank; ++i) perm[i] = i;
+  const container::svector<std::size_t> ket_perm(perm.begin() + bra_rank,
+                                                  perm.end());
+
+  BTensor result{arr.range()};
+  result.fill(0);
+  for (std::size_t p = 0; p < weights.size(); ++p) {
+    const auto permuted_ket =
+        mbpt::detail::compute_permuted_indices(ket_perm, p, ket_rank);
+    container::svector<std::size_t> annot(perm.begin(),
+                                          perm.begin() + bra_rank);
+    annot.insert(annot.end(), permuted_ket.begin(), permuted_ket.end());
+
+    BTensor temp;
+    btas::permute(arr, annot, temp, perm);
+    btas::scal(weights[p], temp);
+    result += temp;
+  }
+  return result;
+}
+
+static void nns_projection_fused(benchmark::State& state) {
+  const auto n_particles = static_cast<std::size_t>(state.range(0));
+  const auto arr = make_residual(n_particles, state.range(1), state.range(2));
+
+  for (auto _ : state) {
+    auto result = mbpt::biorthogonal_nns_project_btas(arr, n_particles);
+    benchmark::DoNotOptimize(result);
+  }
+  state.SetBytesProcessed(state.iterations() * arr.size() * sizeof(double));
+}
+
+static void nns_projection_per_permutation(benchmark::State& state) {
+  const auto n_particles = static_cast<std::size_t>(state.range(0));
+  const auto arr = make_residual(n_particles, state.range(1), state.range(2));
+
+  for (auto _ : state) {
+    auto result = nns_project_per_permutation(arr, n_particles);
+    benchmark::DoNotOptimize(result);
+  }
+  state.SetBytesProcessed(state.iterations() * arr.size() * sizeof(double));
+}
+
+// {n_particles, nocc, nvirt}: triples and quadruples residuals
+BENCHMARK(nns_projection_fused)
+    ->ArgNames({"n", "nocc", "nvirt"})
+    ->Args({3, 8, 16})
+    ->Args({3, 10, 20})
+    ->Args({4, 5, 8})
+    ->Args({4, 6, 8})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(nns_projection_per_permutation)
+    ->ArgNames({"n", "nocc", "nvirt"})
+    ->Args({3, 8, 16})
+    ->Args({3, 10, 20})
+    ->Args({4, 5, 8})
+    ->Args({4, 6, 8})
+    ->Unit(benchmark::kMillisecond);
+
+#endif  // defined(SEQUANT_HAS_BTAS)
@@ -0,0 +1,94 @@
+#include <benchmark/benchmark.h>
+
+#include <SeQuant/core/expr.hpp>
+#include <SeQuant/core/io/serialization/binary.hpp>
+#include <SeQuant/core/io/serialization/serialization.hpp>
+#include <SeQuant/core/utility/string.hpp>
+#include <SeQuant/domain/mbpt/models/cc.hpp>
+
+#include <cstddef>
+#include <map>
+#include <sstream>
+#include <string>
+
+using namespace sequant;
+using namespace sequant::io::serialization;
+
+namespace {
+
+/// @return the highest-rank CC residual of the given rank
+ExprPtr const& residual(std::size_t rank) {
+  static std::map<std::size_t, ExprPtr> residuals;
+  auto it = residuals.find(rank);
+  if (it == residuals.end())
+    it = residuals.emplace(rank, mbpt::CC{rank}.t().at(rank)).first;
+  return it->second;
+}
+
+}  // namespace
+
+static void serialize_to_string(benchmark::State& state) {
+  ExprPtr const& expr = residual(state.range(0));
+  std::size_t bytes = 0;
+
+  for (auto _ : state) {
+    std::string text = toUtf8(to_string(expr));
+    bytes += text.size();
+    benchmark::DoNotOptimize(text);
+  }
+  state.SetBytesProcessed(bytes);
+}
+
+static void serialize_text_stream(benchmark::State& state) {
+  ExprPtr const& expr = residual(state.range(0));
+  std::size_t bytes = 0;
+
+  for (auto _ : state) {
+    std::ostringstream os;
+    TextWriter(os).write(expr);
+    bytes += os.tellp();
+    benchmark::DoNotOptimize(os);
+  }
+  state.SetBytesProcessed(bytes);
+}
+
+static void serialize_binary_stream(benchmark::State& state) {
+  ExprPtr const& expr = residual(state.range(0));
+  std::size_t bytes = 0;
+
+  for (auto _ : state) {
+    std::ostringstream os;
+    binary::Writer(os).write(expr);
+    bytes += os.tellp();
+    benchmark::DoNotOptimize(os);
+  }
+  state.SetBytesProcessed(bytes);
+}
+
+static void deserialize_text(benchmark::State& state) {
+  const std::string text = toUtf8(to_string(residual(state.range(0))));
+
+  for (auto _ : state) {
+    ExprPtr expr = from_string<ExprPtr>(text);
+    benchmark::DoNotOptimize(expr);
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+
+static void deserialize_binary(benchmark::State& state) {
+  const std::string data = binary::to_binary(residual(state.range(0)));
+
+  for (auto _ : state) {
+    ExprPtr expr = binary::from_binary<ExprPtr>(data);
+    benchmark::DoNotOptimize(expr);
+  }
+  state.SetBytesProcessed(state.iterations() * data.size());
+}
+
+// the argument is the rank of the CC model whose highest-rank residual is
+// (de)serialized
+BENCHMARK(serialize_to_string)->DenseRange(2, 4);
+BENCHMARK(serialize_text_stream)->DenseRange(2, 4);
+BENCHMARK(serialize_binary_stream)->DenseRange(2, 4);
+BENCHMARK(deserialize_text)->DenseRange(2, 4);
+BENCHMARK(deserialize_binary)->DenseRange(2, 4);
@@ -0,0 +1,167 @@
+#include <benchmark/benchmark.h>
+
+#include <SeQuant/core/eval/backends/btas/eval_expr.hpp>
+#include <SeQuant/core/eval/backends/btas/result.hpp>
+#include <SeQuant/core/eval/eval.hpp>
+#include <SeQuant/core/expr.hpp>
+#include <SeQuant/core/optimize/optimize.hpp>
+#include <SeQuant/domain/mbpt/models/cc.hpp>
+#include <SeQuant/domain/mbpt/rules/thc.hpp>
+#include <SeQuant/domain/mbpt/rules/thc_eval.hpp>
+
+#if defined(SEQUANT_HAS_BTAS)
+
+#include <range/v3/range/conversion.hpp>
+
+#include <cstddef>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace sequant;
+
+using BTensor = btas::Tensor<double>;
+
+namespace {
+
+/// Leaf evaluator yielding random tensors; every tensor with the same label
+/// and index spaces is the same tensor
+class RandomTensors {
+ public:
+  RandomTensors(std::size_t nocc, std::size_t nvirt, std::size_t ngrid)
+      : nocc_{nocc}, nvirt_{nvirt}, ngrid_{ngrid} {}
+
+  ResultPtr operator()(meta::can_evaluate auto const& node) const {
+    if (node->result_type() != ResultType::Tensor)
+      return eval_result<ResultScalar<double>>(
+          node->as_constant().template value<double>());
+
+    auto const& tnsr = node->expr()->template as<Tensor>();
+    std::wstring key{tnsr.label()};
+    std::vector<std::size_t> extents;
+    for (Index const& ix : tnsr.const_indices()) {
+      key += L',';
+      key += ix.space().base_key();
+      extents.push_back(extent(ix.space()));
+    }
+    if (auto found = tensors_.find(key); found != tensors_.end())
+      return found->second;
+
+    BTensor result{btas::Range{extents}};
+    std::mt19937 gen(tensors_.size());
+    std::uniform_real_distribution<double> dist(-1, 1);
+    result.generate([&]() { return dist(gen); });
+    return tensors_
+        .emplace(key, eval_result<ResultTensorBTAS<BTensor>>(std::move(result)))
+        .first->second;
+  }
+
+ private:
+  std::size_t nocc_, nvirt_, ngrid_;
+  mutable std::map<std::wstring, ResultPtr> tensors_;
+
+  std::size_t extent(IndexSpace const& space) const {
+    auto const& isr = get_default_context().index_space_registry();
+    if (space == isr->retrieve(L"i")) return nocc_;
+    if (space == isr->retrieve(L"a")) return nvirt_;
+    if (space == isr->retrieve(L"L")) return ngrid_;
+    throw std::runtime_error("unexpected index space");
+  }
+};
+
+/// The terms of the THC-factorized CCSD doubles residual, without the
+/// antisymmetrizer, and the layout of the residual
+struct ThcCCSD {
+  std::vector<EvalNodeBTAS> nodes;
+  EvalExprBTAS::annot_t layout;
+};
+
+ThcCCSD const& thc_ccsd() {
+  static ThcCCSD const result = [] {
+    auto const r2 = mbpt::CC{2}.t().at(2);
+    auto const grid =
+        get_default_context().index_space_registry()->retrieve(L"L");
+
+    ThcCCSD result;
+    for (auto const& term : *r2) {
+      auto const& prod = term->as<Product>();
+      auto const& A = prod.factor(0)->as<Tensor>();
+      SEQUANT_ASSERT(A.label() == reserved::antisymm_label());
+      if (result.layout.empty())
+        result.layout = EvalExprBTAS::index_hash(A.const_braket_indices()) |
+                        ranges::to<EvalExprBTAS::annot_t>;
+
+      Product rest{prod.scalar(), prod.factors().begin() + 1,
+                   prod.factors().end()};
+      auto thc = mbpt::tensor_hypercontract(ex<Product>(std::move(rest)), grid,
+                                            L"g", L"B", L"C");
+      expand(thc);
+      auto const summands = thc->is<Sum>() ? *thc | ranges::to_vector
+                                           : std::vector<ExprPtr>{thc};
+      for (auto const& s : summands) {
+        SEQUANT_PRAGMA_IGNORE_DEPRECATED_BEGIN
+        result.nodes.push_back(binarize<EvalExprBTAS>(optimize(s)));
+        SEQUANT_PRAGMA_IGNORE_DEPRECATED_END
+      }
+    }
+    return result;
+  }();
+  return result;
+}
+
+/// Generates every leaf tensor once, outside of the timed loop; the batched
+/// evaluator holds a copy of the leaf evaluator that shares them
+void warm_up(std::vector<EvalNodeBTAS> const& nodes,
+             EvalExprBTAS::annot_t const& layout, RandomTensors const& yield) {
+  auto cache = CacheManager<EvalNodeBTAS>::empty();
+  (void)evaluate(nodes, layout, yield, cache);
+}
+
+}  // namespace
+
+static void thc_ccsd_unbatched(benchmark::State& state) {
+  auto const& [nodes, layout] = thc_ccsd();
+  RandomTensors const yield{static_cast<std::size_t>(state.range(0)),
+                            static_cast<std::size_t>(state.range(1)),
+                            static_cast<std::size_t>(state.range(2))};
+  warm_up(nodes, layout, yield);
+
+  for (auto _ : state) {
+    auto cache = CacheManager<EvalNodeBTAS>::empty();
+    auto result = evaluate(nodes, layout, yield, cache);
+    benchmark::DoNotOptimize(result);
+  }
+}
+
+static void thc_ccsd_grid_batched(benchmark::State& state) {
+  auto const& [nodes, layout] = thc_ccsd();
+  RandomTensors const yield{static_cast<std::size_t>(state.range(0)),
+                            static_cast<std::size_t>(state.range(1)),
+                            static_cast<std::size_t>(state.range(2))};
+  warm_up(nodes, layout, yield);
+  std::size_t const budget = state.range(3) * std::size_t{1024};
+
+  for (auto _ : state) {
+    auto cache = CacheManager<EvalNodeBTAS>::empty();
+    cache.set_custom_evaluator(mbpt::make_thc_custom_evaluator(yield, budget));
+    auto result = evaluate(nodes, layout, yield, cache);
+    benchmark::DoNotOptimize(result);
+  }
+}
+
+// {nocc, nvirt, ngrid}; the batched variant adds the budget in KiB
+BENCHMARK(thc_ccsd_unbatched)
+    ->ArgNames({"nocc", "nvirt", "ngrid"})
+    ->Args({4, 16, 64})
+    ->Args({6, 24, 128})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(thc_ccsd_grid_batched)
+    ->ArgNames({"nocc", "nvirt", "ngrid", "KiB"})
+    ->Args({4, 16, 64, 256})
+    ->Args({6, 24, 128, 256})
+    ->Args({6, 24, 128, 1024})
+    ->Unit(benchmark::kMillisecond);
+
+#endif  // defined(SEQUANT_HAS_BTAS)
@@ -62,6 +62,7 @@ static void wick(benchmark::State &state, bool full_conractions_only,
 
   std::size_t n_attempted = 0;
   std::size_t n_useful = 0;
+  std::size_t n_pruned = 0;
 
   // Note: only what is contained in this loop will be part
   // of the benchmark timings
@@ -81,10 +82,12 @@ static void wick(benchmark::State &state, bool full_conractions_only,
     const auto &statistics = wick.stats();
     n_attempted = statistics.num_attempted_contractions;
     n_useful = statistics.num_useful_contractions;
+    n_pruned = statistics.num_pruned_contractions;
   }
 
   state.counters["produced"] = n_useful;
   state.counters["attempted"] = n_attempted;
+  state.counters["pruned"] = n_pruned;
   state.counters["percentage"] =
       n_attempted > 0 ? static_cast<int>(100 * static_cast<float>(n_useful) /
                                          static_cast<float>(n_attempted))
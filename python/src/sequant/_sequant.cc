@@ -9,6 +9,7 @@
 #include <string>
 #include <vector>
 
+#include "eval.h"
 #include "mbpt.h"
 
 namespace py = pybind11;
@@ -174,4 +175,8 @@ PYBIND11_MODULE(_sequant, m) {
   m.def("simplify", &sequant::python::simplify);
 
   python::mbpt::__init__(m.def_submodule("mbpt"));
+
+#ifdef SEQUANT_HAS_BTAS
+  python::eval::__init__(m);
+#endif
 }
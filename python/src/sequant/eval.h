@@ -0,0 +1,339 @@
+#ifndef SEQUANT_PYTHON_EVAL_H
+#define SEQUANT_PYTHON_EVAL_H
+
+#ifdef SEQUANT_HAS_BTAS
+
+#include <SeQuant/core/container.hpp>
+#include <SeQuant/core/eval/backends/btas/eval_expr.hpp>
+#include <SeQuant/core/eval/backends/btas/result.hpp>
+#include <SeQuant/core/eval/cache_manager.hpp>
+#include <SeQuant/core/eval/eval.hpp>
+#include <SeQuant/core/expr.hpp>
+#include <SeQuant/core/index.hpp>
+#include <SeQuant/core/optimize/optimize.hpp>
+#include <SeQuant/core/space.hpp>
+#include <SeQuant/core/utility/indices.hpp>
+#include <SeQuant/core/utility/macros.hpp>
+#include <SeQuant/core/utility/string.hpp>
+
+#include <btas/btas.h>
+
+#include "python.h"
+
+#include <pybind11/numpy.h>
+#include <range/v3/range/conversion.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace sequant::python::eval {
+
+///
+/// \brief Contiguous storage for btas::Tensor that either owns its elements or
+///        borrows them from a buffer kept alive by a shared owner.
+///
+/// Copies are deep and always own their elements, so a borrowed buffer is
+/// never written through a copy; moves transfer the (borrowed) buffer.
+///
+template <typename T>
+class ArrayStorage {
+ public:
+  using value_type = T;
+  using pointer = T*;
+  using const_pointer = T const*;
+  using reference = T&;
+  using const_reference = T const&;
+  using iterator = T*;
+  using const_iterator = T const*;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+
+  ArrayStorage() = default;
+
+  explicit ArrayStorage(size_type n) : ArrayStorage(n, T{}) {}
+
+  ArrayStorage(size_type n, T const& value) : data_{allocate(n)}, size_{n} {
+    std::fill_n(data(), n, value);
+  }
+
+  /// Borrows the \p n elements at \p ptr, which \p owner keeps alive.
+  ArrayStorage(T* ptr, size_type n, std::shared_ptr<void> owner)
+      : data_{std::move(owner), ptr}, size_{n}, borrowed_{true} {}
+
+  ArrayStorage(ArrayStorage const& other)
+      : data_{allocate(other.size_)}, size_{other.size_} {
+    std::copy_n(other.data(), size_, data());
+  }
+
+  ArrayStorage(ArrayStorage&& other) noexcept { swap(other); }
+
+  ArrayStorage& operator=(ArrayStorage const& other) {
+    if (this != &other) ArrayStorage{other}.swap(*this);
+    return *this;
+  }
+
+  ArrayStorage& operator=(ArrayStorage&& other) noexcept {
+    ArrayStorage{std::move(other)}.swap(*this);
+    return *this;
+  }
+
+  [[nodiscard]] size_type size() const noexcept { return size_; }
+  [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+
+  /// \return True if the elements are borrowed rather than owned.
+  [[nodiscard]] bool borrowed() const noexcept { return borrowed_; }
+
+  [[nodiscard]] T* data() noexcept { return data_.get(); }
+  [[nodiscard]] T const* data() const noexcept { return data_.get(); }
+
+  iterator begin() noexcept { return data(); }
+  iterator end() noexcept { return data() + size_; }
+  const_iterator begin() const noexcept { return data(); }
+  const_iterator end() const noexcept { return data() + size_; }
+  const_iterator cbegin() const noexcept { return begin(); }
+  const_iterator cend() const noexcept { return end(); }
+
+  reference operator[](size_type i) noexcept { return data()[i]; }
+  const_reference operator[](size_type i) const noexcept { return data()[i]; }
+
+  /// Resizes to \p n elements, preserving the leading ones. A borrowed buffer
+  /// is always replaced by an owned one, since resizing precedes writing.
+  void resize(size_type n) {
+    if (n == size_ && !borrowed_) return;
+    ArrayStorage result(n);
+    std::copy_n(data(), std::min(n, size_), result.data());
+    swap(result);
+  }
+
+  void swap(ArrayStorage& other) noexcept {
+    using std::swap;
+    swap(data_, other.data_);
+    swap(size_, other.size_);
+    swap(borrowed_, other.borrowed_);
+  }
+
+ private:
+  std::shared_ptr<T> data_;
+  size_type size_ = 0;
+  bool borrowed_ = false;
+
+  static std::shared_ptr<T> allocate(size_type n) {
+    if (n == 0) return nullptr;
+    return std::shared_ptr<T>(new T[n](), std::default_delete<T[]>{});
+  }
+};
+
+using Tensor_t =
+    ::btas::Tensor<double, ::btas::DEFAULT::range, ArrayStorage<double>>;
+
+/// A NumPy array borrowed for the duration of an evaluate() call.
+struct Leaf {
+  double* data = nullptr;
+  container::svector<std::size_t> shape;
+  /// Holds a reference to the array; released with the GIL held.
+  std::shared_ptr<void> owner;
+
+  /// \return A btas::Tensor viewing the array without copying.
+  [[nodiscard]] Tensor_t tensor() const {
+    std::size_t size = 1;
+    for (auto e : shape) size *= e;
+    return Tensor_t(::btas::DEFAULT::range(
+                        std::vector<std::size_t>(shape.begin(), shape.end())),
+                    ArrayStorage<double>(data, size, owner));
+  }
+};
+
+/// Leaf evaluator serving the arrays passed to evaluate().
+class LeafEvaluator {
+ public:
+  LeafEvaluator(container::map<std::wstring, Leaf> const& tensors,
+                container::map<std::wstring, double> const& scalars)
+      : tensors_{tensors}, scalars_{scalars} {}
+
+  ResultPtr operator()(meta::can_evaluate auto const& n) const {
+    if (n->result_type() == ResultType::Scalar) {
+      if (n->expr()->template is<Constant>())
+        return eval_result<ResultScalar<double>>(
+            n->as_constant().template value<double>());
+      auto const& label = n->expr()->template as<Variable>().label();
+      return eval_result<ResultScalar<double>>(
+          scalars_.at(std::wstring(label)));
+    }
+
+    SEQUANT_ASSERT(n->result_type() == ResultType::Tensor &&
+                   n->expr()->template is<Tensor>());
+    auto const& leaf = tensors_.at(std::wstring(n->as_tensor().label()));
+    return eval_result<ResultTensorBTAS<Tensor_t>>(leaf.tensor());
+  }
+
+ private:
+  container::map<std::wstring, Leaf> const& tensors_;
+  container::map<std::wstring, double> const& scalars_;
+};
+
+/// \return A NumPy array sharing the elements of the tensor held by \p res,
+///         or a float if \p res is a scalar.
+inline py::object to_numpy(ResultPtr res) {
+  if (res->is<ResultScalar<double>>())
+    return py::float_(res->as<ResultScalar<double>>().value());
+
+  auto& tensor = res->get<Tensor_t>();
+  // evaluation results never alias the input arrays, but keep it that way
+  if (tensor.storage().borrowed()) tensor = Tensor_t(tensor);
+
+  std::vector<py::ssize_t> shape;
+  for (auto e : tensor.range().extent()) shape.push_back(e);
+  double* data = tensor.storage().data();
+
+  // the capsule keeps the result, and thereby its elements, alive
+  auto* holder = new ResultPtr(std::move(res));
+  py::capsule owner(holder, [](void* p) { delete static_cast<ResultPtr*>(p); });
+  return py::array_t<double>(shape, data, owner);
+}
+
+///
+/// \brief Evaluates \p expr using the NumPy arrays in \p arrays.
+///
+/// The arrays are used in place if they are C-contiguous arrays of float64,
+/// otherwise they are converted first. The expression is optimized using the
+/// extents of the arrays, binarized, and evaluated with the BTAS backend,
+/// reusing intermediates common to its terms, with the GIL released.
+///
+/// \param expr Expression to evaluate.
+/// \param arrays Maps the label of each tensor in \p expr to an array whose
+///               axes are the slots of the tensor (bra, then ket, then aux),
+///               and the label of each variable to a number.
+/// \param indices Labels of the indices of the result in the order of its
+///                axes. Defaults to the free indices of \p expr, bra first.
+/// \return The result as a NumPy array sharing its elements with the
+///         evaluated tensor, or as a float if the result is a scalar.
+///
+inline py::object evaluate(
+    ExprPtr const& expr, py::dict const& arrays,
+    std::optional<std::vector<std::wstring>> const& indices) {
+  container::map<std::wstring, Leaf> tensors;
+  container::map<std::wstring, double> scalars;
+  for (auto&& [key, value] : arrays) {
+    auto label = key.cast<std::wstring>();
+    if (py::isinstance<py::float_>(value) || py::isinstance<py::int_>(value)) {
+      scalars.emplace(std::move(label), value.cast<double>());
+      continue;
+    }
+    auto array =
+        py::array_t<double, py::array::c_style | py::array::forcecast>::ensure(
+            value);
+    if (!array)
+      throw py::type_error("evaluate: cannot convert the value for '" +
+                           toUtf8(label) + "' to an array of float64");
+    Leaf leaf;
+    // evaluation only reads the leaves, see ArrayStorage
+    leaf.data = const_cast<double*>(array.data());
+    leaf.shape.assign(array.shape(), array.shape() + array.ndim());
+    leaf.owner = std::shared_ptr<void>(new py::object(std::move(array)),
+                                       [](void* p) {
+                                         py::gil_scoped_acquire gil;
+                                         delete static_cast<py::object*>(p);
+                                       });
+    tensors.emplace(std::move(label), std::move(leaf));
+  }
+
+  // validate the arrays against the tensors, and collect the extents of the
+  // index spaces for the optimizer
+  container::map<IndexSpace, std::size_t> extents;
+  auto check = [&](ExprPtr const& x) {
+    if (x->is<Variable>()) {
+      auto label = std::wstring(x->as<Variable>().label());
+      if (scalars.find(label) == scalars.end())
+        throw py::value_error("evaluate: no value for variable '" +
+                              toUtf8(label) + "'");
+      return;
+    }
+    if (!x->is<Tensor>()) return;
+    auto const& t = x->as<Tensor>();
+    auto label = std::wstring(t.label());
+    auto it = tensors.find(label);
+    if (it == tensors.end())
+      throw py::value_error("evaluate: no array for tensor '" + toUtf8(label) +
+                            "'");
+    auto const& shape = it->second.shape;
+    if (shape.size() != t.num_slots())
+      throw py::value_error("evaluate: array for tensor '" + toUtf8(label) +
+                            "' has " + std::to_string(shape.size()) +
+                            " axes, expected " +
+                            std::to_string(t.num_slots()));
+    std::size_t axis = 0;
+    for (auto const& ix : t.slots()) {
+      auto extent = shape[axis++];
+      if (!ix.nonnull()) continue;
+      auto [pos, inserted] = extents.emplace(ix.space(), extent);
+      if (!inserted && pos->second != extent)
+        throw py::value_error(
+            "evaluate: inconsistent extents for index space " +
+            toUtf8(ix.space().base_key()));
+    }
+  };
+  expr->visit(check, /* atoms_only = */ true);
+  check(expr);
+
+  std::vector<Index> result_indices;
+  if (indices) {
+    for (auto const& l : *indices) result_indices.emplace_back(l);
+  } else {
+    auto free = get_unique_indices(expr);
+    for (auto* g : {&free.bra, &free.ket, &free.aux})
+      result_indices.insert(result_indices.end(), g->begin(), g->end());
+  }
+
+  ResultPtr result;
+  {
+    py::gil_scoped_release release;
+
+    auto optimized = optimize(
+        expr, OptimizeOptions{.idx_to_extent = [&extents](Index const& ix) {
+          auto it = extents.find(ix.space());
+          return it != extents.end() ? it->second
+                                     : ix.space().approximate_size();
+        }});
+
+    // the result layout is imposed explicitly below, so the positional head
+    // of binarize(ExprPtr) does not matter
+    container::vector<EvalNodeBTAS> nodes;
+    SEQUANT_PRAGMA_IGNORE_DEPRECATED_BEGIN
+    if (optimized->is<Sum>()) {
+      for (auto const& s : optimized->as<Sum>().summands())
+        nodes.push_back(binarize<EvalExprBTAS>(s));
+    } else {
+      nodes.push_back(binarize<EvalExprBTAS>(optimized));
+    }
+    SEQUANT_PRAGMA_IGNORE_DEPRECATED_END
+
+    auto cache = cache_manager(nodes);
+    auto const layout =
+        EvalExprBTAS::index_hash(result_indices) |
+        ranges::to<EvalExprBTAS::annot_t>;
+    result = sequant::evaluate(nodes, layout, LeafEvaluator{tensors, scalars},
+                               cache);
+  }
+
+  return to_numpy(std::move(result));
+}
+
+inline void __init__(py::module m) {
+  m.def("evaluate", &evaluate,
+        "evaluate(expr, arrays, indices=None) evaluates expr using the NumPy "
+        "arrays (and numbers) in the dict arrays keyed by tensor (and "
+        "variable) label, and returns the result as a NumPy array whose axes "
+        "follow indices (by default the free indices of expr), or as a float",
+        py::arg("expr"), py::arg("arrays"), py::arg("indices") = py::none());
+}
+
+}  // namespace sequant::python::eval
+
+#endif  // SEQUANT_HAS_BTAS
+
+#endif /* SEQUANT_PYTHON_EVAL_H */
@@ -53,6 +53,41 @@ class TestSequant(unittest.TestCase):
     s = visit(String(), ccd)
     print (s)
 
+  @unittest.skipUnless(hasattr(sq, "evaluate"), "requires the BTAS backend")
+  def test_evaluate(self):
+    import numpy as np
+    rng = np.random.default_rng(42)
+    f = rng.random((4, 6))
+    g = rng.random((6, 3))
+    h = rng.random((6, 3))
+
+    A = Tensor("A", ["i_1"], ["a_1"], [])
+    B = Tensor("B", ["a_1"], ["i_2"], [])
+    C = Tensor("C", ["a_1"], ["i_2"], [])
+    expr = A * B + A * C
+
+    r = sq.evaluate(expr, {"A": f, "B": g, "C": h})
+    self.assertEqual(r.shape, (4, 3))
+    self.assertTrue(np.allclose(r, f @ (g + h)))
+
+    # explicit result layout
+    r = sq.evaluate(expr, {"A": f, "B": g, "C": h}, indices=["i_2", "i_1"])
+    self.assertTrue(np.allclose(r, (f @ (g + h)).T))
+
+    # the inputs are neither copied into nor written to
+    f0 = f.copy()
+    sq.evaluate(A * B, {"A": f, "B": g})
+    self.assertTrue(np.array_equal(f, f0))
+
+    # full contraction
+    x = rng.random((6, 4))
+    X = Tensor("X", ["a_1"], ["i_1"], [])
+    self.assertAlmostEqual(sq.evaluate(A * X, {"A": f, "X": x}),
+                           float(np.sum(f * x.T)))
+
+    with self.assertRaises(ValueError):
+      sq.evaluate(expr, {"A": f, "B": g})
+
 
 if __name__ == '__main__':
   unittest.main()
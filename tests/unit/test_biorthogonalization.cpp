@@ -1,3 +1,4 @@
+#include <catch2/catch_approx.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_string.hpp>
 
@@ -98,6 +99,49 @@ TEST_CASE("biorthogonalization", "[Biorthogonalization]") {
     }
   }
 
+  SECTION("NNS projector") {
+    // exact weights agree with the hardcoded ones ...
+    for (std::size_t n = 1; n <= 5; ++n) {
+      CAPTURE(n);
+      const auto exact = mbpt::detail::nns_projector_row(n);
+      const auto hardcoded =
+          mbpt::detail::hardcoded_nns_projector<double>(n).value();
+      REQUIRE(exact.size() == hardcoded.size());
+      for (std::size_t i = 0; i < exact.size(); ++i) {
+        CAPTURE(i);
+        REQUIRE(static_cast<double>(exact[i]) == Catch::Approx(hardcoded[i]));
+      }
+    }
+
+    // ... and with the pseudoinverse-based ones beyond
+    {
+      const std::size_t n = 6;
+      const auto exact = mbpt::detail::nns_projector_row(n);
+      const auto computed = mbpt::detail::compute_nns_p_coeffs(n);
+      REQUIRE(exact.size() == computed.size());
+      for (std::size_t i = 0; i < exact.size(); ++i) {
+        CAPTURE(i);
+        REQUIRE(static_cast<double>(exact[i]) ==
+                Catch::Approx(computed[i]).margin(1e-10));
+      }
+    }
+  }
+
+  SECTION("biorthogonalizer") {
+    // exact coefficients agree with the pseudoinverse-based ones
+    for (std::size_t n = 3; n <= 6; ++n) {
+      CAPTURE(n);
+      const auto exact = mbpt::detail::biorthogonalizer_row(n);
+      const auto computed = mbpt::detail::compute_biorthogonalizer_row(n);
+      REQUIRE(exact.size() == computed.size());
+      for (std::size_t i = 0; i < exact.size(); ++i) {
+        CAPTURE(i);
+        REQUIRE(static_cast<double>(exact[i]) ==
+                Catch::Approx(computed[i]).margin(1e-10));
+      }
+    }
+  }
+
   SECTION("error") {
     const std::vector<std::vector<std::wstring>> inputs = {
         {L"R{i1,u1;a1,u2} = X{i1,u1;a1,u2}"},
@@ -9,6 +9,7 @@
 #include <SeQuant/core/io/shorthands.hpp>
 #include <SeQuant/core/optimize/optimize.hpp>
 #include <SeQuant/domain/mbpt/biorthogonalization.hpp>
+#include <SeQuant/domain/mbpt/rules/thc_eval.hpp>
 
 #include <btas/btas.h>
 #include <btas/tensor_func.h>
@@ -22,7 +23,9 @@
 #include <range/v3/view/transform.hpp>
 
 #include <complex>
+#include <initializer_list>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace {
@@ -393,6 +396,96 @@ TEST_CASE("eval_with_btas", "[eval_btas]") {
     REQUIRE(norm(eval1) == Catch::Approx(norm(man1)));
   }
 
+  SECTION("Fused (Anti)symmetrization Accumulation") {
+    auto expr1 = parse_antisymm(L"g_{i1, i2}^{a1, a2}");
+    auto tidx1 = tidxs(L"i_1,i_2,a_1,a_2");
+    auto const& g = yield(L"g{o,o;v,v}");
+
+    auto man_symm = eval_symm(expr1, tidx1);
+    man_symm += g;
+    ResultPtr fused_symm = eval_result<ResultTensorBTAS<BTensorD>>(g);
+    evaluate_symm_inplace(fused_symm, eval_node(expr1), tidx1, yield_);
+    BTensorD diff_symm = fused_symm->get<BTensorD>() - man_symm;
+    REQUIRE(norm(diff_symm) == Catch::Approx(0).margin(1e-12));
+
+    auto man_antisymm = eval_antisymm(expr1, tidx1);
+    man_antisymm += g;
+    ResultPtr fused_antisymm = eval_result<ResultTensorBTAS<BTensorD>>(g);
+    evaluate_antisymm_inplace(fused_antisymm, eval_node(expr1), tidx1, yield_);
+    BTensorD diff_antisymm = fused_antisymm->get<BTensorD>() - man_antisymm;
+    REQUIRE(norm(diff_antisymm) == Catch::Approx(0).margin(1e-12));
+
+    // null accumulator: same as the non-fused evaluation
+    ResultPtr fresh;
+    evaluate_antisymm_inplace(fresh, eval_node(expr1), tidx1, yield_);
+    REQUIRE(norm(fresh->get<BTensorD>()) ==
+            Catch::Approx(norm(eval_antisymm(expr1, tidx1))));
+  }
+
+  SECTION("Batched Evaluation") {
+    auto expr1 = parse_antisymm(L"g_{i1, i2}^{a1, a2} * t_{a1, a2}^{i3, i4}");
+    auto tidx1 = tidxs(L"i_1,i_2,i_3,i_4");
+    auto const node1 = eval_node(expr1);
+    auto const man1 = evaluate(node1, tidx1, yield_)->get<BTensorD>();
+
+    // g and t carry nocc^2 * nvirt elements per element of the batched
+    // unoccupied index: a budget of 5 such slices yields 4 batches of 5
+    std::size_t const slice_bytes = nocc * nocc * nvirt * sizeof(double);
+    std::size_t n_batches = 0;
+    auto spy = [&n_batches](std::size_t n) {
+      n_batches = n;
+      return no_scope_guard{};
+    };
+    auto cache = CacheManager<std::remove_cvref_t<decltype(node1)>>::empty();
+    cache.set_custom_evaluator(make_batched_custom_evaluator(
+        yield_, memory_budget_batch_size{.budget_bytes = 5 * slice_bytes},
+        accept_any_index{}, spy));
+    auto const eval1 = evaluate(node1, tidx1, yield_, cache)->get<BTensorD>();
+    REQUIRE(n_batches == 4);
+
+    BTensorD zero1 = eval1 - man1;
+    REQUIRE(norm(zero1) == Catch::Approx(0).margin(1e-12));
+  }
+
+  SECTION("THC Batched Evaluation") {
+    // a THC-like chain whose unoccupied indices play the role of the grid;
+    // a grid of 7 points is not a multiple of any batch size but 1 and 7
+    std::size_t const ngrid = 7;
+    auto const thc_yield = rand_tensor_yield<BTensorD>{nocc, ngrid};
+    auto const grid = mbpt::thc_grid_index{
+        .grid_space = get_default_context().index_space_registry()->retrieve(
+            L"a")};
+
+    auto expr1 = parse_antisymm(L"Y_{i1}^{a3} * Z_{a3}^{a4} * X_{a1}^{a4}");
+    auto tidx1 = tidxs(L"i_1,a_1");
+    auto const node1 = eval_node(expr1);
+    auto const man1 = evaluate(node1, tidx1, thc_yield)->get<BTensorD>();
+
+    // whichever grid index is batched, Z and the intermediate it forms with
+    // X (or Y) are the largest tensors carrying it, with ngrid elements per
+    // grid point
+    std::size_t const slice_bytes = ngrid * sizeof(double);
+    using budget_t = std::pair<std::size_t, std::size_t>;
+    for (auto const& [budget_slices, expected_batches] :
+         std::initializer_list<budget_t>{{1, ngrid}, {3, 3}, {ngrid, 0}}) {
+      std::size_t n_batches = 0;
+      auto spy = [&n_batches](std::size_t n) {
+        n_batches = n;
+        return no_scope_guard{};
+      };
+      auto cache = CacheManager<std::remove_cvref_t<decltype(node1)>>::empty();
+      cache.set_custom_evaluator(mbpt::make_thc_custom_evaluator(
+          thc_yield, budget_slices * slice_bytes, grid, spy));
+      auto const eval1 =
+          evaluate(node1, tidx1, thc_yield, cache)->get<BTensorD>();
+      // a single batch is left to the standard evaluation
+      REQUIRE(n_batches == expected_batches);
+
+      BTensorD zero1 = eval1 - man1;
+      REQUIRE(norm(zero1) == Catch::Approx(0).margin(1e-12));
+    }
+  }
+
   SECTION("Biorthogonal Cleanup") {
     using btas::permute;
     // low-rank residuals: skip cleanup
@@ -1,3 +1,4 @@
+#include <catch2/catch_approx.hpp>
 #include <catch2/catch_test_macros.hpp>
 
 #include "catch2_sequant.hpp"
@@ -6,17 +7,26 @@
 #include <SeQuant/core/container.hpp>
 #include <SeQuant/core/context.hpp>
 #include <SeQuant/core/eval/eval_expr.hpp>
+#include <SeQuant/core/eval/permuted_sum.hpp>
 #include <SeQuant/core/expr.hpp>
 #include <SeQuant/core/index.hpp>
 #include <SeQuant/core/io/shorthands.hpp>
+#include <SeQuant/core/math.hpp>
+#include <SeQuant/core/rational.hpp>
 #include <SeQuant/core/tensor_canonicalizer.hpp>
 #include <SeQuant/core/utility/macros.hpp>
 
+#include <algorithm>
+#include <cmath>
 #include <initializer_list>
+#include <iterator>
 #include <memory>
+#include <numeric>
+#include <random>
 #include <set>
 #include <string>
 #include <string_view>
+#include <vector>
 
 #include <range/v3/range/conversion.hpp>
 #include <range/v3/view/transform.hpp>
@@ -533,3 +543,79 @@ TEST_CASE("eval_expr", "[EvalExpr]") {
     REQUIRE_NOTHROW(result_expr(t1, t2, EvalOp::Product));
   }
 }
+
+TEST_CASE("permuted_sum", "[eval]") {
+  using namespace sequant;
+
+  auto fill = [](std::vector<double>& data) {
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    for (auto& x : data) x = dist(gen);
+  };
+
+  SECTION("two-pass particle antisymmetrization") {
+    // 4! x 3! and 4! x 4! signed permutations exceed the number of
+    // permutations summed in a single pass
+    for (std::size_t const ket_rank : {3, 4}) {
+      std::size_t const bra_rank = 4;
+      container::svector<std::size_t> const extents(bra_rank + ket_rank, 4);
+      std::size_t volume = 1;
+      for (auto e : extents) volume *= e;
+
+      std::vector<double> in(volume);
+      fill(in);
+
+      // reference: the plain sum over all combined signed permutations
+      std::vector<container::svector<std::size_t>> annots;
+      std::vector<double> weights;
+      double const nf = static_cast<double>(
+          rational{1, factorial(bra_rank) * factorial(ket_rank)});
+      auto parity = [](auto first, auto last) {
+        int result = 0;
+        for (auto i = first; i != last; ++i)
+          for (auto j = std::next(i); j != last; ++j)
+            if (*i > *j) result ^= 1;
+        return result;
+      };
+      container::svector<std::size_t> bra(bra_rank);
+      std::iota(bra.begin(), bra.end(), std::size_t{0});
+      do {
+        container::svector<std::size_t> ket(ket_rank);
+        std::iota(ket.begin(), ket.end(), bra_rank);
+        do {
+          container::svector<std::size_t> annot(bra);
+          annot.insert(annot.end(), ket.begin(), ket.end());
+          annots.push_back(std::move(annot));
+          weights.push_back(parity(bra.begin(), bra.end()) ^
+                                    parity(ket.begin(), ket.end())
+                                ? -nf
+                                : nf);
+        } while (std::next_permutation(ket.begin(), ket.end()));
+      } while (std::next_permutation(bra.begin(), bra.end()));
+      std::vector<double> expected(volume);
+      detail::permuted_sum_dense(in.data(), expected.data(), extents, annots,
+                                 weights);
+
+      std::vector<double> result(volume);
+      detail::particle_antisymmetrize_dense(in.data(), result.data(), extents,
+                                            bra_rank);
+      // accumulation adds to the output
+      std::vector<double> accumulated(in);
+      detail::particle_antisymmetrize_dense(
+          in.data(), accumulated.data(), extents, bra_rank, true);
+
+      double max_diff = 0;
+      double max_diff_accumulated = 0;
+      for (std::size_t i = 0; i < volume; ++i) {
+        max_diff = std::max(max_diff, std::abs(result[i] - expected[i]));
+        max_diff_accumulated =
+            std::max(max_diff_accumulated,
+                     std::abs(accumulated[i] - in[i] - expected[i]));
+      }
+      REQUIRE(max_diff == Catch::Approx(0).margin(1e-12));
+      REQUIRE(max_diff_accumulated == Catch::Approx(0).margin(1e-12));
+      REQUIRE(std::any_of(expected.begin(), expected.end(),
+                          [](double x) { return std::abs(x) > 1e-3; }));
+    }
+  }
+}
@@ -3,6 +3,7 @@
 
 #include "test_export.hpp"
 
+#include <SeQuant/core/export/cpp.hpp>
 #include <SeQuant/core/export/export.hpp>
 #include <SeQuant/core/export/export_expr.hpp>
 #include <SeQuant/core/export/export_node.hpp>
@@ -31,6 +32,7 @@
 #include <filesystem>
 #include <fstream>
 #include <optional>
+#include <random>
 #include <ranges>
 #include <string>
 #include <tuple>
@@ -508,6 +510,65 @@ TEST_CASE("export", "[export]") {
                                       "Unload v2\n"
                                       "Persist v1\n"));
     }
+    SECTION("memory scheduling") {
+      ctx.set_current_expression_id(0);
+      ctx.set_current_section_name("residual");
+
+      generator.begin_expression(ctx);
+      generator.create(v1, true, ctx);
+      generator.load(v2, false, ctx);
+      generator.load(v3, false, ctx);
+      generator.compute(*deserialize(L"2 v2"), v1, ctx);
+      generator.compute(*deserialize(L"3 v3"), v1, ctx);
+      generator.unload(v3, ctx);
+      generator.unload(v2, ctx);
+      generator.persist(v1, ctx);
+      generator.end_expression(ctx);
+
+      // v2 is no longer needed once v3 is required
+      REQUIRE_THAT(generator.get_generated_code(),
+                   DiffedStringEquals("Create v1 and initialize to zero\n"
+                                      "Load v2\n"
+                                      "Compute v1 += 2 v2\n"
+                                      "Unload v2\n"
+                                      "Load v3\n"
+                                      "Compute v1 += 3 v3\n"
+                                      "Unload v3\n"
+                                      "Persist v1\n"));
+
+      REQUIRE(generator.predicted_peak_memory().size() == 1);
+      REQUIRE(generator.predicted_peak_memory().at("residual") == 2);
+    }
+    SECTION("memory scheduling disabled") {
+      ctx.set_current_expression_id(0);
+      ctx.set_current_section_name("residual");
+      REQUIRE(generator.memory_scheduling_enabled());
+      generator.enable_memory_scheduling(false);
+
+      generator.begin_expression(ctx);
+      generator.create(v1, true, ctx);
+      generator.load(v2, false, ctx);
+      generator.load(v3, false, ctx);
+      generator.compute(*deserialize(L"2 v2"), v1, ctx);
+      generator.compute(*deserialize(L"3 v3"), v1, ctx);
+      generator.unload(v3, ctx);
+      generator.unload(v2, ctx);
+      generator.persist(v1, ctx);
+      generator.end_expression(ctx);
+
+      // operations are emitted in the order they were received
+      REQUIRE_THAT(generator.get_generated_code(),
+                   DiffedStringEquals("Create v1 and initialize to zero\n"
+                                      "Load v2\n"
+                                      "Load v3\n"
+                                      "Compute v1 += 2 v2\n"
+                                      "Compute v1 += 3 v3\n"
+                                      "Unload v3\n"
+                                      "Unload v2\n"
+                                      "Persist v1\n"));
+
+      REQUIRE(generator.predicted_peak_memory().at("residual") == 3);
+    }
     SECTION("elided load/unload") {
       SECTION("single") {
         export_expression(
@@ -931,7 +992,8 @@ TEST_CASE("PythonEinsumGenerator", "[export]") {
     REQUIRE_THAT(code, Catch::Matchers::ContainsSubstring("np.zeros"));
     REQUIRE_THAT(code, Catch::Matchers::ContainsSubstring("np.load"));
     REQUIRE_THAT(code, Catch::Matchers::ContainsSubstring("np.einsum"));
-    REQUIRE_THAT(code, Catch::Matchers::ContainsSubstring("optimize=True"));
+    REQUIRE_THAT(code, Catch::Matchers::ContainsSubstring(
+                           "optimize=['einsum_path', (0, 1)]"));
     REQUIRE_THAT(code, Catch::Matchers::ContainsSubstring("T_vv +="));
     REQUIRE_THAT(code, Catch::Matchers::ContainsSubstring("np.save"));
   }
@@ -962,7 +1024,7 @@ TEST_CASE("PythonEinsumGenerator", "[export]") {
     REQUIRE_THAT(code, Catch::Matchers::ContainsSubstring("torch.load"));
     REQUIRE_THAT(code, Catch::Matchers::ContainsSubstring("torch.einsum"));
     REQUIRE_THAT(code, Catch::Matchers::ContainsSubstring("torch.save"));
-    REQUIRE_THAT(code, !Catch::Matchers::ContainsSubstring("optimize=True"));
+    REQUIRE_THAT(code, !Catch::Matchers::ContainsSubstring("optimize="));
   }
 
   SECTION("Scalar factor") {
@@ -1020,4 +1082,272 @@ TEST_CASE("PythonEinsumGenerator", "[export]") {
     REQUIRE_THAT(code, Catch::Matchers::ContainsSubstring("->'"));
     REQUIRE_THAT(code, Catch::Matchers::ContainsSubstring(".einsum('"));
   }
+
+  SECTION("Contraction path") {
+    auto A = ex<Tensor>(L"A", bra{L"a_1"}, ket{L"i_1"});
+    auto B = ex<Tensor>(L"B", bra{L"i_1"}, ket{L"a_2"});
+    auto C = ex<Tensor>(L"C", bra{L"a_2"}, ket{L"a_3"});
+    Tensor R(L"R", bra{L"a_1"}, ket{L"a_3"});
+
+    NumPyEinsumGeneratorContext ctx;
+    NumPyEinsumGenerator generator;
+    generator.compute(*(A * B * C), R, ctx);
+    generator.compute(*A, Tensor(L"R", bra{L"a_1"}, ket{L"i_1"}), ctx);
+
+    REQUIRE(generator.get_generated_code() ==
+            "R_aa += np.einsum('ai,ib,bc->ac', A_ai, B_ia, C_aa, "
+            "optimize=['einsum_path', (0, 1), (0, 1)])\n"
+            "R_ai += np.einsum('ai->ai', A_ai)\n");
+  }
+
+  SECTION("Large index counts") {
+    auto indices = [](std::wstring_view label, std::size_t first,
+                      std::size_t last) {
+      std::vector<Index> result;
+      for (std::size_t n = first; n <= last; ++n) {
+        result.emplace_back(std::wstring(label) + L"_" + std::to_wstring(n));
+      }
+      return result;
+    };
+    auto list = [](std::size_t first, std::size_t last) {
+      std::string result;
+      for (std::size_t n = first; n <= last; ++n) {
+        if (!result.empty()) result += ", ";
+        result += std::to_string(n);
+      }
+      return result;
+    };
+
+    SECTION("Sublist form") {
+      // 28 distinct indices exceed the 26 labels of torch's subscript form
+      auto A = ex<Tensor>(L"A", bra(indices(L"i", 1, 14)),
+                          ket(indices(L"a", 1, 14)));
+      auto B = ex<Tensor>(L"B", bra(indices(L"a", 1, 14)), ket{});
+      Tensor R(L"R", bra(indices(L"i", 1, 14)), ket{});
+
+      PyTorchEinsumGeneratorContext ctx;
+      PyTorchEinsumGenerator generator;
+      generator.compute(*(A * B), R, ctx);
+
+      const std::string code = generator.get_generated_code();
+      REQUIRE_THAT(code, Catch::Matchers::StartsWith("R_iiiiiiiiiiiiii += "
+                                                     "torch.einsum(A_"));
+      REQUIRE_THAT(code, Catch::Matchers::ContainsSubstring(
+                             ", [" + list(0, 27) + "], B_"));
+      REQUIRE_THAT(code, Catch::Matchers::EndsWith(
+                             ", [" + list(14, 27) + "], [" + list(0, 13) +
+                             "])\n"));
+    }
+
+    SECTION("Tensordot") {
+      // 81 distinct indices exceed the 52 labels of einsum's sublist form
+      auto A = ex<Tensor>(L"A", bra(indices(L"i", 1, 27)),
+                          ket(indices(L"a", 1, 27)));
+      auto B = ex<Tensor>(L"B", bra(indices(L"a", 1, 27)),
+                          ket(indices(L"i", 28, 54)));
+      Tensor R(L"R", bra(indices(L"i", 28, 54)), ket(indices(L"i", 1, 27)));
+
+      NumPyEinsumGeneratorContext ctx;
+      NumPyEinsumGenerator generator;
+      generator.compute(*(A * B), R, ctx);
+
+      const std::string code = generator.get_generated_code();
+      REQUIRE_THAT(code, Catch::Matchers::ContainsSubstring(
+                             "np.transpose(np.tensordot(A_"));
+      REQUIRE_THAT(code, Catch::Matchers::EndsWith(
+                             ", ([" + list(27, 53) + "], [" + list(0, 26) +
+                             "])), (" + list(27, 53) + ", " + list(0, 26) +
+                             "))\n"));
+
+      // Hadamard products can't be spelled via tensordot
+      Tensor H(L"H", bra(indices(L"i", 1, 27)), ket(indices(L"i", 28, 54)));
+      auto C = ex<Tensor>(L"C", bra(indices(L"a", 1, 27)),
+                          ket(indices(L"i", 1, 27)));
+      REQUIRE_THROWS_AS(generator.compute(*(A * C), H, ctx), Exception);
+    }
+  }
+}
+
+#ifdef SEQUANT_UNITTESTS_CPP_EXPORT_DRIVER
+// Writes code generated by CppGenerator to SEQUANT_UNITTESTS_CPP_EXPORT_DRIVER,
+// together with a driver that instantiates its unnamed section with a backend
+// that provides the required members but does nothing; the driver is compiled
+// by the unit_tests-sequant-cpp-export target (see CMakeLists.txt)
+bool write_stub_backend_driver(const std::string &code,
+                               const std::string &namespace_name) {
+  const std::filesystem::path driver_path = SEQUANT_UNITTESTS_CPP_EXPORT_DRIVER;
+  std::error_code ec;
+  std::filesystem::create_directories(driver_path.parent_path(), ec);
+  if (ec) return false;
+
+  // N.B. write to a file of our own and rename it, so that the driver is
+  // replaced atomically if several test processes produce it concurrently
+  const std::filesystem::path temp_path =
+      driver_path.string() + "." + std::to_string(std::random_device{}()) +
+      ".tmp";
+  {
+    std::ofstream source(temp_path);
+    if (!source) return false;
+
+    source << code << "\n";
+    source
+        << "#include <string_view>\n"
+           "\n"
+           "struct StubBackend {\n"
+           "  std::size_t extent(std::string_view) { return 2; }\n"
+           "  std::vector<double> load(std::string_view, std::size_t size) {\n"
+           "    return std::vector<double>(size);\n"
+           "  }\n"
+           "  void persist(std::string_view, const std::vector<double> &) {}\n"
+           "  double load_scalar(std::string_view) { return 0; }\n"
+           "  void persist_scalar(std::string_view, double) {}\n"
+           "  void remove(std::string_view) {}\n"
+           "  void gemm(bool, bool, std::size_t, std::size_t, std::size_t,\n"
+           "            double, const double *, const double *, double *) {}\n"
+           "};\n"
+           "\n"
+           "int main() {\n"
+           "  StubBackend backend;\n"
+           "  "
+        << namespace_name
+        << "::unnamed(backend);\n"
+           "}\n";
+    if (!source) return false;
+  }
+
+  std::filesystem::rename(temp_path, driver_path, ec);
+  if (ec) std::filesystem::remove(temp_path, ec);
+  return !ec;
+}
+#endif  // SEQUANT_UNITTESTS_CPP_EXPORT_DRIVER
+
+TEST_CASE("CppGenerator", "[export]") {
+  auto resetter = to_export_context();
+
+  auto registry = get_default_context().index_space_registry();
+  IndexSpace occ = registry->retrieve("i");
+  IndexSpace virt = registry->retrieve("a");
+
+  CppGeneratorContext ctx;
+  ctx.enable_rewriting(false);
+  ctx.set_dim(occ, "nocc");
+  ctx.set_dim(virt, "nvirt");
+  ctx.set_tag(occ, "o");
+  ctx.set_tag(virt, "v");
+
+  CppGenerator<> generator;
+
+  SECTION("GEMM") {
+    auto F = ex<Tensor>(L"F", bra{L"a_1"}, ket{L"i_1"});
+    auto t = ex<Tensor>(L"t", bra{L"i_1"}, ket{L"a_2"});
+    Tensor T(L"T", bra{L"a_1"}, ket{L"a_2"});
+
+    export_expression(to_export_tree(ResultExpr(T, F * t)), generator, ctx);
+
+    std::string code = generator.get_generated_code();
+
+    REQUIRE_THAT(code, Catch::Matchers::ContainsSubstring(
+                           "template <typename Backend>\n"
+                           "void unnamed([[maybe_unused]] Backend &backend) {"));
+    REQUIRE_THAT(code,
+                 Catch::Matchers::ContainsSubstring(
+                     "const std::size_t nocc = backend.extent(\"nocc\");"));
+    REQUIRE_THAT(code, Catch::Matchers::ContainsSubstring(
+                           "F_vo = backend.load(\"F_vo\", nvirt * nocc);"));
+    REQUIRE_THAT(code, Catch::Matchers::ContainsSubstring(
+                           "backend.gemm(false, false, nvirt, nvirt, nocc, 1, "
+                           "F_vo.data(), t_ov.data(), T_vv.data());"));
+    REQUIRE_THAT(code, Catch::Matchers::ContainsSubstring(
+                           "backend.persist(\"T_vv\", T_vv);"));
+  }
+
+  SECTION("transposed operands") {
+    auto A = ex<Tensor>(L"A", bra{L"a_1"}, ket{L"i_2"});
+    auto B = ex<Tensor>(L"B", bra{L"i_1"}, ket{L"a_1"});
+    Tensor I(L"I", bra{L"i_2"}, ket{L"i_1"});
+
+    export_expression(to_export_tree(ResultExpr(I, A * B)), generator, ctx);
+
+    // I[i2,i1] = A[a1,i2] B[i1,a1] = (A^T B^T)[i2,i1]
+    REQUIRE_THAT(generator.get_generated_code(),
+                 Catch::Matchers::ContainsSubstring(
+                     "backend.gemm(true, true, nocc, nocc, nvirt, 1, "
+                     "A_vo.data(), B_ov.data(), I_oo.data());"));
+  }
+
+  SECTION("full contraction") {
+    auto g = ex<Tensor>(L"g", bra{L"i_1", L"i_2"}, ket{L"a_1", L"a_2"});
+    auto t = ex<Tensor>(L"t", bra{L"a_1", L"a_2"}, ket{L"i_1", L"i_2"});
+    Variable E(L"E");
+
+    export_expression(to_export_tree(ResultExpr(E, ex<Constant>(2) * g * t)),
+                      generator, ctx);
+
+    std::string code = generator.get_generated_code();
+
+    REQUIRE_THAT(code, Catch::Matchers::ContainsSubstring("double E = 0;"));
+    REQUIRE_THAT(code, Catch::Matchers::ContainsSubstring(
+                           "permute<double, 4>(1, t_vvoo.data(), "
+                           "{nvirt, nvirt, nocc, nocc}, {2, 3, 0, 1}, "
+                           "t_vvoo_b.data(), false);"));
+    REQUIRE_THAT(code, Catch::Matchers::ContainsSubstring(
+                           "backend.gemm(false, false, 1, 1, "
+                           "nocc * nocc * nvirt * nvirt, 2.0, g_oovv.data(), "
+                           "t_vvoo_b.data(), &E);"));
+  }
+
+  SECTION("operands with the same label") {
+    auto t1 = ex<Tensor>(L"t", bra{L"a_1", L"a_3"}, ket{L"i_3", L"i_1"});
+    auto t2 = ex<Tensor>(L"t", bra{L"a_2", L"a_3"}, ket{L"i_2", L"i_3"});
+    Tensor R(L"R", bra{L"a_1", L"a_2"}, ket{L"i_1", L"i_2"});
+
+    export_expression(to_export_tree(ResultExpr(R, t1 * t2)), generator, ctx);
+
+    std::string code = generator.get_generated_code();
+
+    // Both operands and the result have to be permuted, each into a
+    // temporary of its own
+    REQUIRE_THAT(code, Catch::Matchers::ContainsSubstring(
+                           "std::vector<double> t_vvoo_a("));
+    REQUIRE_THAT(code, Catch::Matchers::ContainsSubstring(
+                           "std::vector<double> t_vvoo_b("));
+    REQUIRE_THAT(code, Catch::Matchers::ContainsSubstring(
+                           "std::vector<double> R_vvoo_c("));
+    REQUIRE_THAT(code, Catch::Matchers::ContainsSubstring(
+                           "backend.gemm(false, false, nvirt * nocc, "
+                           "nvirt * nocc, nvirt * nocc, 1, t_vvoo_a.data(), "
+                           "t_vvoo_b.data(), R_vvoo_c.data());"));
+
+#ifdef SEQUANT_UNITTESTS_CPP_EXPORT_DRIVER
+    // compiled by the sequant/unit/export/cpp/compile test
+    REQUIRE(write_stub_backend_driver(code, ctx.namespace_name()));
+#endif
+  }
+
+  SECTION("loop nest") {
+    ctx.set_extent(occ, 2);
+    ctx.set_extent(virt, 3);
+    ctx.set_block_size(2);
+
+    auto F = ex<Tensor>(L"F", bra{L"a_1"}, ket{L"i_1"});
+    auto t = ex<Tensor>(L"t", bra{L"i_1"}, ket{L"a_2"});
+    Tensor T(L"T", bra{L"a_1"}, ket{L"a_2"});
+
+    export_expression(to_export_tree(ResultExpr(T, F * t)), generator, ctx);
+
+    std::string code = generator.get_generated_code();
+
+    REQUIRE_THAT(code, Catch::Matchers::ContainsSubstring(
+                           "constexpr std::size_t nocc = 2;"));
+    REQUIRE_THAT(code, !Catch::Matchers::ContainsSubstring("backend.gemm"));
+    // Loops over virtual indices are blocked, the one over the occupied index
+    // isn't
+    REQUIRE_THAT(code, Catch::Matchers::ContainsSubstring(
+                           "for (std::size_t a_1_block = 0; a_1_block < nvirt; "
+                           "a_1_block += 2) {"));
+    REQUIRE_THAT(code, !Catch::Matchers::ContainsSubstring("i_1_block"));
+    REQUIRE_THAT(code, Catch::Matchers::ContainsSubstring(
+                           "T_vv[a_1 * nvirt + a_2] += F_vo[a_1 * nocc + i_1] "
+                           "* t_ov[i_1 * nvirt + a_2];"));
+  }
 }
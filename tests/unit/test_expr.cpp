@@ -755,6 +755,35 @@ TEST_CASE("expr", "[elements]") {
               L"{\\text{Dummy}}{\\text{Dummy}}} - {{{2}}"
               L"{\\text{Dummy}}{\\text{Dummy}}}\\bigr) }");
     }
+    {  // concurrent expansion produces the same terms in the same order
+      auto make_x = [] {
+        return (ex<Constant>(1) + ex<Dummy>()) *
+               (ex<Constant>(3) + ex<Dummy>()) *
+               (ex<Constant>(5) + ex<Dummy>() + ex<Dummy>());
+      };
+      auto x_serial = make_x();
+      expand(x_serial);
+      auto x_parallel = make_x();
+      expand(x_parallel, {.parallel_threshold = 1});
+      REQUIRE(x_serial->size() == 12);
+      REQUIRE(to_latex(x_parallel) == to_latex(x_serial));
+    }
+    {  // expansion fused with canonicalization combines like terms
+      auto make_x = [] {
+        return deserialize<ExprPtr>(L"(t{i1;a1} + t{i2;a2}) * "
+                                    L"(t{i1;a1} + t{i2;a2})");
+      };
+      auto x = make_x();
+      expand(x);
+      REQUIRE(x->size() == 4);
+      for (std::size_t threshold : {1, 256}) {
+        auto x_fused = make_x();
+        expand(x_fused,
+               {.canonicalize = true, .parallel_threshold = threshold});
+        REQUIRE(x_fused->size() == 3);
+        REQUIRE_THAT(x_fused, EquivalentTo(simplify(x->clone())));
+      }
+    }
   }
 
   SECTION("flatten") {
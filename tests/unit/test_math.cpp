@@ -14,6 +14,7 @@
 
 #include <cmath>
 #include <iostream>
+#include <limits>
 #include <new>
 #include <stdexcept>
 #include <string>
@@ -61,4 +62,17 @@ TEST_CASE("math", "[elements]") {
             "175999932299156089414639761565182862536979208272237582511852109168"
             "64000000000000000000000000");
   }
+
+  SECTION("saturating arithmetic") {
+    constexpr auto max = std::numeric_limits<std::size_t>::max();
+    STATIC_REQUIRE(saturating_add(2, 3) == 5);
+    STATIC_REQUIRE(saturating_add(max - 1, 1) == max);
+    STATIC_REQUIRE(saturating_add(max - 1, 2) == max);
+    STATIC_REQUIRE(saturating_mul(0, max) == 0);
+    STATIC_REQUIRE(saturating_mul(max, 0) == 0);
+    STATIC_REQUIRE(saturating_mul(max / 2, 2) == max - 1);
+    STATIC_REQUIRE(saturating_mul(max / 2 + 1, 2) == max);
+    constexpr std::size_t two_32 = std::size_t{1} << 32;
+    STATIC_REQUIRE(saturating_mul(two_32, two_32) == max);
+  }
 }
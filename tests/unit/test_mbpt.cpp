@@ -16,6 +16,7 @@
 #include <SeQuant/domain/mbpt/op_registry.hpp>
 #include <SeQuant/domain/mbpt/rules/df.hpp>
 #include <SeQuant/domain/mbpt/rules/thc.hpp>
+#include <SeQuant/domain/mbpt/rules/thc_eval.hpp>
 #include <SeQuant/domain/mbpt/utils.hpp>
 #include <SeQuant/domain/mbpt/vac_av.hpp>
 
@@ -990,6 +991,68 @@ SECTION("vac_av with Power") {
                EquivalentTo(L"g{i1,i2;a1,a2}:A-C-S * t{a1,a2;i1,i2}:A-C-S"));
 }
 
+SECTION("memoized vac_av") {
+  o::clear_vac_av_memo();
+  // memoization is opt-in
+  const auto reference = o::vac_av(o::P(nₚ(2)) * o::H() * o::T(2) * o::T(2));
+  REQUIRE(o::vac_av_memo_size() == 0);
+
+  const EVOptions<std::wstring> memoized{.connect = default_op_connections(),
+                                         .memoize = true};
+  const auto first =
+      o::vac_av(o::P(nₚ(2)) * o::H() * o::T(2) * o::T(2), memoized);
+  const auto nentries = o::vac_av_memo_size();
+  REQUIRE(nentries > 0);
+  REQUIRE(simplify(first - reference) == ex<Constant>(0));
+
+  // recurring products are recalled, with fresh external indices and scaled
+  const auto second = o::vac_av(ex<Constant>(rational{1, 2}) * o::P(nₚ(2)) *
+                                    o::H() * o::T(2) * o::T(2),
+                                memoized);
+  REQUIRE(o::vac_av_memo_size() == nentries);
+  REQUIRE(simplify(ex<Constant>(2) * second - reference) == ex<Constant>(0));
+
+  // the memo is bounded, the oldest entries are evicted
+  const auto capacity = o::vac_av_memo_capacity();
+  o::set_vac_av_memo_capacity(1);
+  REQUIRE(o::vac_av_memo_size() == 1);
+  const auto third =
+      o::vac_av(o::P(nₚ(2)) * o::H() * o::T(2) * o::T(2), memoized);
+  REQUIRE(o::vac_av_memo_size() == 1);
+  REQUIRE(simplify(third - reference) == ex<Constant>(0));
+  o::set_vac_av_memo_capacity(0);
+  REQUIRE(o::vac_av_memo_size() == 0);
+  o::set_vac_av_memo_capacity(capacity);
+}
+
+SECTION("vac_av of sum does not modify input") {
+  auto input = expand(o::P(nₚ(2)) * o::H() * o::T(2) * o::T(2));
+  REQUIRE(input->is<Sum>());
+  const auto input_latex = to_latex(input);
+  const auto reference =
+      o::vac_av(input->clone(),
+                {.connect = default_op_connections(), .memoize = false});
+  // operator products are lowered into copies even if cloning is skipped
+  const auto result = o::vac_av(input, {.connect = default_op_connections(),
+                                        .skip_clone = true,
+                                        .memoize = false});
+  REQUIRE(to_latex(input) == input_latex);
+  REQUIRE(simplify(result - reference) == ex<Constant>(0));
+}
+
+SECTION("vac_av lowers nested operators") {
+  const auto reference =
+      o::vac_av(o::h(2) * o::t(2), {.connect = {}, .memoize = false});
+  // operators nested in non-operator factors are lowered too
+  const auto nested = ex<Product>(
+      1,
+      ExprPtrList{o::h(2),
+                  ex<Product>(1, ExprPtrList{o::t(2)}, Product::Flatten::No)},
+      Product::Flatten::No);
+  const auto result = o::vac_av(nested, {.connect = {}, .memoize = false});
+  REQUIRE(simplify(result - reference) == ex<Constant>(0));
+}
+
 SECTION("SRSO-PNO") {
   using sequant::mbpt::Context;
   auto mbpt_ctx = sequant::mbpt::set_scoped_default_mbpt_context(
@@ -1186,6 +1249,14 @@ SECTION("rules") {
 
       REQUIRE_THAT(actual, EquivalentTo(expected.at(i)));
     }
+
+    // grid indices are recognized by their space
+    const IndexSpace aux_space =
+        get_default_context().index_space_registry()->retrieve(L"x");
+    const mbpt::thc_grid_index is_grid{.grid_space = aux_space};
+    REQUIRE(is_grid(Index{L"x_1"}));
+    REQUIRE_FALSE(is_grid(Index{L"i_1"}));
+    REQUIRE_FALSE(mbpt::thc_grid_index{}(Index{L"x_1"}));
   }
 }  // SECTION("rules")
 
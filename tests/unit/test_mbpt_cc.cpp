@@ -2,14 +2,21 @@
 // Created by Eduard Valeyev on 2023-12-06
 //
 
+#include <SeQuant/core/context.hpp>
 #include <SeQuant/core/expr.hpp>
+#include <SeQuant/core/io/shorthands.hpp>
 #include <SeQuant/core/logger.hpp>
+#include <SeQuant/core/utility/exception.hpp>
 #include <SeQuant/core/utility/timer.hpp>
+#include <SeQuant/domain/mbpt/derivation_cache.hpp>
 #include <SeQuant/domain/mbpt/models/cc.hpp>
 
 #include <catch2/catch_test_macros.hpp>
 #include "catch2_sequant.hpp"
 
+#include <filesystem>
+#include <memory>
+
 TEST_CASE("mbpt_cc", "[mbpt/cc][valgrind_skip]") {
   using namespace sequant;
   using namespace sequant::mbpt;
@@ -30,6 +37,21 @@ TEST_CASE("mbpt_cc", "[mbpt/cc][valgrind_skip]") {
         }
       }
 
+      SECTION("CCSD t, enumerated canonicalization") {
+        // small networks are canonicalized by enumeration, which must
+        // identify the same equivalent terms as the graph canonicalization
+        const auto N = 2;
+        const auto graph_t_eqs = CC{N}.t();
+        auto opts = CanonicalizeOptions::default_options();
+        opts.enumeration_max_tensors = 4;
+        auto resetter = set_scoped_default_context(
+            sequant::Context(get_default_context()).set(opts));
+        auto t_eqs = CC{N}.t();
+        REQUIRE(t_eqs.size() == N + 1);
+        for (auto k = 0; k <= N; ++k)
+          REQUIRE(size(t_eqs[k]) == size(graph_t_eqs[k]));
+      }
+
     }  // SECTION("t")
 
     SECTION("λ") {
@@ -128,6 +150,103 @@ SECTION("EOM-CCSDT") {
 #endif
 }
 
+SECTION("derivation cache") {
+  const auto dir = std::filesystem::temp_directory_path() /
+                   "sequant_test_mbpt_cc_derivation_cache";
+  std::filesystem::remove_all(dir);
+  const auto cache = std::make_shared<const DerivationCache>(
+      DerivationCache::Options{.directory = dir});
+  const auto validating =
+      std::make_shared<const DerivationCache>(DerivationCache::Options{
+          .directory = dir, .mode = DerivationCache::Mode::Validate});
+
+  const auto N = 2;
+  const auto derived = CC{N, {.cache = cache}}.t();
+  const auto cached = CC{N, {.cache = cache}}.t();
+  REQUIRE(cached.size() == derived.size());
+  for (auto k = 0; k <= N; ++k)
+    REQUIRE_THAT(cached[k], EquivalentTo(derived[k]));
+
+  // validation mode re-derives and compares against the stored entry
+  REQUIRE_NOTHROW(CC{N, {.cache = validating}}.t());
+
+  // null elements survive the round trip, mismatches are detected
+  cache->store("test", {ExprPtr{}, deserialize(L"t{a1;i1}")});
+  const auto entry = cache->load("test");
+  REQUIRE(entry);
+  REQUIRE(entry->size() == 2);
+  REQUIRE(!entry->at(0));
+  REQUIRE_THAT(entry->at(1), EquivalentTo(L"t{a1;i1}"));
+  REQUIRE_THROWS_AS(validating->get_or_derive("test",
+                                              [] {
+                                                return std::vector<ExprPtr>{
+                                                    ExprPtr{},
+                                                    deserialize(L"t{a1;i2}")};
+                                              }),
+                    Exception);
+
+  // every result-affecting field of the default contexts is part of the key
+  {
+    const auto base_fingerprint = DerivationCache::fingerprint();
+    auto misses = [&](auto&& modify) {
+      auto ctx = get_default_context().clone();
+      modify(ctx);
+      auto resetter = set_scoped_default_context(ctx);
+      return DerivationCache::fingerprint() != base_fingerprint &&
+             !cache->load("test");
+    };
+    REQUIRE(misses([](sequant::Context& ctx) { ctx.set(Vacuum::Physical); }));
+    REQUIRE(misses(
+        [](sequant::Context& ctx) { ctx.set(IndexSpaceMetric::General); }));
+    REQUIRE(misses([](sequant::Context& ctx) {
+      ctx.set(get_default_context().assert_strict_braket_symmetry()
+                  ? AssertStrictBraKetSymmetry::No
+                  : AssertStrictBraKetSymmetry::Yes);
+    }));
+    REQUIRE(misses([](sequant::Context& ctx) { ctx.set(SPBasis::Spinfree); }));
+    REQUIRE(misses([](sequant::Context& ctx) {
+      ctx.set_first_dummy_index_ordinal(ctx.first_dummy_index_ordinal() + 1);
+    }));
+    REQUIRE(misses([](sequant::Context& ctx) {
+      ctx.set(CanonicalizeOptions::default_options().copy_and_set(
+          CanonicalizationMethod::Complete));
+    }));
+    REQUIRE(misses([](sequant::Context& ctx) {
+      ctx.set(CanonicalizeOptions::default_options().copy_and_set(
+          container::set<Index>{Index{L"i_1"}}));
+    }));
+    REQUIRE(misses([](sequant::Context& ctx) {
+      auto opts = CanonicalizeOptions::default_options();
+      opts.enumeration_max_tensors = 4;
+      ctx.set(opts);
+    }));
+    REQUIRE(misses([](sequant::Context& ctx) {
+      auto* space = ctx.mutable_index_space_registry()->retrieve_ptr(L"i");
+      space->approximate_size(space->approximate_size() + 1);
+    }));
+    REQUIRE(misses([](sequant::Context& ctx) {
+      auto* space = ctx.mutable_index_space_registry()->retrieve_ptr(L"a");
+      space->field(space->field() == Field::Real ? Field::Complex
+                                                 : Field::Real);
+    }));
+    {
+      auto resetter = set_scoped_default_mbpt_context(
+          get_default_mbpt_context().clone().set(
+              get_default_mbpt_context().csv() == CSV::Yes ? CSV::No
+                                                           : CSV::Yes));
+      REQUIRE(DerivationCache::fingerprint() != base_fingerprint);
+      REQUIRE(!cache->load("test"));
+    }
+    // typesetting does not affect the results
+    REQUIRE(!misses([](sequant::Context& ctx) {
+      ctx.set(BraKetTypesetting::ContraSuper);
+    }));
+    REQUIRE(DerivationCache::fingerprint() == base_fingerprint);
+  }
+
+  std::filesystem::remove_all(dir);
+}
+
 #ifndef SEQUANT_SKIP_LONG_TESTS
 SECTION("ucc") {
   SECTION("t") {
@@ -10,6 +10,7 @@
 #include <SeQuant/core/index.hpp>
 #include <SeQuant/core/io/shorthands.hpp>
 #include <SeQuant/core/optimize/common_subexpression_elimination.hpp>
+#include <SeQuant/core/optimize/factorize.hpp>
 #include <SeQuant/core/optimize/optimize.hpp>
 #include <SeQuant/core/optimize/single_term.hpp>
 #include <SeQuant/core/runtime.hpp>
@@ -411,6 +412,57 @@ TEST_CASE("optimize", "[optimize]") {
 
       REQUIRE(*seq == *par);
     }
+
+    SECTION("Sum factorization") {
+      auto const factorize_opts =
+          OptimizeOptions{.reorder = ReorderSum::NoReorder,
+                          .factorize = FactorizeSum::Factorize};
+
+      // A (B + C + D)
+      auto const sum3 = deserialize(
+          L"A_{a1}^{a2} B_{a2}^{i1} + A_{a1}^{a2} C_{a2}^{i1}"
+          L" + A_{a1}^{a2} D_{a2}^{i1}");
+      auto res = optimize(sum3, factorize_opts);
+      REQUIRE(res->is<Product>());
+      REQUIRE(res->as<Product>().factors().size() == 2);
+      REQUIRE(*res->at(0) == *deserialize(L"A_{a1}^{a2}"));
+      REQUIRE(res->at(1)->is<Sum>());
+      REQUIRE(res->at(1)->as<Sum>().size() == 3);
+      REQUIRE(opt::evaluation_flops(res) <
+              opt::evaluation_flops(optimize(sum3)));
+
+      // factorization recurses into the remainders: A (B (C + D) + E)
+      auto const nested = deserialize(
+          L"A_{a1}^{a2} B_{a2}^{a3} C_{a3}^{i1}"
+          L" + A_{a1}^{a2} B_{a2}^{a3} D_{a3}^{i1}"
+          L" + A_{a1}^{a2} E_{a2}^{i1}");
+      res = optimize(nested, factorize_opts);
+      REQUIRE(res->is<Product>());
+      REQUIRE(*res->at(0) == *deserialize(L"A_{a1}^{a2}"));
+      auto const inner = res->at(1);
+      REQUIRE(inner->is<Sum>());
+      REQUIRE(inner->as<Sum>().size() == 2);
+      REQUIRE(inner->at(0)->is<Product>());
+      REQUIRE(*inner->at(0)->at(0) == *deserialize(L"B_{a2}^{a3}"));
+      REQUIRE(inner->at(0)->at(1)->is<Sum>());
+      REQUIRE(inner->at(0)->at(1)->as<Sum>().size() == 2);
+      REQUIRE(*inner->at(1) == *deserialize(L"E_{a2}^{i1}"));
+
+      // without common factors the sum is only single-term optimized
+      auto const disjoint =
+          deserialize(L"A_{a1}^{a2} B_{a2}^{i1} + C_{a1}^{i2} D_{i2}^{i1}");
+      REQUIRE(*optimize(disjoint, factorize_opts) ==
+              *optimize(disjoint,
+                        OptimizeOptions{.reorder = ReorderSum::NoReorder}));
+
+      // factorization never increases the operation count
+      auto const sum = parse_expr_antisymm(
+          L"g_{i3,i4}^{a3,a4} t_{a1,a2}^{i3,i4} t_{a3,a4}^{i1,i2}"
+          L" + g_{i3,i4}^{a3,a4} t_{a3,a4}^{i1,i2} t_{a1}^{i3} t_{a2}^{i4}"
+          L" + g_{i3,i4}^{a3,a4} t_{a1}^{i3} t_{a2}^{i4} t_{a3,a4}^{i1,i2}");
+      REQUIRE(opt::evaluation_flops(optimize(sum, factorize_opts)) <=
+              opt::evaluation_flops(optimize(sum)));
+    }
   }
 
   SECTION("CSE") {
@@ -576,6 +628,45 @@ TEST_CASE("optimize", "[optimize]") {
         REQUIRE(collect_as_expr(expressions) == expected);
       }
     }
+    SECTION("cost model") {
+      auto reg = get_default_context().index_space_registry();
+
+      // The CSE g C takes 2 * 10 * 100 * 100 FLOPs and has 10 * 100 elements
+      opt::CSECostModel model;
+      model.extents = {{reg->retrieve(L"i"), 10}, {reg->retrieve(L"a"), 100}};
+
+      auto num_exprs_after_cse = [&](const opt::CSECostModel& cost_model) {
+        std::vector<EvalNode<EvalExpr>> expressions =
+            parse_inputs(std::vector<std::wstring>{
+                L"R1{i1;i2} = (g{i1;a1} C{a1;a2}) h{a2;i2}",
+                L"R2{i1;i2} = (g{i1;a1} C{a1;a2}) k{a2;i2}"});
+
+        opt::CSEOptions<EvalNode<EvalExpr>> opts;
+        opts.filter_predicate = cost_model;
+        opt::eliminate_common_subexpressions(expressions, binarizer, opts);
+
+        return expressions.size();
+      };
+
+      // Recomputing takes 2e-5 s, storing and reloading twice 1.6e-5 s
+      REQUIRE(num_exprs_after_cse(model) == 3);
+
+      auto slow_storage = model;
+      slow_storage.write_bandwidth = 1e8;
+      REQUIRE(num_exprs_after_cse(slow_storage) == 2);
+
+      auto fast_compute = model;
+      fast_compute.flops_per_second = 1e11;
+      REQUIRE(num_exprs_after_cse(fast_compute) == 2);
+
+      auto memory_limit = model;
+      memory_limit.max_elements = 100;
+      REQUIRE(num_exprs_after_cse(memory_limit) == 2);
+
+      auto min_usage = model;
+      min_usage.min_usage = 3;
+      REQUIRE(num_exprs_after_cse(min_usage) == 2);
+    }
   }
 
   SECTION("Single term optimization with CSE") {
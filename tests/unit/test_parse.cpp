@@ -8,8 +8,10 @@
 #include <SeQuant/core/context.hpp>
 #include <SeQuant/core/expr.hpp>
 #include <SeQuant/core/index.hpp>
+#include <SeQuant/core/io/serialization/binary.hpp>
 #include <SeQuant/core/io/shorthands.hpp>
 #include <SeQuant/core/rational.hpp>
+#include <SeQuant/core/utility/string.hpp>
 
 #include <SeQuant/domain/mbpt/convention.hpp>
 #include <SeQuant/domain/mbpt/spin.hpp>
@@ -586,4 +588,186 @@ TEST_CASE("serialization", "[serialization]") {
       }
     }
   }
+
+  SECTION("parallel deserialization") {
+    using namespace sequant;
+
+    const std::vector<std::wstring> expressions = {
+        L"t{a_1,a_2;a_3,a_4}:N-C-S",
+        L"a + b - 4 specialVariable",
+        L"-1/4 t{a_1,i_1<a_1>;a_2,i_2}:S-N-S - t{a_1;i_1}:A-N-S + 3 x -2 y",
+        L"1/2 (a + b) * c - (d - e)",
+        L"q1 * q2^* * q3 + (x)^(1/2) - 1/2 ã{i_1;i_2} * b̃{i_3;i_4}"};
+
+    for (const std::wstring& current : expressions) {
+      for (std::size_t chunk_size : {1, 8, 1024}) {
+        ExprPtr chunked =
+            deserialize<ExprPtr>(current, {.parallel_chunk_size = chunk_size});
+
+        REQUIRE(chunked == deserialize<ExprPtr>(current));
+      }
+    }
+
+    const std::wstring result_input =
+        L"R{i_1,i_2;e_1,e_2}:A-N-S = f{e_2;e_3}:A-N-S * "
+        L"t{e_1,e_3;i_1,i_2}:A-N-S - g{i_1,i_2;e_1,e_2}:A-N-S";
+    ResultExpr result =
+        deserialize<ResultExpr>(result_input, {.parallel_chunk_size = 1});
+    REQUIRE(serialize(result) ==
+            serialize(deserialize<ResultExpr>(result_input)));
+
+    SECTION("canonicalize terms") {
+      ExprPtr combined = deserialize<ExprPtr>(L"a + 2 b - a + c - 1/2 b",
+                                              {.parallel_chunk_size = 1,
+                                               .canonicalize_terms = true});
+      REQUIRE(combined == deserialize<ExprPtr>(L"3/2 b + c"));
+
+      ExprPtr zero =
+          deserialize<ExprPtr>(L"a - a", {.canonicalize_terms = true});
+      REQUIRE(zero->is_zero());
+    }
+
+    SECTION("errors") {
+      // offsets refer to the whole input
+      REQUIRE_THROWS_MATCHES(
+          deserialize<ExprPtr>(L"a + b + t{i1;az3}",
+                               {.parallel_chunk_size = 1}),
+          io::serialization::SerializationError,
+          serializationErrorMatches(13, 3, "Unknown index space"));
+    }
+  }
+
+  SECTION("text stream") {
+    using namespace sequant;
+    using namespace sequant::io::serialization;
+
+    ExprPtr sum = deserialize<ExprPtr>(
+        L"f{a_1;a_2} * t{a_2;i_1} - f{i_2;i_1} * t{a_1;i_2} + 1/2 (a + b)");
+    ResultExpr result = deserialize<ResultExpr>(
+        L"R{a_1;i_1}:A-N-S = f{a_1;i_1}:A-N-S - g{i_2,a_1;i_1,a_2}:A-N-S");
+
+    std::ostringstream os;
+    {
+      TextWriter writer(os);
+      writer.write(sum);
+      writer.write(result);
+      writer.begin_sum();
+      writer.write_term(sum->as<Sum>().summand(1));
+      writer.write_term(sum->as<Sum>().summand(0));
+      writer.end_sum();
+    }
+
+    std::istringstream is(std::move(os).str());
+    std::string line;
+    REQUIRE(std::getline(is, line));
+    REQUIRE(line == toUtf8(serialize(sum)));
+    REQUIRE(std::getline(is, line));
+    REQUIRE(line == toUtf8(serialize(result)));
+    REQUIRE(std::getline(is, line));
+    REQUIRE(deserialize<ExprPtr>(line) ==
+            ex<Sum>(ExprPtrList{sum->as<Sum>().summand(1),
+                                sum->as<Sum>().summand(0)}));
+    REQUIRE_FALSE(std::getline(is, line));
+  }
+
+  SECTION("binary") {
+    using namespace sequant;
+    using namespace sequant::io::serialization;
+
+    std::vector<std::wstring> expressions = {
+        L"t{a_1,a_2;a_3,a_4}:N-C-S",
+        L"42",
+        L"1/2",
+        L"-1/4 t{a_1,i_1<a_1>;a_2,i_2}:S-N-S",
+        L"a + b - 4 specialVariable",
+        L"variable + A{a_1;i_1}:N-N-S * B{i_1;a_1}:A-C-S",
+        L"1/2 (a + b) * c",
+        L"T1{}:N-N-N + T2{;;x_1}:N-N-N * T3{;;x_1}:N-N-N "
+        L"+ T4{a_1;;x_2}:S-C-S * T5{;a_1;x_2}:S-S-S",
+        L"q1 * q2^* * q3",
+        L"1/2 ã{i_1;i_2} * b̃{i_3;i_4}"};
+
+    for (const std::wstring& current : expressions) {
+      ExprPtr expression = deserialize<ExprPtr>(current);
+      ExprPtr restored =
+          binary::from_binary<ExprPtr>(binary::to_binary(expression));
+
+      REQUIRE(serialize(restored, {.annot_symm = true}) == current);
+    }
+
+    SECTION("result_expressions") {
+      std::vector<std::wstring> expressions = {
+          L"A = 5",
+          L"R{i_1,i_2;e_1,e_2}:A-N-S = f{e_2;e_3}:A-N-S * "
+          L"t{e_1,e_3;i_1,i_2}:A-N-S + "
+          L"g{i_1,i_2;e_1,e_2}:A-N-S",
+      };
+
+      for (const std::wstring& current : expressions) {
+        ResultExpr result = deserialize<ResultExpr>(current);
+        ResultExpr restored =
+            binary::from_binary<ResultExpr>(binary::to_binary(result));
+
+        REQUIRE(serialize(restored, {.annot_symm = true}) == current);
+      }
+    }
+
+    SECTION("large rationals") {
+      const rational value{
+          intmax_t("-123456789012345678901234567890123456789"),
+          intmax_t("98765432109876543210987654321")};
+      ExprPtr restored = binary::from_binary<ExprPtr>(
+          binary::to_binary(ex<Constant>(Constant::scalar_type{value, 1})));
+
+      REQUIRE(restored->is<Constant>());
+      REQUIRE(restored->as<Constant>().value() ==
+              Constant::scalar_type{value, 1});
+    }
+
+    SECTION("streaming") {
+      ExprPtr sum = deserialize<ExprPtr>(
+          L"f{a_1;a_2} * t{a_2;i_1} - f{i_2;i_1} * t{a_1;i_2} + f{a_1;i_1}");
+      ResultExpr result = deserialize<ResultExpr>(L"E = 1/4 g{i_1;a_1}");
+
+      std::ostringstream os;
+      {
+        binary::Writer writer(os);
+        writer.begin_sum();
+        for (const ExprPtr& term : sum->as<Sum>().summands())
+          writer.write_term(term);
+        writer.end_sum();
+        writer.write(result);
+      }
+      const std::string data = std::move(os).str();
+
+      binary::Reader reader(data);
+      REQUIRE(reader.version() == binary::format_version);
+      REQUIRE_FALSE(reader.begin_document().has_value());
+      std::size_t nterms = 0;
+      while (ExprPtr term = reader.next_term()) {
+        REQUIRE(term == sum->as<Sum>().summand(nterms));
+        ++nterms;
+      }
+      REQUIRE(nterms == sum->as<Sum>().size());
+      REQUIRE_FALSE(reader.at_end());
+
+      ResultExpr restored = reader.read_result();
+      REQUIRE(serialize(restored) == serialize(result));
+      REQUIRE(reader.at_end());
+    }
+
+    SECTION("invalid input") {
+      REQUIRE_THROWS_AS(binary::from_binary<ExprPtr>("not binary"),
+                        SerializationError);
+
+      const std::string data =
+          binary::to_binary(deserialize<ExprPtr>(L"t{a_1;i_1} * f{i_1;a_1}"));
+      REQUIRE_THROWS_AS(
+          binary::from_binary<ExprPtr>(
+              std::string_view(data).substr(0, data.size() - 1)),
+          SerializationError);
+      REQUIRE_THROWS_AS(binary::from_binary<ResultExpr>(data),
+                        SerializationError);
+    }
+  }
 }
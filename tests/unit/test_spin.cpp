@@ -1093,6 +1093,40 @@ SECTION("Closed-shell spintrace CCSDT terms") {
                      "t{a_1,a_2,a_3;i_1,i_3,i_4}:N-C-S "));
   }
 
+  SECTION("streaming") {
+    auto A3 = [] {
+      return ex<Tensor>(antisymm_label(), bra{L"i_1", L"i_2", L"i_3"},
+                        ket{L"a_1", L"a_2", L"a_3"}, Symmetry::Antisymm);
+    };
+    auto input =
+        ex<Constant>(3) * A3() *
+            ex<Tensor>(L"t", bra{L"a_1", L"a_2", L"a_3"},
+                       ket{L"i_2", L"i_3", L"i_4"}, Symmetry::Antisymm) *
+            ex<Tensor>(L"f", bra{L"i_4"}, ket{L"i_1"}) +
+        ex<Constant>(rational{3, 2}) * A3() *
+            ex<Tensor>(L"g", bra{L"a_1", L"a_2"}, ket{L"a_4", L"a_5"},
+                       Symmetry::Antisymm) *
+            ex<Tensor>(L"t", bra{L"a_3", L"a_4", L"a_5"},
+                       ket{L"i_1", L"i_2", L"i_3"}, Symmetry::Antisymm) +
+        ex<Constant>(rational{1, 2}) * A3() *
+            ex<Tensor>(L"t", bra{L"a_1", L"a_2", L"a_3"},
+                       ket{L"i_1", L"i_2", L"i_4"}, Symmetry::Antisymm) *
+            ex<Tensor>(L"f", bra{L"i_4"}, ket{L"i_3"});
+    const IdxGroupList ext_idxs = {
+        {L"i_1", L"a_1"}, {L"i_2", L"a_2"}, {L"i_3", L"a_3"}};
+
+    for (bool full_expansion : {false, true}) {
+      CAPTURE(full_expansion);
+      auto batch = closed_shell_spintrace(input->clone(), ext_idxs,
+                                          full_expansion, SpintraceMode::Batch);
+      auto streaming =
+          closed_shell_spintrace(input->clone(), ext_idxs, full_expansion,
+                                 SpintraceMode::Streaming);
+      simplify(batch);
+      REQUIRE_THAT(streaming, EquivalentTo(batch));
+    }
+  }
+
   SECTION(
       "the most expensive term in CCSDT: A3 * g * t3, spintracing with direct "
       "full-expansion") {
@@ -1513,6 +1547,17 @@ SECTION("Open-shell spin-tracing") {
     REQUIRE_THAT(result[1], EquivalentTo("-1/2 f{i↑2;i↑1} t{a↑1,a↓2;i↑2,i↓2}"));
     REQUIRE_THAT(result[2],
                  EquivalentTo("1/2 f{i↓3;i↓1} t{a↓1,a↓2;i↓2,i↓3}:A"));
+
+    // lazily produced spin blocks must match
+    OpenShellSpintraceGenerator generator(
+        input, IdxGroupList{{L"i_1", L"a_1"}, {L"i_2", L"a_2"}});
+    REQUIRE(generator.size() == 3);
+    for (std::size_t s = 0; s != generator.size(); ++s) {
+      auto block = generator.next();
+      REQUIRE(block.has_value());
+      REQUIRE_THAT(block.value(), EquivalentTo(result[s]));
+    }
+    REQUIRE_FALSE(generator.next().has_value());
   }
 
   // g * t1
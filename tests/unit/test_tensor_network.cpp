@@ -34,6 +34,8 @@
 #include <limits>
 #include <locale>
 #include <memory>
+#include <numeric>
+#include <optional>
 #include <random>
 #include <sstream>
 #include <stdexcept>
@@ -2071,6 +2073,116 @@ TEST_CASE("tensor_network_v3", "[elements][valgrind_skip]") {
       }
     }  // SECTION("idempotency")
 
+    SECTION("enumerated vs graph") {
+      // the exact canonical forms produced by direct enumeration differ from
+      // those produced via bliss, but both must partition the inputs into the
+      // same equivalence classes (including the phase)
+      const std::vector<std::wstring> inputs = {
+          L"g{i1,i2;a1,a2}:A t{a1,a2;i1,i2}:A",
+          L"t{a3,a4;i3,i4}:A g{i3,i4;a3,a4}:A",
+          L"g{i2,i1;a1,a2}:A t{a1,a2;i1,i2}:A",
+          L"g{i1,a2;a1,i2}:A t{a1,a2;i1,i2}:A",
+          L"f{i1;a1}:N t{a1,a2;i1,i2}:A",
+          L"t{a3,a2;i3,i2}:A f{i3;a3}:N",
+          L"t{a2,a3;i3,i2}:A f{i3;a3}:N",
+          L"g{i3,i4;a3,a4}:A t{a1,a3;i1,i2}:A t{a2,a4;i3,i4}:A",
+          L"t{a4,a2;i4,i3}:A g{i4,i3;a4,a5}:A t{a1,a5;i1,i2}:A",
+          L"g{i3,i4;a3,a4}:S t{a1,a3;i1,i3}:N t{a2,a4;i2,i4}:N",
+          L"t{a2,a4;i2,i4}:N t{a1,a3;i1,i3}:N g{i4,i3;a4,a3}:S",
+          L"Â{i1,i2;a1,a2}:A g{i3,i4;a3,a4}:A t{a1,a3;i1,i2}:A "
+          L"t{a2,a4;i3,i4}:A",
+          L"t{a2,a4;i3,i4}:A Â{i1,i2;a1,a2}:A t{a1,a3;i1,i2}:A "
+          L"g{i3,i4;a3,a4}:A",
+      };
+
+      auto canonicalize = [](const std::wstring& input,
+                             std::size_t enumeration_max_tensors) {
+        auto factors = deserialize(input).as<Product>().factors();
+        TN tn(factors);
+        auto byproduct = tn.canonicalize(
+            TensorCanonicalizer::cardinal_tensor_labels(),
+            {.method = CanonicalizationMethod::Complete,
+             .enumeration_max_tensors = enumeration_max_tensors});
+        std::wstring result = to_latex(to_product(tn.tensors()));
+        if (byproduct) result = to_latex(byproduct) + result;
+        return result;
+      };
+
+      std::vector<std::wstring> graph_results;
+      std::vector<std::wstring> enumerated_results;
+      for (const std::wstring& input : inputs) {
+        graph_results.push_back(canonicalize(input, 0));
+        enumerated_results.push_back(canonicalize(input, 4));
+      }
+
+      for (std::size_t i = 0; i < inputs.size(); ++i) {
+        for (std::size_t j = i + 1; j < inputs.size(); ++j) {
+          INFO(toUtf8(inputs[i]) << " vs " << toUtf8(inputs[j]));
+          REQUIRE((graph_results[i] == graph_results[j]) ==
+                  (enumerated_results[i] == enumerated_results[j]));
+        }
+      }
+      REQUIRE(enumerated_results[0] == enumerated_results[1]);
+      REQUIRE(enumerated_results[0] != enumerated_results[2]);
+      REQUIRE(enumerated_results[11] == enumerated_results[12]);
+
+      // equivalent networks (with reordered tensors, relabeled dummies, or
+      // permuted slots) must produce identical forms, whether they are
+      // canonicalized by enumeration or, if their search is deemed too
+      // expensive, via the graph
+      const std::vector<std::vector<std::wstring>> equivalent_inputs = {
+          {L"g{i1,i2;a1,a2}:A t{a1,a2;i1,i2}:A",
+           L"t{a3,a4;i3,i4}:A g{i3,i4;a3,a4}:A",
+           L"t{a4,a3;i4,i3}:A g{i3,i4;a3,a4}:A"},
+          {L"t{a3,a2;i3,i2}:A f{i3;a3}:N", L"f{i1;a1}:N t{a2,a1;i2,i1}:A"},
+          // named indices in interchangeable slots
+          {L"g{i1,i2;a3,a4}:A t{a3,a4;i3,i4}:A",
+           L"t{a5,a6;i3,i4}:A g{i2,i1;a6,a5}:A"},
+          {L"g{i3,i4;a3,a4}:S t{a1,a3;i1,i3}:N t{a2,a4;i2,i4}:N",
+           L"t{a2,a5;i2,i6}:N g{i6,i5;a5,a6}:S t{a1,a6;i1,i5}:N"},
+          {L"Â{i1,i2;a1,a2}:A g{i3,i4;a3,a4}:A t{a1,a3;i1,i2}:A "
+           L"t{a2,a4;i3,i4}:A",
+           L"t{a2,a4;i3,i4}:A Â{i1,i2;a1,a2}:A t{a1,a3;i1,i2}:A "
+           L"g{i3,i4;a3,a4}:A"},
+          // ties longer than the tabulated permutations
+          {L"g{i1,i2,i3,i4,i5,i6,i7;a1,a2,a3,a4,a5,a6,a7}:A "
+           L"t{a1,a2,a3,a4,a5,a6,a7;i1,i2,i3,i4,i5,i6,i7}:A",
+           L"t{a7,a6,a5,a4,a3,a2,a1;i7,i6,i5,i4,i3,i2,i1}:A "
+           L"g{i1,i2,i3,i4,i5,i6,i7;a1,a2,a3,a4,a5,a6,a7}:A"},
+          // exceeds the search budget
+          {L"g{i1,i2,i3;a1,a2,a3}:A t{a1,a2,a3;i4,i5,i6}:A "
+           L"t{a4,a5,a6;i1,i2,i3}:A s{i4,i5,i6;a4,a5,a6}:A",
+           L"s{i1,i2,i3;a1,a2,a3}:A t{a4,a5,a6;i1,i2,i3}:A "
+           L"t{a1,a2,a3;i7,i8,i9}:A g{i7,i8,i9;a4,a5,a6}:A"},
+      };
+
+      for (const auto& inputs : equivalent_inputs) {
+        std::optional<std::wstring> reference;
+        for (const std::wstring& input : inputs) {
+          const auto nfactors =
+              deserialize(input).as<Product>().factors().size();
+          std::vector<std::size_t> order(nfactors);
+          std::iota(order.begin(), order.end(), 0);
+          do {
+            auto factors = deserialize(input).as<Product>().factors();
+            auto reordered = factors;
+            for (std::size_t k = 0; k != nfactors; ++k)
+              reordered[k] = factors[order[k]];
+            TN tn(reordered);
+            auto byproduct = tn.canonicalize(
+                TensorCanonicalizer::cardinal_tensor_labels(),
+                {.method = CanonicalizationMethod::Complete,
+                 .enumeration_max_tensors = 4});
+            std::wstring result = to_latex(to_product(tn.tensors()));
+            if (byproduct) result = to_latex(byproduct) + result;
+            if (!reference) reference = result;
+            INFO(toUtf8(input));
+            REQUIRE(result == *reference);
+          } while (std::next_permutation(order.begin(), order.end()));
+        }
+      }
+    }  // SECTION("enumerated vs graph")
+
   }  // SECTION("canonicalizer")
 
   SECTION("misc1") {
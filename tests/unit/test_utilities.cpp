@@ -8,6 +8,7 @@
 #include <SeQuant/core/index.hpp>
 #include <SeQuant/core/io/shorthands.hpp>
 #include <SeQuant/core/reserved.hpp>
+#include <SeQuant/core/runtime.hpp>
 #include <SeQuant/core/slotted_index.hpp>
 #include <SeQuant/core/utility/conversion.hpp>
 #include <SeQuant/core/utility/exception.hpp>
@@ -15,12 +16,15 @@
 #include <SeQuant/core/utility/indices.hpp>
 #include <SeQuant/core/utility/macros.hpp>
 #include <SeQuant/core/utility/singleton.hpp>
+#include <SeQuant/core/utility/snapshot.hpp>
 #include <SeQuant/core/utility/strong.hpp>
 #include <SeQuant/core/utility/tensor.hpp>
 
 #include <range/v3/view/transform.hpp>
 
+#include <atomic>
 #include <limits>
+#include <memory>
 #include <ranges>
 #include <string>
 #include <string_view>
@@ -248,6 +252,76 @@ TEST_CASE("utilities", "[utilities]") {
     }
   }
 
+  SECTION("SnapshotCell") {
+    using sequant::detail::SnapshotCell;
+
+    SnapshotCell<container::map<int, int>> cell;
+    REQUIRE(cell.get().empty());
+    const auto v0 = cell.version();
+
+    // references to snapshots are not affected by writers
+    auto snapshot0 = cell.snapshot();
+    cell.update([](auto& map) { map.emplace(0, 0); });
+    CHECK(snapshot0->empty());
+    CHECK(cell.get().size() == 1);
+    CHECK(cell.version() != v0);
+
+    CHECK(cell.update([](auto& map) { return map.emplace(0, 1).second; }) ==
+          false);
+    CHECK(cell.get().at(0) == 0);
+
+    // superseded snapshots are reclaimed once no reader holds them
+    std::weak_ptr<const container::map<int, int>> snapshot1 = cell.snapshot();
+    cell.update([](auto& map) { map.emplace(-1, -1); });
+    CHECK(!snapshot1.expired());  // still cached by this thread
+    CHECK(cell.get().size() == 2);
+    CHECK(snapshot1.expired());
+
+    // concurrent readers observe monotonically growing snapshots
+    constexpr auto nthreads = 5;
+    constexpr auto nwrites = 100;
+    std::atomic<bool> done = false;
+    std::vector<std::thread> readers;
+    std::vector<int> reader_results(nthreads, 0);
+    for (int t = 0; t != nthreads; ++t) {
+      readers.emplace_back([&cell, &done, &result = reader_results[t]]() {
+        std::size_t last_size = 0;
+        while (!done) {
+          const auto size = cell.snapshot()->size();
+          if (size < last_size) result = 1;
+          last_size = size;
+        }
+      });
+    }
+    for (int i = 1; i <= nwrites; ++i)
+      cell.update([i](auto& map) { map.emplace(i, i); });
+    done = true;
+    for (auto&& thr : readers) thr.join();
+    for (auto result : reader_results) CHECK(result == 0);
+    CHECK(cell.get().size() == nwrites + 1);
+  }
+
+  SECTION("ThreadBudget") {
+    const auto nthreads = sequant::num_threads();
+    {
+      sequant::ThreadBudget budget(2);
+      CHECK(sequant::num_threads() == 2);
+      {
+        sequant::ThreadBudget nested_budget(0);
+        CHECK(sequant::num_threads() == 1);
+      }
+      CHECK(sequant::num_threads() == 2);
+
+      // the budget is thread-local
+      int other_thread_nthreads = 0;
+      std::thread([&other_thread_nthreads]() {
+        other_thread_nthreads = sequant::num_threads();
+      }).join();
+      CHECK(other_thread_nthreads == nthreads);
+    }
+    CHECK(sequant::num_threads() == nthreads);
+  }
+
   SECTION("StrongType") {
     using namespace sequant::detail;
 
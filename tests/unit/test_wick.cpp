@@ -961,6 +961,88 @@ TEST_CASE("wick", "[algorithms][wick][valgrind_skip]") {
 #endif
   }  // SECTION("fermi vacuum")
 
+  SECTION("estimate") {
+    auto count = [](FWickTheorem& wick) {
+      return static_cast<std::size_t>(
+          wick.compute(true)->as<Constant>().value<int>());
+    };
+
+    // 4-body ^ 2-body ^ 2-body
+    {
+      auto opseq = ex<FNOperatorSeq>(
+          FNOperator(cre({L"p_1", L"p_2", L"p_3", L"p_4"}),
+                     ann({L"p_5", L"p_6", L"p_7", L"p_8"})),
+          FNOperator(cre({L"p_9", L"p_10"}), ann({L"p_11", L"p_12"})),
+          FNOperator(cre({L"p_13", L"p_14"}), ann({L"p_15", L"p_16"})));
+      auto wick = FWickTheorem{opseq};
+      const auto estimate = wick.estimate();
+      REQUIRE(estimate.ncontractions == 576);
+      REQUIRE(estimate.nterms > 0);
+      REQUIRE(estimate.nterms <= estimate.ncontractions);
+      REQUIRE(estimate.ncontractions == count(wick));
+    }
+
+    // 4 general 1-body operators, with and without target connections
+    {
+      auto opseq = ex<FNOperatorSeq>(FNOperator(cre({L"p_1"}), ann({L"p_2"})),
+                                     FNOperator(cre({L"p_3"}), ann({L"p_4"})),
+                                     FNOperator(cre({L"p_5"}), ann({L"p_6"})),
+                                     FNOperator(cre({L"p_7"}), ann({L"p_8"})));
+      auto wick1 = FWickTheorem{opseq};
+      REQUIRE(wick1.estimate().ncontractions == 9);
+      auto wick2 = FWickTheorem{opseq};
+      wick2.set_nop_connections({{1, 2}, {1, 3}});
+      REQUIRE(wick2.estimate().ncontractions == 2);
+      REQUIRE(wick2.estimate().ncontractions == count(wick2));
+    }
+
+    // partial contractions include the contraction-free term
+    {
+      auto opseq = ex<FNOperatorSeq>(
+          FNOperator(cre({L"p_1", L"p_2"}), ann({L"p_3", L"p_4"})),
+          FNOperator(cre({L"p_5", L"p_6"}), ann({L"p_7", L"p_8"})));
+      auto wick = FWickTheorem{opseq};
+      wick.full_contractions(false);
+      REQUIRE(wick.estimate().ncontractions == count(wick));
+    }
+
+    // pure qp operators that cannot be fully contracted
+    {
+      auto opseq = ex<FNOperatorSeq>(FNOperator(cre({L"i_1"}), ann({L"a_1"})),
+                                     FNOperator(cre({L"i_2"}), ann({L"a_2"})));
+      auto wick = FWickTheorem{opseq};
+      REQUIRE(wick.estimate().ncontractions == 0);
+      REQUIRE(wick.estimate().nterms == 0);
+    }
+  }  // SECTION("estimate")
+
+  SECTION("pruning") {
+    // more qp annihilators than qp creators: pruned before any contraction
+    {
+      auto opseq = ex<FNOperatorSeq>(FNOperator(cre({L"i_1"}), ann({L"a_1"})),
+                                     FNOperator(cre({L"i_2"}), ann({L"a_2"})),
+                                     FNOperator(cre({L"a_3"}), ann({L"i_3"})));
+      auto wick = FWickTheorem{opseq};
+      auto result = wick.compute();
+      REQUIRE(result->is<Constant>());
+      REQUIRE(result->as<Constant>().value<int>() == 0);
+      REQUIRE(wick.stats().num_attempted_contractions == 0);
+      REQUIRE(wick.stats().num_pruned_contractions == 1);
+    }
+
+    // contracting i_1 with i_4 leaves i_2 and i_3 without partners
+    {
+      auto opseq = ex<FNOperatorSeq>(FNOperator(cre({L"i_1"}), ann({L"a_1"})),
+                                     FNOperator(cre({L"a_2"}), ann({L"i_2"})),
+                                     FNOperator(cre({L"i_3"}), ann({L"a_3"})),
+                                     FNOperator(cre({L"a_4"}), ann({L"i_4"})));
+      auto wick = FWickTheorem{opseq};
+      auto result = wick.compute(true);
+      REQUIRE(result->as<Constant>().value<int>() == 1);
+      REQUIRE(wick.stats().num_pruned_contractions > 0);
+    }
+  }  // SECTION("pruning")
+
   SECTION("Expression Reduction") {
     constexpr Vacuum V = Vacuum::SingleProduct;
     // default vacuum is already spin-orbital Fermi vacuum
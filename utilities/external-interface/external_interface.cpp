@@ -12,6 +12,7 @@
 #include <SeQuant/core/expr.hpp>
 #include <SeQuant/core/io/shorthands.hpp>
 #include <SeQuant/core/optimize/common_subexpression_elimination.hpp>
+#include <SeQuant/core/optimize/cse_cost_model.hpp>
 #include <SeQuant/core/runtime.hpp>
 #include <SeQuant/core/tensor_canonicalizer.hpp>
 #include <SeQuant/core/utility/exception.hpp>
@@ -32,15 +33,18 @@
 #include <boost/algorithm/string.hpp>
 
 #include <algorithm>
+#include <exception>
 #include <filesystem>
 #include <fstream>
 #include <iterator>
 #include <limits>
+#include <memory>
 #include <ranges>
 #include <string>
 #include <string_view>
 #include <unordered_set>
 #include <variant>
+#include <vector>
 
 using nlohmann::json;
 using namespace sequant;
@@ -126,6 +130,10 @@ ProcessingOptions extractProcessingOptions(
         details.at("min_cse_usage_count").get<std::size_t>();
   }
 
+  if (details.contains("cse_cost_model")) {
+    options.cse_cost_model = details.at("cse_cost_model").get<bool>();
+  }
+
   if (details.contains("index_batching")) {
     const nlohmann::json &batch = details.at("index_batching");
     auto handle_strategy = [&options](std::string_view strategy) {
@@ -277,9 +285,111 @@ std::vector<ResultExpr> splitContributions(const ResultExpr &result) {
   return contributions;
 }
 
+ProcessedResult processResult(const json &current_result,
+                              const ProcessingOptions &options) {
+  const std::string result_name = current_result.at("name");
+  const std::string input_file = current_result.at("equation_file");
+
+  spdlog::debug("Processing equations from '{}' to result '{}'", input_file,
+                result_name);
+
+  if (!std::filesystem::exists(input_file)) {
+    throw Exception("Specified input file '" + input_file +
+                    "' does not exist");
+  }
+
+  // Read input file
+  std::ifstream in(input_file);
+  const std::string input(std::istreambuf_iterator<char>(in), {});
+
+  // equation files may hold very large sums, deserialize them in chunks
+  sequant::ResultExpr result = sequant::deserialize<sequant::ResultExpr>(
+      input, {.def_perm_symm = Symmetry::Antisymm,
+              .parallel_chunk_size = std::size_t{1} << 16});
+
+  if (current_result.contains("name")) {
+    result.set_label(toUtf16(current_result.at("name").get<std::string>()));
+  }
+
+  if (current_result.contains("replace")) {
+    for (const nlohmann::json &sub : current_result.at("replace")) {
+      ExprPtr target =
+          deserialize<ExprPtr>(sub.at("target").get<std::string>(),
+                               {.def_perm_symm = Symmetry::Antisymm});
+      ExprPtr replacement =
+          deserialize<ExprPtr>(sub.at("replacement").get<std::string>(),
+                               {.def_perm_symm = Symmetry::Antisymm});
+
+      std::string equality_method = sub.value("tensor_equality", "identity");
+
+      spdlog::debug("Replacing {} -> {} (tensor equality: '{}')", target,
+                    replacement, equality_method);
+
+      if (equality_method == "identity") {
+        replace(result, target, replacement);
+      } else if (equality_method == "block") {
+        replace<TensorBlockEqualComparator>(result, target, replacement);
+      } else {
+        throw Exception("Unknown tensor_equality choice '" + equality_method +
+                        "'");
+      }
+    }
+  }
+
+  // SeQuant processing often assumes fully expanded/simplified
+  // expressions so at least for now, we start out with exactly that
+  rapid_simplify(result);
+
+  spdlog::debug("Initial (mildly simplified) equation is:\n{}", result);
+
+  if (std::string msg; !is_valid(result, &msg)) {
+    throw Exception("Input equation is invalid: " + msg);
+  }
+
+  std::vector<ResultExpr> resultParts =
+      options.term_by_term ? splitContributions(result)
+                           : std::vector<ResultExpr>{result};
+
+  ProcessedResult processed;
+  processed.contributions.reserve(resultParts.size());
+
+  for (const ResultExpr &contribution : resultParts) {
+    if (resultParts.size() > 1) {
+      spdlog::debug("Current contribution:\n{}", contribution);
+    }
+
+    ProcessedResult::Contribution &current_contribution =
+        processed.contributions.emplace_back();
+    current_contribution.produces_tensor = contribution.produces_tensor();
+
+    for (ResultExpr &current : postProcess(contribution, options)) {
+      spdlog::debug("Fully processed equation is:\n{}", current);
+
+      if (*current.expression() == Constant(0)) {
+        continue;
+      }
+
+      current_contribution.results.push_back(std::move(current));
+    }
+  }
+
+  return processed;
+}
+
+/// A single result of a code block whose equations are processed
+/// independently of all other results
+struct ResultJob {
+  const json *spec = nullptr;
+  ProcessingOptions options;
+  std::string cache_key;
+  std::shared_ptr<const ProcessedResult> processed;
+  std::exception_ptr error;
+};
+
 void generateITF(const json &blocks, std::string_view out_file,
                  const ProcessingOptions &defaults,
-                 const IndexSpaceMeta &spaceMeta) {
+                 const IndexSpaceMeta &spaceMeta, ResultCache &cache,
+                 std::string_view cacheScope) {
   ItfExportContext context(spaceMeta);
   // We assume index IDs start at 1
   context.set_index_id_offset(1);
@@ -287,105 +397,89 @@ void generateITF(const json &blocks, std::string_view out_file,
   ItfGenerator<ItfExportContext> itfgen;
   GenerationOptimizer<ItfGenerator<ItfExportContext>> generator(itfgen);
 
-  container::svector<ExpressionGroup<>> groups;
-  groups.reserve(blocks.size());
+  // Processing the equations of the individual results is independent of
+  // everything else and hence happens concurrently (across all blocks).
+  // Everything touching the export context is done afterwards in the order
+  // given in the driver so that the generated code is deterministic.
+  std::vector<ProcessingOptions> allBlockOptions;
+  allBlockOptions.reserve(blocks.size());
+  std::vector<std::vector<ResultJob>> blockJobs;
+  blockJobs.reserve(blocks.size());
+  std::vector<ResultJob *> pendingJobs;
 
   for (const json &current_block : blocks) {
-    const std::string block_name = current_block.at("name");
-
-    const ProcessingOptions block_options =
-        extractProcessingOptions(current_block, defaults);
-
-    spdlog::debug("Processing ITF code block '{}'", block_name);
-
-    container::svector<ExportNode<>> results;
-
-    std::set<std::variant<Tensor, Variable>> createdResults;
+    const ProcessingOptions &block_options = allBlockOptions.emplace_back(
+        extractProcessingOptions(current_block, defaults));
 
+    std::vector<ResultJob> &jobs = blockJobs.emplace_back();
     for (const json &current_result : current_block.at("results")) {
-      const std::string result_name = current_result.at("name");
-      const std::string input_file = current_result.at("equation_file");
+      ResultJob &job = jobs.emplace_back();
+      job.spec = &current_result;
+      job.options = extractProcessingOptions(current_result, block_options);
+    }
 
-      spdlog::debug("Processing equations from '{}' to result '{}'", input_file,
-                    result_name);
+    for (ResultJob &job : jobs) {
+      const std::string input_file = job.spec->at("equation_file");
+      job.cache_key = std::string(cacheScope) + "\n" +
+                      std::filesystem::absolute(input_file).string() + "\n" +
+                      job.spec->dump() + "\n" + postProcessingKey(job.options);
 
-      if (!std::filesystem::exists(input_file)) {
-        throw Exception("Specified input file '" + input_file +
-                        "' does not exist");
+      job.processed = cache.find(job.cache_key);
+      if (job.processed) {
+        spdlog::debug("Reusing processed equations for result '{}'",
+                      job.spec->at("name").get<std::string>());
+      } else {
+        pendingJobs.push_back(&job);
       }
+    }
+  }
 
-      // Read input file
-      std::ifstream in(input_file);
-      const std::string input(std::istreambuf_iterator<char>(in), {});
+  sequant::for_each(pendingJobs, [&cache](ResultJob *job) {
+    try {
+      job->processed = std::make_shared<const ProcessedResult>(
+          processResult(*job->spec, job->options));
+      cache.insert(job->cache_key, job->processed);
+    } catch (...) {
+      job->error = std::current_exception();
+    }
+  });
 
-      sequant::ResultExpr result = sequant::deserialize<sequant::ResultExpr>(
-          input, {.def_perm_symm = Symmetry::Antisymm});
+  container::svector<ExpressionGroup<>> groups;
+  groups.reserve(blocks.size());
 
-      if (current_result.contains("name")) {
-        result.set_label(toUtf16(current_result.at("name").get<std::string>()));
-      }
+  for (std::size_t block_idx = 0; block_idx < blocks.size(); ++block_idx) {
+    const json &current_block = blocks.at(block_idx);
+    const std::string block_name = current_block.at("name");
 
-      if (current_result.contains("replace")) {
-        for (const nlohmann::json &sub : current_result.at("replace")) {
-          ExprPtr target =
-              deserialize<ExprPtr>(sub.at("target").get<std::string>(),
-                                   {.def_perm_symm = Symmetry::Antisymm});
-          ExprPtr replacement =
-              deserialize<ExprPtr>(sub.at("replacement").get<std::string>(),
-                                   {.def_perm_symm = Symmetry::Antisymm});
-
-          std::string equality_method =
-              sub.value("tensor_equality", "identity");
-
-          spdlog::debug("Replacing {} -> {} (tensor equality: '{}')", target,
-                        replacement, equality_method);
-
-          if (equality_method == "identity") {
-            replace(result, target, replacement);
-          } else if (equality_method == "block") {
-            replace<TensorBlockEqualComparator>(result, target, replacement);
-          } else {
-            throw Exception("Unknown tensor_equality choice '" +
-                            equality_method + "'");
-          }
-        }
-      }
+    const ProcessingOptions &block_options = allBlockOptions.at(block_idx);
+
+    spdlog::debug("Processing ITF code block '{}'", block_name);
 
-      // SeQuant processing often assumes fully expanded/simplified
-      // expressions so at least for now, we start out with exactly that
-      rapid_simplify(result);
+    container::svector<ExportNode<>> results;
 
-      spdlog::debug("Initial (mildly simplified) equation is:\n{}", result);
+    std::set<std::variant<Tensor, Variable>> createdResults;
 
-      if (std::string msg; !is_valid(result, &msg)) {
-        throw Exception("Input equation is invalid: " + msg);
+    for (const ResultJob &job : blockJobs.at(block_idx)) {
+      if (job.error) {
+        std::rethrow_exception(job.error);
       }
 
-      const ProcessingOptions result_options =
-          extractProcessingOptions(current_result, block_options);
-
-      std::vector<ResultExpr> resultParts =
-          result_options.term_by_term ? splitContributions(result)
-                                      : std::vector<ResultExpr>{result};
+      const json &current_result = *job.spec;
+      const ProcessingOptions &result_options = job.options;
 
       std::unordered_set<Tensor> tensorsToSymmetrize;
 
-      for (const ResultExpr &contribution : resultParts) {
-        if (resultParts.size() > 1) {
-          spdlog::debug("Current contribution:\n{}", contribution);
-        }
-
-        for (ResultExpr &current : postProcess(contribution, result_options)) {
-          spdlog::debug("Fully processed equation is:\n{}", current);
-
-          if (*current.expression() == Constant(0)) {
-            continue;
-          }
+      for (const ProcessedResult::Contribution &contribution :
+           job.processed->contributions) {
+        for (ResultExpr current : contribution.results) {
+          // The processed equations may be shared via the cache, so the
+          // expression must not be modified in-place
+          current.expression() = current.expression()->clone();
 
           const bool createResult = [&]() {
             // We only want to create a given result once to not overwrite
             // previous contributions
-            if (contribution.produces_tensor()) {
+            if (contribution.produces_tensor) {
               if (createdResults.find(current.result_as_tensor()) ==
                   createdResults.end()) {
                 createdResults.insert(current.result_as_tensor());
@@ -454,10 +548,13 @@ void generateITF(const json &blocks, std::string_view out_file,
 
     if (block_options.subexpression_elimination) {
       const std::size_t min_usage = block_options.min_cse_usage;
+      const bool use_cost_model = block_options.cse_cost_model;
+      const opt::CSECostModel cost_model{.min_usage = min_usage};
 
       opt::CSEOptions<ExportNode<>> opts;
-      opts.filter_predicate = [min_usage](const ExportNode<> &tree,
-                                          std::size_t usage_count) {
+      opts.filter_predicate = [min_usage, use_cost_model, cost_model](
+                                  const ExportNode<> &tree,
+                                  std::size_t usage_count) {
         if (usage_count < min_usage) {
           return false;
         }
@@ -478,6 +575,10 @@ void generateITF(const json &blocks, std::string_view out_file,
           return false;
         }
 
+        if (use_cost_model) {
+          return cost_model(tree, usage_count);
+        }
+
         return true;
       };
 
@@ -587,7 +688,8 @@ void generateITF(const json &blocks, std::string_view out_file,
   output << itfCode;
 }
 
-void generateCode(const json &details, const IndexSpaceMeta &spaceMeta) {
+void generateCode(const json &details, const IndexSpaceMeta &spaceMeta,
+                  ResultCache &cache, std::string_view cacheScope) {
   const std::string format = details.at("output_format");
   const std::string out_path = details.at("output_path");
 
@@ -597,7 +699,8 @@ void generateCode(const json &details, const IndexSpaceMeta &spaceMeta) {
   }
 
   if (boost::iequals(format, "itf")) {
-    generateITF(details.at("code_blocks"), out_path, defaultOptions, spaceMeta);
+    generateITF(details.at("code_blocks"), out_path, defaultOptions, spaceMeta,
+                cache, cacheScope);
   } else {
     throw Exception("Unknown code generation target format '" +
                     std::string(format) + "'");
@@ -644,7 +747,8 @@ void registerIndexSpaces(const json &spaces, IndexSpaceMeta &meta) {
   }
 }
 
-void process(const json &driver, IndexSpaceMeta &spaceMeta) {
+void process(const json &driver, IndexSpaceMeta &spaceMeta,
+             ResultCache &cache) {
   if (!driver.contains("index_spaces")) {
     throw Exception("Missing index_spaces definition");
   }
@@ -654,7 +758,9 @@ void process(const json &driver, IndexSpaceMeta &spaceMeta) {
   if (driver.contains("code_generation")) {
     const json &details = driver.at("code_generation");
 
-    generateCode(details, spaceMeta);
+    // Processed equations can only be shared between drivers that agree on
+    // the definition of the index spaces
+    generateCode(details, spaceMeta, cache, driver.at("index_spaces").dump());
   }
 }
 
@@ -663,8 +769,7 @@ void generalSetup() {
       mbpt::cardinal_tensor_labels());
 }
 
-int main(int argc, char **argv) {
-  set_locale();
+Context makeContext() {
   Context ctx({.index_space_registry = IndexSpaceRegistry(),
                .vacuum = Vacuum::SingleProduct});
   // TODO: This only hides a bug/issue in the processing code where SeQuant
@@ -673,30 +778,22 @@ int main(int argc, char **argv) {
   // indices are tracked externally (e.g. ResultExpr) as those won't get updated
   // to use the new names.
   ctx.set(CanonicalizeOptions{.method = CanonicalizationMethod::Complete});
-  set_default_context(ctx);
-  generalSetup();
-
-  CLI::App app(
-      "Interface for reading in equations generated outside of SeQuant");
-  argv = app.ensure_utf8(argv);
-
-  std::filesystem::path driver;
-  app.add_option("--driver", driver,
-                 "Path to the JSON file used to drive the processing")
-      ->required();
-  bool verbose = false;
-  app.add_flag("--verbose", verbose, "Whether to enable verbose output");
 
-  CLI11_PARSE(app, argc, argv);
+  return ctx;
+}
 
+bool processDriver(std::filesystem::path driver, ResultCache &cache) {
   if (!std::filesystem::exists(driver)) {
-    throw Exception("Specified driver file '" + driver.string() +
-                    "' does not exist");
+    spdlog::error("Specified driver file '{}' does not exist", driver.string());
+    return false;
   } else if (!std::filesystem::is_regular_file(driver)) {
-    throw Exception("Specified driver file '" + driver.string() +
-                    "' is not a file");
+    spdlog::error("Specified driver file '{}' is not a file", driver.string());
+    return false;
   }
 
+  // Every driver defines its own index spaces
+  set_default_context(makeContext());
+
   // Change directory to where the driver file is located so that all relative
   // paths specified in it resolve to be relative to the driver file.
   // Before that, we have to get the absolute driver path though (or else the
@@ -704,10 +801,6 @@ int main(int argc, char **argv) {
   driver = std::filesystem::absolute(driver);
   std::filesystem::current_path(driver.parent_path());
 
-  if (verbose) {
-    spdlog::set_level(spdlog::level::debug);
-  }
-
   IndexSpaceMeta spaceMeta;
 
   try {
@@ -717,11 +810,50 @@ int main(int argc, char **argv) {
         json::parse(in, /*callback*/ nullptr, /*allow_exceptions*/ true,
                     /*skip_comments*/ true);
 
-    process(driver_info, spaceMeta);
+    process(driver_info, spaceMeta, cache);
   } catch (const std::exception &e) {
-    spdlog::error("Unexpected error: {}", e.what());
-    return 1;
+    spdlog::error("Unexpected error while processing '{}': {}",
+                  driver.string(), e.what());
+    return false;
+  }
+
+  return true;
+}
+
+int main(int argc, char **argv) {
+  set_locale();
+  generalSetup();
+
+  CLI::App app(
+      "Interface for reading in equations generated outside of SeQuant");
+  argv = app.ensure_utf8(argv);
+
+  std::vector<std::filesystem::path> drivers;
+  app.add_option("--driver", drivers,
+                 "Path to the JSON file(s) used to drive the processing. "
+                 "Multiple drivers are processed one after another, sharing "
+                 "equations that are processed identically.")
+      ->required();
+  bool verbose = false;
+  app.add_flag("--verbose", verbose, "Whether to enable verbose output");
+
+  CLI11_PARSE(app, argc, argv);
+
+  if (verbose) {
+    spdlog::set_level(spdlog::level::debug);
+  }
+
+  const std::filesystem::path initial_dir = std::filesystem::current_path();
+
+  ResultCache cache;
+  bool success = true;
+
+  for (const std::filesystem::path &driver : drivers) {
+    // Relative driver paths are relative to where we have been invoked
+    std::filesystem::current_path(initial_dir);
+
+    success = processDriver(driver, cache) && success;
   }
 
-  return 0;
+  return success ? 0 : 1;
 }
@@ -16,6 +16,8 @@
 
 #include <spdlog/spdlog.h>
 
+#include <string>
+
 using namespace sequant;
 
 container::svector<ResultExpr> postProcess(ResultExpr result,
@@ -131,3 +133,34 @@ container::svector<ResultExpr> postProcess(ResultExpr result,
 
   return processed;
 }
+
+std::string postProcessingKey(const ProcessingOptions &options) {
+  std::string key;
+  key += options.density_fitting ? '1' : '0';
+  key += std::to_string(static_cast<int>(options.spintrace));
+  key += std::to_string(static_cast<int>(options.transform));
+  key += options.factorize_to_binary ? '1' : '0';
+  key += options.expand_symmetrizer ? '1' : '0';
+  key += options.term_by_term ? '1' : '0';
+
+  return key;
+}
+
+std::shared_ptr<const ProcessedResult> ResultCache::find(
+    const std::string &key) const {
+  std::scoped_lock lock(m_mutex);
+
+  auto it = m_results.find(key);
+  if (it == m_results.end()) {
+    return nullptr;
+  }
+
+  return it->second;
+}
+
+void ResultCache::insert(std::string key,
+                         std::shared_ptr<const ProcessedResult> result) {
+  std::scoped_lock lock(m_mutex);
+
+  m_results.insert_or_assign(std::move(key), std::move(result));
+}
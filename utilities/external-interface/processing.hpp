@@ -7,7 +7,12 @@
 #include <SeQuant/core/expr.hpp>
 #include <SeQuant/core/index.hpp>
 
+#include <exception>
 #include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 
 enum class SpinTracing {
   None,
@@ -37,6 +42,7 @@ struct ProcessingOptions {
   bool term_by_term = false;
   bool subexpression_elimination = true;
   std::size_t min_cse_usage = 2;
+  bool cse_cost_model = false;
   std::variant<IndexBatching, std::vector<sequant::Index>> batching =
       IndexBatching::Slowest;
   std::size_t min_unbatched_indices = 2;
@@ -46,4 +52,35 @@ struct ProcessingOptions {
 sequant::container::svector<sequant::ResultExpr> postProcess(
     sequant::ResultExpr expression, const ProcessingOptions &options = {});
 
+/// @returns A string that is identical for two sets of options iff they lead
+/// to the same processed equations (CSE and batching options don't matter)
+std::string postProcessingKey(const ProcessingOptions &options);
+
+/// The outcome of post-processing a single input equation
+struct ProcessedResult {
+  struct Contribution {
+    bool produces_tensor = false;
+    sequant::container::svector<sequant::ResultExpr> results;
+  };
+
+  std::vector<Contribution> contributions;
+};
+
+/// Thread-safe cache of processed equations that is shared between all
+/// drivers handled by a single invocation.
+/// Note that cached expressions must not be modified in-place.
+class ResultCache {
+ public:
+  ResultCache() = default;
+
+  std::shared_ptr<const ProcessedResult> find(const std::string &key) const;
+
+  void insert(std::string key, std::shared_ptr<const ProcessedResult> result);
+
+ private:
+  mutable std::mutex m_mutex;
+  std::unordered_map<std::string, std::shared_ptr<const ProcessedResult>>
+      m_results;
+};
+
 #endif